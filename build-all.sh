@@ -71,6 +71,17 @@ wuffs genlib -skipgen
 wuffs test   -skipgen -mimic
 wuffs bench  -skipgen -mimic -reps=1 -iterscale=1
 
+# The wuffs_aux tests are C++, not C, so "wuffs test" doesn't run them.
+mkdir -p gen/bin
+for f in test/c/auxiliary/*.cc; do
+  f=${f##*/}
+  f=${f%.cc}
+  echo "Building (C++) gen/bin/test-aux-$f"
+  $CXX $CXX_WARNING_FLAGS -O3 -std=c++11 -pthread test/c/auxiliary/$f.cc \
+      -o gen/bin/test-aux-$f
+  gen/bin/test-aux-$f
+done
+
 ./build-example.sh
 ./build-fuzz.sh
 
@@ -404,7 +404,7 @@ fuzz_swizzle_ycck(wuffs_base__io_buffer* src, uint64_t hash) {
   wuffs_base__status status = wuffs_base__pixel_swizzler__swizzle_ycck(
       &swizzler, &dst_pixbuf, dst_palette,  //
       x_min_incl, x_max_excl,               //
-      y_min_incl, y_max_excl,               //
+      y_min_incl, y_max_excl, y_min_incl,   //
       src0, src1, src2, src3,               //
       width0, width1, width2, width3,       //
       height0, height1, height2, height3,   //
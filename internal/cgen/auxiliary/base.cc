@@ -17,6 +17,20 @@
 
 namespace wuffs_aux {
 
+Executor::~Executor() {}
+
+size_t  //
+Executor::NumWorkers() {
+  return 1;
+}
+
+void  //
+Executor::RunAll(size_t n, const std::function<void(size_t)>& task) {
+  for (size_t i = 0; i < n; i++) {
+    task(i);
+  }
+}
+
 namespace sync_io {
 
 // --------
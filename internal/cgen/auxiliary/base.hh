@@ -15,8 +15,10 @@
 
 #include <stdio.h>
 
+#include <functional>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace wuffs_aux {
 
@@ -31,6 +33,27 @@ using MemOwner = std::unique_ptr<void, decltype(&free)>;
 
 using QuirkKeyValuePair = std::pair<uint32_t, uint64_t>;
 
+// Executor runs tasks, possibly concurrently, on behalf of wuffs_aux functions
+// that can split their work into independent pieces. Wuffs' C code itself
+// does not create threads. It is up to the caller whether and how an Executor
+// implementation uses threads (e.g. a caller-supplied thread pool).
+//
+// This base class' implementation runs every task sequentially, on the
+// calling thread.
+class Executor {
+ public:
+  virtual ~Executor();
+
+  // NumWorkers returns how many tasks this Executor can usefully run at the
+  // same time. wuffs_aux functions may use it as a hint for how many pieces
+  // to split their work into.
+  virtual size_t NumWorkers();
+
+  // RunAll calls task(i) for every i in the range [0, n), possibly
+  // concurrently, and returns after all of those calls have returned.
+  virtual void RunAll(size_t n, const std::function<void(size_t)>& task);
+};
+
 namespace sync_io {
 
 // --------
@@ -0,0 +1,1496 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// https://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or https://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+// ---------------- Auxiliary - Deflate
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__DEFLATE)
+
+#include <algorithm>
+#include <utility>
+
+namespace wuffs_aux {
+
+DeflateCheckpoint::DeflateCheckpoint(uint64_t compressed_pos0,
+                                     uint64_t decompressed_pos0,
+                                     uint32_t bits0,
+                                     std::string&& history0)
+    : compressed_pos(compressed_pos0),
+      decompressed_pos(decompressed_pos0),
+      bits(bits0),
+      history(std::move(history0)) {}
+
+DeflateIndex::DeflateIndex() : fourcc(0), checkpoints() {}
+
+BuildDeflateIndexResult::BuildDeflateIndexResult(DeflateIndex&& index0,
+                                                 std::string&& error_message0)
+    : index(std::move(index0)), error_message(std::move(error_message0)) {}
+
+const char DeflateIndex_BadArgument[] =  //
+    "wuffs_aux::DeflateIndex: bad argument";
+const char DeflateIndex_BadChecksum[] =  //
+    "wuffs_aux::DeflateIndex: bad checksum";
+const char DeflateIndex_BadHeader[] =  //
+    "wuffs_aux::DeflateIndex: bad header";
+const char DeflateIndex_BadIndex[] =  //
+    "wuffs_aux::DeflateIndex: bad index";
+const char DeflateIndex_UnexpectedEndOfFile[] =  //
+    "wuffs_aux::DeflateIndex: unexpected end of file";
+const char DeflateIndex_UnsupportedCompressionFormat[] =  //
+    "wuffs_aux::DeflateIndex: unsupported compression format";
+
+const char DecodeDeflateParallel_BadChecksum[] =  //
+    "wuffs_aux::DecodeDeflateParallel: bad checksum";
+const char DecodeDeflateParallel_BadHeader[] =  //
+    "wuffs_aux::DecodeDeflateParallel: bad header";
+const char DecodeDeflateParallel_OutOfMemory[] =  //
+    "wuffs_aux::DecodeDeflateParallel: out of memory";
+const char DecodeDeflateParallel_UnexpectedEndOfFile[] =  //
+    "wuffs_aux::DecodeDeflateParallel: unexpected end of file";
+const char DecodeDeflateParallel_UnsupportedCompressionFormat[] =  //
+    "wuffs_aux::DecodeDeflateParallel: unsupported compression format";
+
+// --------
+
+namespace {
+
+// The serialized DeflateIndex format is little-endian:
+//  - 8 bytes magic, "WuffsDIx".
+//  - 4 bytes version, 1.
+//  - 4 bytes fourcc.
+//  - 8 bytes number of checkpoints.
+//  - For each checkpoint:
+//    - 8 bytes compressed_pos.
+//    - 8 bytes decompressed_pos.
+//    - 4 bytes bits.
+//    - 4 bytes history length, at most 32768.
+//    - That many bytes of history.
+const char DeflateIndex_Magic[8] = {'W', 'u', 'f', 'f', 's', 'D', 'I', 'x'};
+
+constexpr uint32_t DeflateIndex_Version = 1;
+constexpr size_t DeflateIndex_HistoryLength = 0x8000;
+constexpr size_t DeflateIndex_DstLength = 0x10000;
+constexpr uint64_t DeflateIndex_DefaultSpacing = 0x100000;
+
+void  //
+DeflateIndex_AppendU32LE(std::string& dst, uint32_t x) {
+  uint8_t buf[4];
+  wuffs_base__poke_u32le__no_bounds_check(&buf[0], x);
+  dst.append(reinterpret_cast<const char*>(&buf[0]), 4);
+}
+
+void  //
+DeflateIndex_AppendU64LE(std::string& dst, uint64_t x) {
+  uint8_t buf[8];
+  wuffs_base__poke_u64le__no_bounds_check(&buf[0], x);
+  dst.append(reinterpret_cast<const char*>(&buf[0]), 8);
+}
+
+bool  //
+DeflateIndex_IsValidBits(uint32_t bits) {
+  uint32_t n = bits >> 8;
+  return (n < 8) && (((bits & 0xFF) >> n) == 0);
+}
+
+// DeflateSource wraps a sync_io::Input and the IOBuffer that holds its bytes:
+// the Input's own IOBuffer, if it brings one, or a fallback one.
+class DeflateSource {
+ public:
+  // pos is the position, relative to the start of the gzip or zlib stream, of
+  // the next byte that input will yield.
+  DeflateSource(sync_io::Input& input, uint64_t pos)
+      : io_buf(input.BringsItsOwnIOBuffer()),
+        m_input(input),
+        m_fallback_io_buf(wuffs_base__empty_io_buffer()),
+        m_fallback_io_array(nullptr),
+        m_pos_offset(0) {
+    if (!io_buf) {
+      m_fallback_io_array = std::unique_ptr<uint8_t[]>(new uint8_t[65536]);
+      m_fallback_io_buf =
+          wuffs_base__ptr_u8__writer(m_fallback_io_array.get(), 65536);
+      io_buf = &m_fallback_io_buf;
+    }
+    m_pos_offset = pos - io_buf->reader_position();
+  }
+
+  // Position returns the stream-relative position of the next unread byte.
+  uint64_t Position() const {
+    return m_pos_offset + io_buf->reader_position();
+  }
+
+  // Fill reads more bytes into io_buf.
+  std::string Fill() {
+    if (io_buf->meta.closed) {
+      return DeflateIndex_UnexpectedEndOfFile;
+    }
+    io_buf->compact();
+    if (io_buf->meta.wi >= io_buf->data.len) {
+      return "wuffs_aux::DeflateIndex: internal error: io_buf is full";
+    }
+    return m_input.CopyIn(io_buf);
+  }
+
+  // Ensure reads until io_buf holds at least n unread bytes.
+  std::string Ensure(size_t n) {
+    while (io_buf->reader_length() < n) {
+      std::string error_message = Fill();
+      if (!error_message.empty()) {
+        return error_message;
+      }
+    }
+    return "";
+  }
+
+  // AtEndOfFile returns whether there are no more bytes to read.
+  bool AtEndOfFile(std::string& error_message) {
+    while (io_buf->reader_length() == 0) {
+      if (io_buf->meta.closed) {
+        return true;
+      }
+      error_message = Fill();
+      if (!error_message.empty()) {
+        return false;
+      }
+    }
+    return false;
+  }
+
+  std::string Skip(uint64_t n) {
+    while (n > 0) {
+      if (io_buf->reader_length() == 0) {
+        std::string error_message = Fill();
+        if (!error_message.empty()) {
+          return error_message;
+        }
+        continue;
+      }
+      size_t m = static_cast<size_t>(std::min<uint64_t>(
+          n, static_cast<uint64_t>(io_buf->reader_length())));
+      io_buf->meta.ri += m;
+      n -= m;
+    }
+    return "";
+  }
+
+  std::string SkipNulTerminated() {
+    while (true) {
+      if (io_buf->reader_length() == 0) {
+        std::string error_message = Fill();
+        if (!error_message.empty()) {
+          return error_message;
+        }
+        continue;
+      }
+      if (io_buf->data.ptr[io_buf->meta.ri++] == 0) {
+        return "";
+      }
+    }
+  }
+
+  wuffs_base__io_buffer* io_buf;
+
+ private:
+  sync_io::Input& m_input;
+  wuffs_base__io_buffer m_fallback_io_buf;
+  std::unique_ptr<uint8_t[]> m_fallback_io_array;
+  uint64_t m_pos_offset;
+};
+
+bool  //
+DeflateIndex_IsZlibHeader(const uint8_t* p) {
+  return ((p[0] & 0x0F) == 0x08) && ((p[0] >> 4) <= 7) &&
+         ((((static_cast<uint32_t>(p[0]) << 8) | p[1]) % 31) == 0);
+}
+
+// DeflateIndex_DetectFourCC returns WUFFS_BASE__FOURCC__GZ or
+// WUFFS_BASE__FOURCC__ZLIB, based on a stream's first two bytes, or zero if
+// it is neither.
+uint32_t  //
+DeflateIndex_DetectFourCC(const uint8_t* p) {
+  if ((p[0] == 0x1F) && (p[1] == 0x8B)) {
+    return WUFFS_BASE__FOURCC__GZ;
+  } else if (DeflateIndex_IsZlibHeader(p)) {
+    return WUFFS_BASE__FOURCC__ZLIB;
+  }
+  return 0;
+}
+
+// DeflateIndex_ReadHeader consumes a gzip (RFC 1952) member header or a zlib
+// (RFC 1950) stream header.
+std::string  //
+DeflateIndex_ReadHeader(DeflateSource& src, uint32_t fourcc) {
+  if (fourcc == WUFFS_BASE__FOURCC__ZLIB) {
+    std::string error_message = src.Ensure(2);
+    if (!error_message.empty()) {
+      return error_message;
+    }
+    const uint8_t* p = src.io_buf->reader_pointer();
+    if (!DeflateIndex_IsZlibHeader(p)) {
+      return DeflateIndex_BadHeader;
+    } else if (p[1] & 0x20) {
+      // A preset dictionary (FDICT) is not supported.
+      return DeflateIndex_UnsupportedCompressionFormat;
+    }
+    src.io_buf->meta.ri += 2;
+    return "";
+  }
+
+  std::string error_message = src.Ensure(10);
+  if (!error_message.empty()) {
+    return error_message;
+  }
+  const uint8_t* p = src.io_buf->reader_pointer();
+  if ((p[0] != 0x1F) || (p[1] != 0x8B) || (p[2] != 0x08) || (p[3] & 0xE0)) {
+    return DeflateIndex_BadHeader;
+  }
+  uint8_t flags = p[3];
+  src.io_buf->meta.ri += 10;
+
+  if (flags & 0x04) {  // FEXTRA.
+    error_message = src.Ensure(2);
+    if (!error_message.empty()) {
+      return error_message;
+    }
+    uint16_t xlen =
+        wuffs_base__peek_u16le__no_bounds_check(src.io_buf->reader_pointer());
+    src.io_buf->meta.ri += 2;
+    error_message = src.Skip(xlen);
+    if (!error_message.empty()) {
+      return error_message;
+    }
+  }
+  if (flags & 0x08) {  // FNAME.
+    error_message = src.SkipNulTerminated();
+    if (!error_message.empty()) {
+      return error_message;
+    }
+  }
+  if (flags & 0x10) {  // FCOMMENT.
+    error_message = src.SkipNulTerminated();
+    if (!error_message.empty()) {
+      return error_message;
+    }
+  }
+  if (flags & 0x02) {  // FHCRC.
+    error_message = src.Skip(2);
+    if (!error_message.empty()) {
+      return error_message;
+    }
+  }
+  return "";
+}
+
+// DeflateIndex_ReadFooter consumes a gzip member footer (CRC-32 and ISIZE) or
+// a zlib stream footer (Adler-32), comparing it to the wanted values.
+std::string  //
+DeflateIndex_ReadFooter(DeflateSource& src,
+                        uint32_t fourcc,
+                        uint32_t want_checksum,
+                        uint64_t want_length) {
+  size_t n = (fourcc == WUFFS_BASE__FOURCC__ZLIB) ? 4 : 8;
+  std::string error_message = src.Ensure(n);
+  if (!error_message.empty()) {
+    return error_message;
+  }
+  const uint8_t* p = src.io_buf->reader_pointer();
+  src.io_buf->meta.ri += n;
+  if (fourcc == WUFFS_BASE__FOURCC__ZLIB) {
+    if (wuffs_base__peek_u32be__no_bounds_check(p) != want_checksum) {
+      return DeflateIndex_BadChecksum;
+    }
+  } else if ((wuffs_base__peek_u32le__no_bounds_check(p + 0) !=
+              want_checksum) ||
+             (wuffs_base__peek_u32le__no_bounds_check(p + 4) !=
+              static_cast<uint32_t>(want_length))) {
+    return DeflateIndex_BadChecksum;
+  }
+  return "";
+}
+
+// DeflateIndex_InitializeDecoder (re-)initializes dec. It also resets dst,
+// which must be empty, as the decoder expects dst's position to be relative
+// to where its decoding started.
+std::string  //
+DeflateIndex_InitializeDecoder(wuffs_deflate__decoder* dec,
+                               wuffs_base__io_buffer* dst,
+                               uint64_t spacing) {
+  dst->meta.wi = 0;
+  dst->meta.ri = 0;
+  dst->meta.pos = 0;
+  wuffs_base__status status =
+      dec->initialize(sizeof__wuffs_deflate__decoder(), WUFFS_VERSION,
+                      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+  if (status.repr) {
+    return status.message();
+  } else if (spacing > 0) {
+    status = dec->set_quirk(WUFFS_DEFLATE__QUIRK_YIELD_AT_BLOCK_BOUNDARIES,
+                            spacing);
+    if (status.repr) {
+      return status.message();
+    }
+  }
+  return "";
+}
+
+}  // namespace
+
+// --------
+
+const DeflateCheckpoint*  //
+DeflateIndex::Find(uint64_t decompressed_pos) const {
+  auto iter = std::upper_bound(
+      checkpoints.begin(), checkpoints.end(), decompressed_pos,
+      [](uint64_t pos, const DeflateCheckpoint& c) -> bool {
+        return pos < c.decompressed_pos;
+      });
+  if (iter == checkpoints.begin()) {
+    return nullptr;
+  }
+  return &*(iter - 1);
+}
+
+void  //
+DeflateIndex::Serialize(std::string& dst) const {
+  dst.append(&DeflateIndex_Magic[0], 8);
+  DeflateIndex_AppendU32LE(dst, DeflateIndex_Version);
+  DeflateIndex_AppendU32LE(dst, fourcc);
+  DeflateIndex_AppendU64LE(dst, checkpoints.size());
+  for (const auto& c : checkpoints) {
+    DeflateIndex_AppendU64LE(dst, c.compressed_pos);
+    DeflateIndex_AppendU64LE(dst, c.decompressed_pos);
+    DeflateIndex_AppendU32LE(dst, c.bits);
+    DeflateIndex_AppendU32LE(dst, static_cast<uint32_t>(c.history.size()));
+    dst.append(c.history);
+  }
+}
+
+std::string  //
+DeflateIndex::Parse(const uint8_t* ptr, size_t len) {
+  fourcc = 0;
+  checkpoints.clear();
+
+  if ((len < 24) || (memcmp(ptr, &DeflateIndex_Magic[0], 8) != 0) ||
+      (wuffs_base__peek_u32le__no_bounds_check(ptr + 8) !=
+       DeflateIndex_Version)) {
+    return DeflateIndex_BadIndex;
+  }
+  uint32_t new_fourcc = wuffs_base__peek_u32le__no_bounds_check(ptr + 12);
+  uint64_t n = wuffs_base__peek_u64le__no_bounds_check(ptr + 16);
+  if ((new_fourcc != WUFFS_BASE__FOURCC__GZ) &&
+      (new_fourcc != WUFFS_BASE__FOURCC__ZLIB)) {
+    return DeflateIndex_BadIndex;
+  }
+  ptr += 24;
+  len -= 24;
+
+  std::vector<DeflateCheckpoint> new_checkpoints;
+  for (; n > 0; n--) {
+    if (len < 24) {
+      return DeflateIndex_BadIndex;
+    }
+    uint64_t cpos = wuffs_base__peek_u64le__no_bounds_check(ptr + 0);
+    uint64_t dpos = wuffs_base__peek_u64le__no_bounds_check(ptr + 8);
+    uint32_t bits = wuffs_base__peek_u32le__no_bounds_check(ptr + 16);
+    uint32_t hlen = wuffs_base__peek_u32le__no_bounds_check(ptr + 20);
+    ptr += 24;
+    len -= 24;
+    if (!DeflateIndex_IsValidBits(bits) ||
+        (hlen > DeflateIndex_HistoryLength) || (hlen > len) ||
+        (!new_checkpoints.empty() &&
+         ((cpos < new_checkpoints.back().compressed_pos) ||
+          (dpos < new_checkpoints.back().decompressed_pos)))) {
+      return DeflateIndex_BadIndex;
+    }
+    new_checkpoints.emplace_back(
+        cpos, dpos, bits,
+        std::string(reinterpret_cast<const char*>(ptr), hlen));
+    ptr += hlen;
+    len -= hlen;
+  }
+  if (len != 0) {
+    return DeflateIndex_BadIndex;
+  }
+
+  fourcc = new_fourcc;
+  checkpoints = std::move(new_checkpoints);
+  return "";
+}
+
+// --------
+
+BuildDeflateIndexResult  //
+BuildDeflateIndex(sync_io::Input& input, uint64_t spacing) {
+  if (spacing == 0) {
+    spacing = DeflateIndex_DefaultSpacing;
+  }
+  DeflateIndex index;
+  DeflateSource src(input, 0);
+
+  // Detect the format.
+  std::string error_message = src.Ensure(2);
+  if (!error_message.empty()) {
+    return BuildDeflateIndexResult(std::move(index), std::move(error_message));
+  }
+  index.fourcc = DeflateIndex_DetectFourCC(src.io_buf->reader_pointer());
+  if (index.fourcc == 0) {
+    return BuildDeflateIndexResult(
+        std::move(index), DeflateIndex_UnsupportedCompressionFormat);
+  }
+
+  wuffs_deflate__decoder::unique_ptr dec = wuffs_deflate__decoder::alloc();
+  wuffs_crc32__ieee_hasher::unique_ptr crc32 =
+      wuffs_crc32__ieee_hasher::alloc();
+  wuffs_adler32__hasher::unique_ptr adler32 = wuffs_adler32__hasher::alloc();
+  std::unique_ptr<uint8_t[]> dst_array(new uint8_t[DeflateIndex_DstLength]);
+  if (!dec || !crc32 || !adler32 || !dst_array) {
+    return BuildDeflateIndexResult(
+        std::move(index), "wuffs_aux::DeflateIndex: out of memory");
+  }
+  wuffs_base__io_buffer dst =
+      wuffs_base__ptr_u8__writer(dst_array.get(), DeflateIndex_DstLength);
+  uint8_t workbuf_array[WUFFS_DEFLATE__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE];
+  wuffs_base__slice_u8 workbuf =
+      wuffs_base__make_slice_u8(&workbuf_array[0], sizeof(workbuf_array));
+
+  uint64_t decompressed_pos = 0;
+  uint64_t previous_pos = 0;
+  while (true) {
+    // Start a gzip member or the zlib stream.
+    error_message = DeflateIndex_ReadHeader(src, index.fourcc);
+    if (error_message.empty()) {
+      error_message = DeflateIndex_InitializeDecoder(dec.get(), &dst, spacing);
+    }
+    if (error_message.empty()) {
+      wuffs_base__status status =
+          (index.fourcc == WUFFS_BASE__FOURCC__ZLIB)
+              ? adler32->initialize(sizeof__wuffs_adler32__hasher(),
+                                    WUFFS_VERSION, 0)
+              : crc32->initialize(sizeof__wuffs_crc32__ieee_hasher(),
+                                  WUFFS_VERSION, 0);
+      if (status.repr) {
+        error_message = status.message();
+      }
+    }
+    if (!error_message.empty()) {
+      break;
+    }
+    if (index.checkpoints.empty() ||
+        ((decompressed_pos - previous_pos) >= spacing)) {
+      index.checkpoints.emplace_back(src.Position(), decompressed_pos, 0,
+                                     std::string());
+      previous_pos = decompressed_pos;
+    }
+
+    // Decode the DEFLATE data.
+    uint64_t member_length = 0;
+    uint32_t checksum = (index.fourcc == WUFFS_BASE__FOURCC__ZLIB) ? 1 : 0;
+    while (true) {
+      wuffs_base__status status =
+          dec->transform_io(&dst, src.io_buf, workbuf);
+
+      if (dst.meta.wi > 0) {
+        wuffs_base__slice_u8 s =
+            wuffs_base__make_slice_u8(dst.data.ptr, dst.meta.wi);
+        checksum = (index.fourcc == WUFFS_BASE__FOURCC__ZLIB)
+                       ? adler32->update_u32(s)
+                       : crc32->update_u32(s);
+        member_length += dst.meta.wi;
+        decompressed_pos += dst.meta.wi;
+        dst.meta.ri = dst.meta.wi;
+        dst.compact();
+      }
+
+      if (status.repr == nullptr) {
+        break;
+      } else if (status.repr == wuffs_base__suspension__short_write) {
+        continue;
+      } else if (status.repr == wuffs_base__suspension__short_read) {
+        error_message = src.Fill();
+      } else if (status.repr == wuffs_deflate__suspension__block_boundary) {
+        std::string history(DeflateIndex_HistoryLength, '\x00');
+        uint64_t n = dec->checkpoint_history(wuffs_base__make_slice_u8(
+            reinterpret_cast<uint8_t*>(&history[0]), history.size()));
+        history.resize(static_cast<size_t>(n));
+        index.checkpoints.emplace_back(src.Position(), decompressed_pos,
+                                       dec->checkpoint_bits(),
+                                       std::move(history));
+        previous_pos = decompressed_pos;
+      } else {
+        error_message = status.message();
+      }
+      if (!error_message.empty()) {
+        break;
+      }
+    }
+    if (!error_message.empty()) {
+      break;
+    }
+
+    // Finish the gzip member or the zlib stream.
+    error_message =
+        DeflateIndex_ReadFooter(src, index.fourcc, checksum, member_length);
+    if (!error_message.empty() || (index.fourcc == WUFFS_BASE__FOURCC__ZLIB) ||
+        src.AtEndOfFile(error_message) || !error_message.empty()) {
+      break;
+    }
+  }
+
+  return BuildDeflateIndexResult(std::move(index), std::move(error_message));
+}
+
+// --------
+
+std::string  //
+DecodeDeflateRange(std::string& dst,
+                   const DeflateIndex& index,
+                   const DeflateCheckpoint& checkpoint,
+                   sync_io::Input& input,
+                   uint64_t pos,
+                   uint64_t length) {
+  if (((index.fourcc != WUFFS_BASE__FOURCC__GZ) &&
+       (index.fourcc != WUFFS_BASE__FOURCC__ZLIB)) ||
+      (pos < checkpoint.decompressed_pos) ||
+      !DeflateIndex_IsValidBits(checkpoint.bits) ||
+      (checkpoint.history.size() > DeflateIndex_HistoryLength)) {
+    return DeflateIndex_BadArgument;
+  } else if (length == 0) {
+    return "";
+  }
+  uint64_t skip = pos - checkpoint.decompressed_pos;
+  DeflateSource src(input, checkpoint.compressed_pos);
+
+  wuffs_deflate__decoder::unique_ptr dec = wuffs_deflate__decoder::alloc();
+  std::unique_ptr<uint8_t[]> dst_array(new uint8_t[DeflateIndex_DstLength]);
+  if (!dec || !dst_array) {
+    return "wuffs_aux::DeflateIndex: out of memory";
+  }
+  wuffs_base__io_buffer io_dst =
+      wuffs_base__ptr_u8__writer(dst_array.get(), DeflateIndex_DstLength);
+  uint8_t workbuf_array[WUFFS_DEFLATE__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE];
+  wuffs_base__slice_u8 workbuf =
+      wuffs_base__make_slice_u8(&workbuf_array[0], sizeof(workbuf_array));
+
+  std::string error_message =
+      DeflateIndex_InitializeDecoder(dec.get(), &io_dst, 0);
+  if (!error_message.empty()) {
+    return error_message;
+  }
+  wuffs_base__status status = dec->set_checkpoint_bits(checkpoint.bits);
+  if (status.repr) {
+    return status.message();
+  }
+  dec->add_history(wuffs_base__make_slice_u8(
+      reinterpret_cast<uint8_t*>(const_cast<char*>(checkpoint.history.data())),
+      checkpoint.history.size()));
+
+  while (true) {
+    status = dec->transform_io(&io_dst, src.io_buf, workbuf);
+
+    const uint8_t* p = io_dst.reader_pointer();
+    size_t n = io_dst.reader_length();
+    io_dst.meta.ri = io_dst.meta.wi;
+    io_dst.compact();
+    if (skip >= n) {
+      skip -= n;
+    } else {
+      p += skip;
+      n -= static_cast<size_t>(skip);
+      skip = 0;
+      if (n >= length) {
+        dst.append(reinterpret_cast<const char*>(p),
+                   static_cast<size_t>(length));
+        return "";
+      }
+      dst.append(reinterpret_cast<const char*>(p), n);
+      length -= n;
+    }
+
+    if (status.repr == nullptr) {
+      // Move on to the next gzip member, if any.
+      if (index.fourcc == WUFFS_BASE__FOURCC__ZLIB) {
+        break;
+      }
+      error_message = src.Skip(8);
+      if (!error_message.empty() || src.AtEndOfFile(error_message) ||
+          !error_message.empty()) {
+        break;
+      }
+      error_message = DeflateIndex_ReadHeader(src, index.fourcc);
+      if (error_message.empty()) {
+        error_message = DeflateIndex_InitializeDecoder(dec.get(), &io_dst, 0);
+      }
+    } else if (status.repr == wuffs_base__suspension__short_write) {
+      continue;
+    } else if (status.repr == wuffs_base__suspension__short_read) {
+      error_message = src.Fill();
+    } else {
+      error_message = status.message();
+    }
+    if (!error_message.empty()) {
+      break;
+    }
+  }
+  return error_message;
+}
+
+// --------
+
+// DecodeDeflateParallel works in rounds. Each round splits the next part of
+// the compressed stream into up to NumWorkers() chunks, decoding each one as
+// a separate executor task. A round's first chunk starts from a known state
+// (a bit position and history window, like a DeflateCheckpoint), but the
+// other chunks are speculative, in the style of pugz: the task guesses where
+// the first DEFLATE block in its chunk starts and decodes from there with an
+// unknown history window.
+//
+// A speculative task decodes twice, with two different placeholder windows.
+// An output byte that is the same in both is a literal (or was copied from
+// one). Otherwise, that pair of bytes identifies which window byte it was
+// copied from, and it is resolved after the previous chunk's output is
+// known. The second decode stops once both decoders' histories match, as
+// everything after that is independent of the window.
+//
+// A guess is confirmed when the previous chunk's decoding ends (at a block
+// boundary) at exactly that bit position. Otherwise, that chunk and the rest
+// of the round are discarded and the next round starts, from a known state,
+// where the previous chunk ended.
+//
+// A round with a wrong guess (or no guess at all) means that the stream is
+// hard to split, e.g. it has only fixed Huffman or stored blocks. The next
+// rounds are then sequential (a single chunk each), for exponentially more
+// rounds after each consecutive wrong guess. Along with bounding each task's
+// scan for a block start, this keeps the wasted work small compared to
+// sequential decoding.
+//
+// Each chunk also ends early, at a block boundary, once it has decoded
+// DecodeDeflateParallel_MaxChunkDecodedLength bytes, so that highly
+// compressible input does not buffer memory in proportion to its decoded
+// length. The next round then starts where that chunk ended. This is not a
+// wrong guess, so it does not back off.
+
+namespace {
+
+// DecodeDeflateParallel_ChunkLength is the compressed length of each chunk.
+constexpr uint64_t DecodeDeflateParallel_ChunkLength = 0x400000;
+
+// DecodeDeflateParallel_MaxChunkDecodedLength bounds (give or take one
+// DEFLATE block) how much decoded output each chunk buffers.
+constexpr uint64_t DecodeDeflateParallel_MaxChunkDecodedLength = 0x2000000;
+
+// DecodeDeflateParallel_GuessLength bounds how much compressed input a guessed
+// block start can use to reach its first block boundary.
+constexpr uint64_t DecodeDeflateParallel_GuessLength = 0x100000;
+
+// DecodeDeflateParallel_ScanLength bounds how far into its chunk a
+// speculative task looks for a block start. Dynamic Huffman blocks are
+// typically far shorter than this. Scanning further would mostly waste time
+// on streams without any (e.g. those with only fixed Huffman or stored
+// blocks), as every bit position is a candidate.
+constexpr uint64_t DecodeDeflateParallel_ScanLength = 0x40000;
+
+// DecodeDeflateParallel_MaxBackoff bounds how many consecutive rounds are
+// decoded sequentially after a wrong guess.
+constexpr uint64_t DecodeDeflateParallel_MaxBackoff = 0x10000;
+
+// DecodeDeflateParallel_RenameError maps the DeflateIndex_Etc error messages
+// returned by the code shared with BuildDeflateIndex to their
+// DecodeDeflateParallel_Etc equivalents.
+std::string  //
+DecodeDeflateParallel_RenameError(const std::string& error_message) {
+  if (error_message == DeflateIndex_BadChecksum) {
+    return DecodeDeflateParallel_BadChecksum;
+  } else if (error_message == DeflateIndex_BadHeader) {
+    return DecodeDeflateParallel_BadHeader;
+  } else if (error_message == DeflateIndex_UnexpectedEndOfFile) {
+    return DecodeDeflateParallel_UnexpectedEndOfFile;
+  } else if (error_message == DeflateIndex_UnsupportedCompressionFormat) {
+    return DecodeDeflateParallel_UnsupportedCompressionFormat;
+  }
+  return error_message;
+}
+
+// DecodeDeflateParallel_BitReader reads a DEFLATE stream's bits, least
+// significant bit first.
+class DecodeDeflateParallel_BitReader {
+ public:
+  DecodeDeflateParallel_BitReader(const uint8_t* ptr,
+                                  size_t len,
+                                  uint64_t bit_pos)
+      : m_ptr(ptr),
+        m_len_bits(static_cast<uint64_t>(len) * 8),
+        m_pos(bit_pos) {}
+
+  bool Read(uint32_t n, uint32_t& dst) {
+    if ((m_pos > m_len_bits) || (n > (m_len_bits - m_pos))) {
+      return false;
+    }
+    dst = 0;
+    for (uint32_t i = 0; i < n; i++, m_pos++) {
+      uint32_t bit = (m_ptr[m_pos >> 3] >> (m_pos & 7)) & 1;
+      dst |= bit << i;
+    }
+    return true;
+  }
+
+ private:
+  const uint8_t* m_ptr;
+  uint64_t m_len_bits;
+  uint64_t m_pos;
+};
+
+// DecodeDeflateParallel_Huffman is a canonical Huffman code, decoded one bit
+// at a time. It is slow but it is only used on block headers.
+class DecodeDeflateParallel_Huffman {
+ public:
+  // Build returns the Kraft inequality's slack: zero for a complete code,
+  // positive for an incomplete code and negative for an over-subscribed one.
+  int32_t Build(const uint8_t* lengths, uint32_t n) {
+    for (uint32_t i = 0; i < 16; i++) {
+      m_counts[i] = 0;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+      m_counts[lengths[i]]++;
+    }
+    m_counts[0] = 0;
+    int32_t slack = 1;
+    uint32_t offsets[16];
+    offsets[1] = 0;
+    for (uint32_t i = 1; i < 16; i++) {
+      slack = (slack << 1) - static_cast<int32_t>(m_counts[i]);
+      if (slack < 0) {
+        return slack;
+      } else if (i < 15) {
+        offsets[i + 1] = offsets[i] + m_counts[i];
+      }
+    }
+    for (uint32_t i = 0; i < n; i++) {
+      if (lengths[i]) {
+        m_symbols[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+      }
+    }
+    return slack;
+  }
+
+  // Decode returns the next symbol, or -1 on error.
+  int32_t Decode(DecodeDeflateParallel_BitReader& r) {
+    int32_t code = 0;
+    int32_t first = 0;
+    int32_t index = 0;
+    for (uint32_t i = 1; i < 16; i++) {
+      uint32_t bit;
+      if (!r.Read(1, bit)) {
+        return -1;
+      }
+      code |= static_cast<int32_t>(bit);
+      int32_t count = static_cast<int32_t>(m_counts[i]);
+      if ((code - first) < count) {
+        return m_symbols[index + code - first];
+      }
+      index += count;
+      first = (first + count) << 1;
+      code <<= 1;
+    }
+    return -1;
+  }
+
+ private:
+  uint16_t m_counts[16];
+  uint16_t m_symbols[288];
+};
+
+// DecodeDeflateParallel_IsBlockStart returns whether a non-final dynamic
+// Huffman block's header plausibly starts at the bit_pos'th bit of ptr. It
+// checks that the header's Huffman codes are well-formed, which rejects
+// almost every bit position that is not a block start.
+bool  //
+DecodeDeflateParallel_IsBlockStart(const uint8_t* ptr,
+                                   size_t len,
+                                   uint64_t bit_pos) {
+  static const uint8_t clen_order[19] = {
+      16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15,
+  };
+
+  // Check the first 17 bits (BFINAL, BTYPE, HLIT, HDIST and HCLEN) quickly, as
+  // this function is called for every bit position. BFINAL (1 bit) must be 0
+  // and BTYPE (2 bits) must be 2.
+  size_t byte_index = static_cast<size_t>(bit_pos >> 3);
+  if ((byte_index >= len) || ((len - byte_index) < 4)) {
+    return false;
+  }
+  uint32_t x = wuffs_base__peek_u32le__no_bounds_check(ptr + byte_index) >>
+               (bit_pos & 7);
+  if (((x & 7) != 4) || (((x >> 3) & 31) > 29) || (((x >> 8) & 31) > 29)) {
+    return false;
+  }
+  uint32_t n_lit = 257 + ((x >> 3) & 31);
+  uint32_t n_dist = 1 + ((x >> 8) & 31);
+  uint32_t n_clen = 4 + ((x >> 13) & 15);
+
+  // The code length code lengths take at most 57 bits. Peeking 8 bytes gets
+  // at least that many, after shifting out the up-to-7 leading bits.
+  uint64_t clen_bit_pos = bit_pos + 17;
+  byte_index = static_cast<size_t>(clen_bit_pos >> 3);
+  if ((len - byte_index) < 8) {
+    return false;
+  }
+  uint64_t y = wuffs_base__peek_u64le__no_bounds_check(ptr + byte_index) >>
+               (clen_bit_pos & 7);
+  uint8_t clens[19] = {0};
+  uint32_t kraft = 0;
+  for (uint32_t i = 0; i < n_clen; i++, y >>= 3) {
+    uint32_t c = static_cast<uint32_t>(y & 7);
+    clens[clen_order[i]] = static_cast<uint8_t>(c);
+    kraft += c ? (0x80 >> c) : 0;
+  }
+  // Cheaply reject an incomplete or over-subscribed code length code, as
+  // that is where almost every bit position that is not a block start fails.
+  if (kraft != 0x80) {
+    return false;
+  }
+  DecodeDeflateParallel_BitReader r(ptr, len, clen_bit_pos + (3 * n_clen));
+  DecodeDeflateParallel_Huffman h;
+  if (h.Build(&clens[0], 19) != 0) {
+    return false;
+  }
+
+  uint8_t lengths[286 + 30] = {0};
+  uint32_t n = n_lit + n_dist;
+  for (uint32_t i = 0; i < n;) {
+    int32_t symbol = h.Decode(r);
+    if (symbol < 0) {
+      return false;
+    } else if (symbol < 16) {
+      lengths[i++] = static_cast<uint8_t>(symbol);
+      continue;
+    }
+    uint8_t value = 0;
+    uint32_t repeat = 0;
+    if (symbol == 16) {
+      if ((i == 0) || !r.Read(2, x)) {
+        return false;
+      }
+      value = lengths[i - 1];
+      repeat = 3 + x;
+    } else if (symbol == 17) {
+      if (!r.Read(3, x)) {
+        return false;
+      }
+      repeat = 3 + x;
+    } else {
+      if (!r.Read(7, x)) {
+        return false;
+      }
+      repeat = 11 + x;
+    }
+    if (repeat > (n - i)) {
+      return false;
+    }
+    for (; repeat > 0; repeat--) {
+      lengths[i++] = value;
+    }
+  }
+
+  // The end-of-block code must be present, the literal/length code must be
+  // complete and the distance code must not be over-subscribed.
+  return (lengths[256] != 0) && (h.Build(&lengths[0], n_lit) == 0) &&
+         (h.Build(&lengths[n_lit], n_dist) >= 0);
+}
+
+// DecodeDeflateParallel_Placeholders sets the two placeholder windows. For
+// every k, the (a[k], b[k]) pair is unique and a[k] != b[k].
+void  //
+DecodeDeflateParallel_Placeholders(std::string& a, std::string& b) {
+  a.resize(DeflateIndex_HistoryLength);
+  b.resize(DeflateIndex_HistoryLength);
+  for (size_t k = 0; k < DeflateIndex_HistoryLength; k++) {
+    uint8_t x = static_cast<uint8_t>(k);
+    a[k] = static_cast<char>(x);
+    b[k] = static_cast<char>(static_cast<uint8_t>(x + 1 + (k >> 8)));
+  }
+}
+
+// DecodeDeflateParallel_Resolve replaces the placeholder-derived bytes in
+// a[i .. j] with the window bytes that they stand for. window holds up to 32
+// KiB of the output immediately before a[0]. It returns false if a and b are
+// inconsistent.
+bool  //
+DecodeDeflateParallel_Resolve(uint8_t* a,
+                              const uint8_t* b,
+                              size_t i,
+                              size_t j,
+                              const std::string& window) {
+  size_t missing = DeflateIndex_HistoryLength - window.size();
+  for (; i < j; i++) {
+    if (a[i] == b[i]) {
+      continue;
+    }
+    uint8_t d = static_cast<uint8_t>(b[i] - a[i]);
+    size_t k = a[i] | (static_cast<size_t>(d - 1) << 8);
+    if ((d == 0) || (d > 128) || (k < missing)) {
+      return false;
+    }
+    a[i] = static_cast<uint8_t>(window[k - missing]);
+  }
+  return true;
+}
+
+// DecodeDeflateParallel_Tail returns the last 32 KiB of the concatenation of
+// window and ptr[.. len].
+std::string  //
+DecodeDeflateParallel_Tail(const std::string& window,
+                           const uint8_t* ptr,
+                           size_t len) {
+  if (len >= DeflateIndex_HistoryLength) {
+    return std::string(reinterpret_cast<const char*>(
+                           ptr + (len - DeflateIndex_HistoryLength)),
+                       DeflateIndex_HistoryLength);
+  }
+  size_t n = std::min(window.size(), DeflateIndex_HistoryLength - len);
+  std::string s(window, window.size() - n, n);
+  s.append(reinterpret_cast<const char*>(ptr), len);
+  return s;
+}
+
+// DecodeDeflateParallel_Decoder decodes, from a given bit position onwards,
+// into a growable buffer, stopping at each block boundary.
+class DecodeDeflateParallel_Decoder {
+ public:
+  DecodeDeflateParallel_Decoder()
+      : dst(UINT64_MAX),
+        src(wuffs_base__empty_io_buffer()),
+        at_end(false),
+        m_dec(),
+        m_len(0) {}
+
+  // Start prepares to decode ptr[.. len], starting at bit_pos and with the
+  // given history. If guess_len is non-zero then the source is limited, until
+  // the first block boundary, to that many bytes.
+  std::string Start(const uint8_t* ptr,
+                    size_t len,
+                    uint64_t bit_pos,
+                    const std::string& history,
+                    uint64_t guess_len) {
+    if (!m_dec) {
+      m_dec = wuffs_deflate__decoder::alloc();
+      if (!m_dec) {
+        return DecodeDeflateParallel_OutOfMemory;
+      }
+    }
+    std::string error_message =
+        DeflateIndex_InitializeDecoder(m_dec.get(), &dst.m_buf, 1);
+    if (!error_message.empty()) {
+      return error_message;
+    }
+
+    size_t pos = static_cast<size_t>(bit_pos >> 3);
+    uint32_t bits = 0;
+    if (bit_pos & 7) {
+      bits = ((8 - static_cast<uint32_t>(bit_pos & 7)) << 8) |
+             (ptr[pos] >> (bit_pos & 7));
+      pos++;
+    }
+    wuffs_base__status status = m_dec->set_checkpoint_bits(bits);
+    if (status.repr) {
+      return status.message();
+    } else if (!history.empty()) {
+      m_dec->add_history(wuffs_base__make_slice_u8(
+          reinterpret_cast<uint8_t*>(const_cast<char*>(history.data())),
+          history.size()));
+    }
+
+    src = wuffs_base__ptr_u8__reader(const_cast<uint8_t*>(ptr), len, true);
+    src.meta.ri = pos;
+    m_len = len;
+    if ((guess_len > 0) && (guess_len < (len - pos))) {
+      src.meta.wi = pos + static_cast<size_t>(guess_len);
+      src.meta.closed = false;
+    }
+    at_end = false;
+    return "";
+  }
+
+  // Next decodes up to the next block boundary or the end of the stream (in
+  // which case it sets at_end).
+  std::string Next() {
+    while (true) {
+      uint8_t workbuf_array[1];
+      wuffs_base__status status = m_dec->transform_io(
+          &dst.m_buf, &src, wuffs_base__make_slice_u8(&workbuf_array[0], 1));
+      if (status.repr == wuffs_base__suspension__short_write) {
+        if (dst.grow(dst.m_buf.data.len + 1) !=
+            sync_io::DynIOBuffer::GrowResult::OK) {
+          return DecodeDeflateParallel_OutOfMemory;
+        }
+        continue;
+      }
+      src.meta.wi = m_len;
+      src.meta.closed = true;
+      if (status.repr == wuffs_deflate__suspension__block_boundary) {
+        return "";
+      } else if (status.repr == nullptr) {
+        at_end = true;
+        return "";
+      } else if ((status.repr == wuffs_base__suspension__short_read) ||
+                 (status.repr == wuffs_deflate__error__truncated_input)) {
+        return DecodeDeflateParallel_UnexpectedEndOfFile;
+      }
+      return status.message();
+    }
+  }
+
+  // BitPosition returns the bit position of the next unconsumed bit.
+  uint64_t BitPosition() const {
+    return (static_cast<uint64_t>(src.meta.ri) * 8) -
+           (m_dec->checkpoint_bits() >> 8);
+  }
+
+  sync_io::DynIOBuffer dst;
+  wuffs_base__io_buffer src;
+  bool at_end;
+
+ private:
+  wuffs_deflate__decoder::unique_ptr m_dec;
+  size_t m_len;
+};
+
+struct DecodeDeflateParallel_Chunk {
+  DecodeDeflateParallel_Chunk()
+      : start_bits(0),
+        end_bits(0),
+        end_pos(0),
+        converged(SIZE_MAX),
+        capped(false),
+        error_message(),
+        a(),
+        b() {}
+
+  bool at_end() const { return a.at_end; }
+
+  // Run decodes, starting at start_bits, up to the first block boundary at or
+  // after limit_bits (or after DecodeDeflateParallel_MaxChunkDecodedLength
+  // decoded bytes, in which case it sets capped). If window is nullptr then the start is a guess, and
+  // start_bits is updated to the guessed block start.
+  void Run(const uint8_t* ptr,
+           size_t len,
+           uint64_t limit_bits,
+           const std::string* window,
+           const std::string& placeholder_a,
+           const std::string& placeholder_b) {
+    if (window) {
+      converged = 0;
+      error_message = a.Start(ptr, len, start_bits, *window, 0);
+    } else {
+      error_message = Guess(ptr, len, limit_bits, placeholder_a);
+      if (error_message.empty()) {
+        error_message = b.Start(ptr, len, start_bits, placeholder_b, 0);
+      }
+      if (error_message.empty()) {
+        error_message = b.Next();
+      }
+      if (error_message.empty() && !Converge()) {
+        return;
+      }
+    }
+
+    while (error_message.empty()) {
+      if (a.at_end) {
+        end_pos = a.src.meta.ri;
+        return;
+      } else if (a.BitPosition() >= limit_bits) {
+        end_bits = a.BitPosition();
+        return;
+      } else if (a.dst.m_buf.meta.wi >=
+                 DecodeDeflateParallel_MaxChunkDecodedLength) {
+        end_bits = a.BitPosition();
+        capped = true;
+        return;
+      }
+      error_message = a.Next();
+      if (error_message.empty() && (converged == SIZE_MAX)) {
+        error_message = b.Next();
+        if (error_message.empty() && !Converge()) {
+          return;
+        }
+      }
+    }
+  }
+
+  // Guess finds the first plausible block start at or after start_bits (and
+  // before limit_bits, within DecodeDeflateParallel_ScanLength bytes) that
+  // decodes to a block boundary.
+  std::string Guess(const uint8_t* ptr,
+                    size_t len,
+                    uint64_t limit_bits,
+                    const std::string& placeholder_a) {
+    limit_bits = std::min(limit_bits,
+                          start_bits + (8 * DecodeDeflateParallel_ScanLength));
+    for (; start_bits < limit_bits; start_bits++) {
+      if (!DecodeDeflateParallel_IsBlockStart(ptr, len, start_bits)) {
+        continue;
+      }
+      std::string start_error = a.Start(ptr, len, start_bits, placeholder_a,
+                                        DecodeDeflateParallel_GuessLength);
+      if (!start_error.empty()) {
+        return start_error;
+      }
+      if (a.Next().empty() && !a.at_end) {
+        return "";
+      }
+    }
+    return "wuffs_aux::DecodeDeflateParallel: no block start";
+  }
+
+  // Converge checks that the two decoders are in lockstep and whether their
+  // histories are now equal, in which case the second one can stop. It sets
+  // error_message and returns false if they are not in lockstep.
+  bool Converge() {
+    size_t n = a.dst.m_buf.meta.wi;
+    if ((a.at_end != b.at_end) || (n != b.dst.m_buf.meta.wi) ||
+        (a.BitPosition() != b.BitPosition())) {
+      error_message = "wuffs_aux::DecodeDeflateParallel: inconsistent guess";
+      return false;
+    } else if ((n >= DeflateIndex_HistoryLength) &&
+               !memcmp(a.dst.m_buf.data.ptr + (n - DeflateIndex_HistoryLength),
+                       b.dst.m_buf.data.ptr + (n - DeflateIndex_HistoryLength),
+                       DeflateIndex_HistoryLength)) {
+      converged = n;
+    }
+    return true;
+  }
+
+  // Resolve resolves the bytes in the half-open range [i, j), clamped to
+  // where the two decoders had not yet converged.
+  bool Resolve(size_t i, size_t j, const std::string& window) {
+    j = std::min(j, std::min(converged, a.dst.m_buf.meta.wi));
+    return (i >= j) ||
+           DecodeDeflateParallel_Resolve(a.dst.m_buf.data.ptr,
+                                         b.dst.m_buf.data.ptr, i, j, window);
+  }
+
+  uint64_t start_bits;
+  uint64_t end_bits;
+  uint64_t end_pos;
+  size_t converged;
+  bool capped;
+  std::string error_message;
+  DecodeDeflateParallel_Decoder a;
+  DecodeDeflateParallel_Decoder b;
+};
+
+// DecodeDeflateParallel_DecodeMembers decodes, concurrently, a batch of
+// consecutive gzip members (starting at pos) that record their own length,
+// such as BGZF members. It advances pos past them. If the member at pos does
+// not record its length then it does nothing, leaving that member for the
+// speculative decoder.
+std::string  //
+DecodeDeflateParallel_DecodeMembers(
+    const uint8_t* src_ptr,
+    size_t src_len,
+    uint64_t& pos,
+    const std::function<std::string(const uint8_t* ptr, size_t len)>&
+        write_func,
+    Executor* executor,
+    size_t num_workers) {
+  // Each batch should be big enough to amortize the synchronization overhead.
+  static constexpr uint64_t max_batch_decoded_length = 0x4000000;
+  // A BGZF member's decoded length is at most 64 KiB. Larger members are left
+  // for the speculative decoder, rather than allocating their claimed length.
+  static constexpr uint32_t max_member_decoded_length = 0x1000000;
+
+  struct Member {
+    uint64_t pos;
+    uint64_t length;
+    uint64_t decoded_pos;
+    uint32_t decoded_length;
+  };
+
+  wuffs_gzip__decoder::unique_ptr scanner = wuffs_gzip__decoder::alloc();
+  if (!scanner) {
+    return DecodeDeflateParallel_OutOfMemory;
+  }
+  wuffs_base__io_buffer src = wuffs_base__ptr_u8__reader(
+      const_cast<uint8_t*>(src_ptr), src_len, true);
+
+  while (pos < src_len) {
+    // Scan a batch of members.
+    std::vector<Member> members;
+    uint64_t decoded_length = 0;
+    bool stopped = false;
+    src.meta.ri = static_cast<size_t>(pos);
+    while ((src.meta.ri < src_len) &&
+           (decoded_length < max_batch_decoded_length)) {
+      wuffs_base__status status = scanner->initialize(
+          sizeof__wuffs_gzip__decoder(), WUFFS_VERSION,
+          WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+      if (status.repr) {
+        return status.message();
+      }
+      size_t member_pos = src.meta.ri;
+      status = scanner->scan_member(&src);
+      if (status.repr ||
+          (scanner->member_decoded_length() > max_member_decoded_length)) {
+        stopped = true;
+        break;
+      }
+      members.push_back(Member{member_pos, scanner->member_length(),
+                               decoded_length,
+                               scanner->member_decoded_length()});
+      decoded_length += scanner->member_decoded_length();
+    }
+    if (members.empty()) {
+      return "";
+    }
+
+    // Decode them, as one task per contiguous group of members.
+    std::unique_ptr<uint8_t[]> dst(
+        new uint8_t[static_cast<size_t>(decoded_length)]);
+    size_t num_groups = std::min(num_workers, members.size());
+    std::vector<std::string> error_messages(num_groups);
+    executor->RunAll(num_groups, [&](size_t i) {
+      wuffs_gzip__decoder::unique_ptr dec = wuffs_gzip__decoder::alloc();
+      if (!dec) {
+        error_messages[i] = DecodeDeflateParallel_OutOfMemory;
+        return;
+      }
+      constexpr size_t workbuf_len =
+          WUFFS_GZIP__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE;
+      uint8_t workbuf_array[workbuf_len];
+      wuffs_base__slice_u8 workbuf =
+          wuffs_base__make_slice_u8(&workbuf_array[0], workbuf_len);
+      size_t j0 = (members.size() * i) / num_groups;
+      size_t j1 = (members.size() * (i + 1)) / num_groups;
+      for (size_t j = j0; j < j1; j++) {
+        const Member& m = members[j];
+        wuffs_base__status status = dec->initialize(
+            sizeof__wuffs_gzip__decoder(), WUFFS_VERSION,
+            WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+        if (!status.repr) {
+          wuffs_base__io_buffer member_dst = wuffs_base__ptr_u8__writer(
+              dst.get() + m.decoded_pos, m.decoded_length);
+          wuffs_base__io_buffer member_src = wuffs_base__ptr_u8__reader(
+              const_cast<uint8_t*>(src_ptr + m.pos),
+              static_cast<size_t>(m.length), true);
+          status = dec->transform_io(&member_dst, &member_src, workbuf);
+          if ((status.repr == wuffs_base__suspension__short_write) ||
+              (!status.repr && ((member_dst.meta.wi != m.decoded_length) ||
+                                (member_src.meta.ri != m.length)))) {
+            status.repr = wuffs_gzip__error__bad_checksum;
+          }
+        }
+        if (status.repr) {
+          error_messages[i] = status.message();
+          return;
+        }
+      }
+    });
+    for (const auto& error_message : error_messages) {
+      if (!error_message.empty()) {
+        return error_message;
+      }
+    }
+
+    if (decoded_length > 0) {
+      std::string error_message =
+          write_func(dst.get(), static_cast<size_t>(decoded_length));
+      if (!error_message.empty()) {
+        return error_message;
+      }
+    }
+    pos = members.back().pos + members.back().length;
+    if (stopped) {
+      break;
+    }
+  }
+  return "";
+}
+
+}  // namespace
+
+std::string  //
+DecodeDeflateParallel(
+    const uint8_t* src_ptr,
+    size_t src_len,
+    const std::function<std::string(const uint8_t* ptr, size_t len)>&
+        write_func,
+    Executor* executor) {
+  Executor sequential_executor;
+  if (!executor) {
+    executor = &sequential_executor;
+  }
+  size_t num_workers = std::max<size_t>(1, executor->NumWorkers());
+
+  if (src_len < 2) {
+    return DecodeDeflateParallel_UnexpectedEndOfFile;
+  }
+  uint32_t fourcc = DeflateIndex_DetectFourCC(src_ptr);
+  if (fourcc == 0) {
+    return DecodeDeflateParallel_UnsupportedCompressionFormat;
+  }
+
+  std::string placeholder_a;
+  std::string placeholder_b;
+  DecodeDeflateParallel_Placeholders(placeholder_a, placeholder_b);
+  wuffs_crc32__ieee_hasher::unique_ptr crc32 =
+      wuffs_crc32__ieee_hasher::alloc();
+  wuffs_adler32__hasher::unique_ptr adler32 = wuffs_adler32__hasher::alloc();
+  if (!crc32 || !adler32) {
+    return DecodeDeflateParallel_OutOfMemory;
+  }
+
+  uint64_t pos = 0;
+  while (true) {
+    // Decode any BGZF-like members concurrently.
+    if (fourcc == WUFFS_BASE__FOURCC__GZ) {
+      std::string error_message = DecodeDeflateParallel_DecodeMembers(
+          src_ptr, src_len, pos, write_func, executor, num_workers);
+      if (!error_message.empty()) {
+        return error_message;
+      } else if (pos >= src_len) {
+        break;
+      }
+    }
+
+    // Start a gzip member or the zlib stream.
+    sync_io::MemoryInput header_input(src_ptr + pos, src_len - pos);
+    DeflateSource header_src(header_input, pos);
+    std::string error_message = DeflateIndex_ReadHeader(header_src, fourcc);
+    if (!error_message.empty()) {
+      return DecodeDeflateParallel_RenameError(error_message);
+    }
+    wuffs_base__status status =
+        (fourcc == WUFFS_BASE__FOURCC__ZLIB)
+            ? adler32->initialize(sizeof__wuffs_adler32__hasher(),
+                                  WUFFS_VERSION, 0)
+            : crc32->initialize(sizeof__wuffs_crc32__ieee_hasher(),
+                                WUFFS_VERSION, 0);
+    if (status.repr) {
+      return status.message();
+    }
+    uint32_t checksum = (fourcc == WUFFS_BASE__FOURCC__ZLIB) ? 1 : 0;
+    uint64_t member_length = 0;
+
+    // Decode the DEFLATE data, in rounds.
+    uint64_t start_bits = header_src.Position() * 8;
+    std::string window;
+    uint64_t backoff = 1;
+    uint64_t sequential_rounds = 0;
+    while (true) {
+      uint64_t start_pos = start_bits / 8;
+      size_t n = static_cast<size_t>(std::min<uint64_t>(
+          num_workers,
+          1 + ((src_len - start_pos) / DecodeDeflateParallel_ChunkLength)));
+      if (sequential_rounds > 0) {
+        sequential_rounds--;
+        n = 1;
+      }
+      std::unique_ptr<DecodeDeflateParallel_Chunk[]> chunks(
+          new DecodeDeflateParallel_Chunk[n]);
+      chunks[0].start_bits = start_bits;
+      for (size_t i = 1; i < n; i++) {
+        chunks[i].start_bits =
+            8 * (start_pos + (i * DecodeDeflateParallel_ChunkLength));
+      }
+      executor->RunAll(n, [&](size_t i) {
+        uint64_t limit_bits =
+            8 * (start_pos + ((i + 1) * DecodeDeflateParallel_ChunkLength));
+        chunks[i].Run(src_ptr, src_len, limit_bits,
+                      (i == 0) ? &window : nullptr, placeholder_a,
+                      placeholder_b);
+      });
+      if (!chunks[0].error_message.empty()) {
+        return chunks[0].error_message;
+      }
+
+      // Confirm the guesses and resolve each chunk's final 32 KiB, which is
+      // the next chunk's window.
+      std::vector<std::string> windows;
+      windows.push_back(std::move(window));
+      size_t num_valid = 0;
+      for (; num_valid < n; num_valid++) {
+        DecodeDeflateParallel_Chunk& c = chunks[num_valid];
+        if (num_valid > 0) {
+          DecodeDeflateParallel_Chunk& prev = chunks[num_valid - 1];
+          size_t len = c.a.dst.m_buf.meta.wi;
+          if (prev.at_end() || !c.error_message.empty() ||
+              (c.start_bits != prev.end_bits) ||
+              !c.Resolve(len - std::min(len, DeflateIndex_HistoryLength), len,
+                         windows.back())) {
+            break;
+          }
+        }
+        windows.push_back(DecodeDeflateParallel_Tail(
+            windows.back(), c.a.dst.m_buf.data.ptr, c.a.dst.m_buf.meta.wi));
+      }
+      if ((num_valid < n) && !chunks[num_valid - 1].capped) {
+        sequential_rounds = backoff;
+        backoff = std::min(2 * backoff, DecodeDeflateParallel_MaxBackoff);
+      } else if (num_valid > 1) {
+        backoff = 1;
+      }
+
+      // Resolve the rest of each chunk.
+      executor->RunAll(num_valid, [&](size_t i) {
+        DecodeDeflateParallel_Chunk& c = chunks[i];
+        size_t len = c.a.dst.m_buf.meta.wi;
+        if ((i > 0) &&
+            !c.Resolve(0, len - std::min(len, DeflateIndex_HistoryLength),
+                       windows[i])) {
+          c.error_message =
+              "wuffs_aux::DecodeDeflateParallel: internal error: "
+              "inconsistent guess";
+        }
+      });
+
+      for (size_t i = 0; i < num_valid; i++) {
+        if (!chunks[i].error_message.empty()) {
+          return chunks[i].error_message;
+        }
+        const uint8_t* ptr = chunks[i].a.dst.m_buf.data.ptr;
+        size_t len = chunks[i].a.dst.m_buf.meta.wi;
+        checksum = (fourcc == WUFFS_BASE__FOURCC__ZLIB)
+                       ? adler32->update_u32(wuffs_base__make_slice_u8(
+                             const_cast<uint8_t*>(ptr), len))
+                       : crc32->update_u32(wuffs_base__make_slice_u8(
+                             const_cast<uint8_t*>(ptr), len));
+        member_length += len;
+        error_message = write_func(ptr, len);
+        if (!error_message.empty()) {
+          return error_message;
+        }
+      }
+
+      DecodeDeflateParallel_Chunk& last = chunks[num_valid - 1];
+      if (last.at_end()) {
+        pos = last.end_pos;
+        break;
+      }
+      start_bits = last.end_bits;
+      window = std::move(windows.back());
+    }
+
+    // Finish the gzip member or the zlib stream.
+    sync_io::MemoryInput footer_input(src_ptr + pos, src_len - pos);
+    DeflateSource footer_src(footer_input, pos);
+    error_message =
+        DeflateIndex_ReadFooter(footer_src, fourcc, checksum, member_length);
+    if (!error_message.empty() || (fourcc == WUFFS_BASE__FOURCC__ZLIB)) {
+      return DecodeDeflateParallel_RenameError(error_message);
+    }
+    pos = footer_src.Position();
+    if (pos >= src_len) {
+      break;
+    }
+  }
+  return "";
+}
+
+}  // namespace wuffs_aux
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__AUX__DEFLATE)
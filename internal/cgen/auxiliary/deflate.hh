@@ -0,0 +1,135 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// https://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or https://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+// ---------------- Auxiliary - Deflate
+
+namespace wuffs_aux {
+
+// DeflateCheckpoint is a position in a DEFLATE-compressed (e.g. gzip or zlib)
+// stream at which decoding can resume without decoding everything before it.
+//
+// compressed_pos is the position of the first byte that has not been fully
+// consumed, relative to the start of the gzip or zlib stream. bits holds
+// that byte's unconsumed low bits, in the format of the
+// wuffs_deflate__decoder checkpoint_bits method. It is zero if the checkpoint
+// is at a byte boundary (e.g. at the start of a gzip member).
+//
+// decompressed_pos is the corresponding position in the decoded output and
+// history holds the (up to 32 KiB of) output immediately before it.
+struct DeflateCheckpoint {
+  DeflateCheckpoint(uint64_t compressed_pos0,
+                    uint64_t decompressed_pos0,
+                    uint32_t bits0,
+                    std::string&& history0);
+
+  uint64_t compressed_pos;
+  uint64_t decompressed_pos;
+  uint32_t bits;
+  std::string history;
+};
+
+// DeflateIndex is a list of DeflateCheckpoint's, sorted by position. This is
+// also known as a "zran" index, after zlib's examples/zran.c program.
+//
+// fourcc is either WUFFS_BASE__FOURCC__GZ or WUFFS_BASE__FOURCC__ZLIB.
+struct DeflateIndex {
+  DeflateIndex();
+
+  // Find returns the last checkpoint at or before decompressed_pos, or nullptr
+  // if there is no such checkpoint.
+  const DeflateCheckpoint*  //
+  Find(uint64_t decompressed_pos) const;
+
+  // Serialize appends a binary representation of this index to dst, e.g. for
+  // the caller to save alongside the compressed file.
+  void  //
+  Serialize(std::string& dst) const;
+
+  // Parse replaces this index with the binary representation produced by
+  // Serialize. It returns an error message, or an empty string on success.
+  std::string  //
+  Parse(const uint8_t* ptr, size_t len);
+
+  uint32_t fourcc;
+  std::vector<DeflateCheckpoint> checkpoints;
+};
+
+struct BuildDeflateIndexResult {
+  BuildDeflateIndexResult(DeflateIndex&& index0,
+                          std::string&& error_message0);
+
+  DeflateIndex index;
+  std::string error_message;
+};
+
+extern const char DeflateIndex_BadArgument[];
+extern const char DeflateIndex_BadChecksum[];
+extern const char DeflateIndex_BadHeader[];
+extern const char DeflateIndex_BadIndex[];
+extern const char DeflateIndex_UnexpectedEndOfFile[];
+extern const char DeflateIndex_UnsupportedCompressionFormat[];
+
+// BuildDeflateIndex decodes all of input, a gzip or zlib stream (auto-
+// detected), recording a checkpoint at its start and then roughly every
+// spacing bytes of decompressed output. Concatenated (multi-member) gzip
+// streams are supported. Checksums are verified.
+//
+// Each checkpoint holds up to 32 KiB of history, so spacing should be large
+// (e.g. 1 MiB or more) relative to that. A zero spacing means 1 MiB.
+BuildDeflateIndexResult  //
+BuildDeflateIndex(sync_io::Input& input, uint64_t spacing = 0);
+
+// DecodeDeflateRange appends to dst the decompressed bytes in the half-open
+// range [pos, pos + length), stopping early at the end of the stream.
+//
+// input must yield the compressed stream starting at
+// checkpoint.compressed_pos, e.g. after an fseek on the compressed file, and
+// checkpoint (typically found via index.Find(pos)) must be one of index's
+// checkpoints. Checksums are not verified, as decoding does not start at the
+// beginning of the stream.
+std::string  //
+DecodeDeflateRange(std::string& dst,
+                   const DeflateIndex& index,
+                   const DeflateCheckpoint& checkpoint,
+                   sync_io::Input& input,
+                   uint64_t pos,
+                   uint64_t length);
+
+extern const char DecodeDeflateParallel_BadChecksum[];
+extern const char DecodeDeflateParallel_BadHeader[];
+extern const char DecodeDeflateParallel_OutOfMemory[];
+extern const char DecodeDeflateParallel_UnexpectedEndOfFile[];
+extern const char DecodeDeflateParallel_UnsupportedCompressionFormat[];
+
+// DecodeDeflateParallel decodes a gzip or zlib stream (auto-detected) held
+// in memory (e.g. a memory-mapped file), passing the decompressed bytes, in
+// order, to write_func. Decoding stops early if write_func returns a non-
+// empty error message. Concatenated (multi-member) gzip streams are
+// supported. Checksums are verified.
+//
+// Gzip members that record their own length (e.g. BGZF members, see the
+// wuffs_gzip__decoder scan_member method) are decoded concurrently, as
+// executor tasks when executor is non-nullptr, and their CRC-32 checksums
+// are verified per member. Even a single DEFLATE stream is split into pieces
+// that are decoded concurrently, by guessing where DEFLATE blocks start, in
+// the style of pugz. Wrong guesses are detected and discarded. Streams with
+// few guessable block starts (e.g. those with only fixed Huffman or stored
+// blocks) back off to sequential decoding, at a small cost over decoding
+// without an executor. Each piece buffers at most 32 MiB (plus one DEFLATE
+// block) of decompressed bytes, however compressible the input is.
+std::string  //
+DecodeDeflateParallel(
+    const uint8_t* src_ptr,
+    size_t src_len,
+    const std::function<std::string(const uint8_t* ptr, size_t len)>&
+        write_func,
+    Executor* executor = nullptr);
+
+}  // namespace wuffs_aux
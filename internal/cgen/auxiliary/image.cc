@@ -13,6 +13,7 @@
 #if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__IMAGE)
 
 #include <utility>
+#include <vector>
 
 namespace wuffs_aux {
 
@@ -217,6 +218,11 @@ const char DecodeImage_UnsupportedPixelConfiguration[] =  //
 const char DecodeImage_UnsupportedPixelFormat[] =  //
     "wuffs_aux::DecodeImage: unsupported pixel format";
 
+const char ConvertPixelBuffer_UnsupportedPixelConfiguration[] =  //
+    "wuffs_aux::ConvertPixelBuffer: unsupported pixel configuration";
+const char ConvertPixelBuffer_UnsupportedPixelFormat[] =  //
+    "wuffs_aux::ConvertPixelBuffer: unsupported pixel format";
+
 DecodeImageArgQuirks::DecodeImageArgQuirks(const QuirkKeyValuePair* ptr0,
                                            const size_t len0)
     : ptr(ptr0), len(len0) {}
@@ -268,6 +274,14 @@ DecodeImageArgMaxInclMetadataLength::DefaultValue() {
   return DecodeImageArgMaxInclMetadataLength(16777215);
 }
 
+DecodeImageArgExecutor::DecodeImageArgExecutor(Executor* repr0)
+    : repr(repr0) {}
+
+DecodeImageArgExecutor  //
+DecodeImageArgExecutor::DefaultValue() {
+  return DecodeImageArgExecutor(nullptr);
+}
+
 // --------
 
 namespace {
@@ -316,6 +330,308 @@ DecodeImageHandleMetadata(wuffs_base__image_decoder::unique_ptr& image_decoder,
                                       DIHM1, static_cast<void*>(&callbacks));
 }
 
+// DecodeImageFrameInBands decodes the frame's pixels in horizontal bands, one
+// image decoder per band, running those decoders as executor tasks. It returns
+// false, having decoded nothing, if that's not applicable (e.g. the image
+// decoder doesn't support decoding bands). Otherwise, it returns true and sets
+// message to the first (in band order) error, if any. If the image can't be
+// split into bands, the first band is the whole image, decoded on this thread.
+bool  //
+DecodeImageFrameInBands(std::string& message,
+                        wuffs_base__image_decoder::unique_ptr& image_decoder,
+                        DecodeImageCallbacks& callbacks,
+                        wuffs_base__io_buffer& io_buf,
+                        const QuirkKeyValuePair* quirks_ptr,
+                        const size_t quirks_len,
+                        uint32_t fourcc,
+                        uint64_t start_pos,
+                        wuffs_base__pixel_buffer& pixel_buffer,
+                        wuffs_base__pixel_blend pixel_blend,
+                        wuffs_base__slice_u8 workbuf,
+                        Executor* executor) {
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__JPEG)
+  size_t n = executor ? executor->NumWorkers() : 0;
+  if ((n <= 1) || (fourcc != WUFFS_BASE__FOURCC__JPEG) ||
+      !io_buf.meta.closed || (io_buf.meta.pos > start_pos) ||
+      (io_buf.writer_position() < start_pos)) {
+    return false;
+  }
+  n = (n < 0xFFFF) ? n : 0xFFFF;
+  if (image_decoder
+          ->set_quirk(WUFFS_JPEG__QUIRK_DECODE_BAND, ((uint64_t)n) << 32)
+          .repr) {
+    return false;
+  }
+  // There's at most one (non-empty) band per MCU row. The decoder knows how
+  // many MCU rows there are, having already decoded the image config.
+  n = (size_t)wuffs_base__u64__min(
+      n, image_decoder->get_quirk(WUFFS_JPEG__QUIRK_DECODE_BAND) >> 32);
+  if (n <= 1) {
+    image_decoder->set_quirk(WUFFS_JPEG__QUIRK_DECODE_BAND, 0);
+    return false;
+  }
+
+  // The first band's decoder suspends, before decoding any pixels, if the
+  // image can be split into bands. Otherwise, it decodes the whole image and
+  // there's no need for any other decoders (or their work buffers).
+  wuffs_base__status status = image_decoder->decode_frame(
+      &pixel_buffer, &io_buf, pixel_blend, workbuf, nullptr);
+  if (status.repr != wuffs_jpeg__suspension__splittable_into_bands) {
+    if (status.repr == wuffs_base__suspension__short_read) {
+      message = DecodeImage_UnexpectedEndOfFile;
+    } else if (status.repr != nullptr) {
+      message = status.message();
+    }
+    return true;
+  }
+
+  // The other bands' decoders each read the same input bytes (starting from
+  // the start of the image) from their own io_buffer. Set them up (and
+  // allocate their work buffers, which only cover their bands) on this
+  // thread.
+  wuffs_base__slice_u8 input = wuffs_base__make_slice_u8(
+      io_buf.data.ptr + (start_pos - io_buf.meta.pos),
+      (size_t)(io_buf.writer_position() - start_pos));
+  std::vector<wuffs_base__image_decoder::unique_ptr> decoders;
+  std::vector<MemOwner> workbuf_mem_owners;
+  std::vector<wuffs_base__io_buffer> io_bufs(n);
+  std::vector<wuffs_base__slice_u8> workbufs(n);
+  std::vector<wuffs_base__status> statuses(n);
+  decoders.emplace_back(nullptr);
+  workbuf_mem_owners.emplace_back(nullptr, &free);
+  for (size_t i = 1; i < n; i++) {
+    decoders.push_back(callbacks.SelectDecoder(fourcc, input, true));
+    wuffs_base__image_decoder* dec = decoders.back().get();
+    if (!dec) {
+      message = DecodeImage_UnsupportedImageFormat;
+      return true;
+    }
+    for (size_t j = 0; j < quirks_len; j++) {
+      dec->set_quirk(quirks_ptr[j].first, quirks_ptr[j].second);
+    }
+    status = dec->set_quirk(WUFFS_JPEG__QUIRK_DECODE_BAND,
+                            (((uint64_t)n) << 32) | i);
+    io_bufs[i] = wuffs_base__ptr_u8__reader(input.ptr, input.len, true);
+    io_bufs[i].meta.pos = start_pos;
+    if (status.repr == nullptr) {
+      status = dec->decode_image_config(nullptr, &io_bufs[i]);
+    }
+    if (status.repr == nullptr) {
+      status = dec->decode_frame_config(nullptr, &io_bufs[i]);
+    }
+    if (status.repr != nullptr) {
+      message = (status.repr == wuffs_base__suspension__short_read)
+                    ? DecodeImage_UnexpectedEndOfFile
+                    : status.message();
+      return true;
+    }
+
+    wuffs_base__range_ii_u64 workbuf_len = dec->workbuf_len();
+    DecodeImageCallbacks::AllocWorkbufResult alloc_workbuf_result =
+        callbacks.AllocWorkbuf(workbuf_len, true);
+    if (!alloc_workbuf_result.error_message.empty()) {
+      message = std::move(alloc_workbuf_result.error_message);
+      return true;
+    } else if (alloc_workbuf_result.workbuf.len < workbuf_len.min_incl) {
+      message = DecodeImage_BufferIsTooShort;
+      return true;
+    }
+    workbuf_mem_owners.push_back(std::move(alloc_workbuf_result.mem_owner));
+    workbufs[i] = alloc_workbuf_result.workbuf;
+  }
+
+  // Decode the bands, resuming the first band's decoder. The 0'th band uses
+  // the original decoder, io_buf and work buffer. All of the input is already
+  // in the io_buffers, so the decoders should not suspend.
+  executor->RunAll(n, [&](size_t i) {
+    if (i == 0) {
+      statuses[0] = image_decoder->decode_frame(&pixel_buffer, &io_buf,
+                                                pixel_blend, workbuf, nullptr);
+    } else {
+      statuses[i] = decoders[i]->decode_frame(
+          &pixel_buffer, &io_bufs[i], pixel_blend, workbufs[i], nullptr);
+    }
+  });
+
+  for (size_t i = 0; i < n; i++) {
+    if (statuses[i].repr == wuffs_base__suspension__short_read) {
+      message = DecodeImage_UnexpectedEndOfFile;
+      break;
+    } else if (statuses[i].repr != nullptr) {
+      message = statuses[i].message();
+      break;
+    }
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__PNG)
+// DecodeImageAsPNGDecoder returns image_decoder as Wuffs' PNG decoder, or
+// nullptr if it is some other image decoder (e.g. one returned by a custom
+// SelectDecoder callback), even if that other decoder accepts Wuffs' PNG
+// quirks.
+wuffs_png__decoder*  //
+DecodeImageAsPNGDecoder(wuffs_base__image_decoder* image_decoder) {
+  if (!image_decoder ||
+      (image_decoder->private_impl.first_vtable.function_pointers !=
+       &wuffs_png__decoder__func_ptrs_for__wuffs_base__image_decoder)) {
+    return nullptr;
+  }
+  return static_cast<wuffs_png__decoder*>(static_cast<void*>(image_decoder));
+}
+#endif
+
+// DecodeImageFramePipelined decodes a PNG frame's pixels in two stages, run
+// as pairs of executor tasks: one inflates the filtered rows into the work
+// buffer and the other unfilters and swizzles earlier rows, starting before
+// the inflation finishes (see WUFFS_PNG__QUIRK_DEFER_FILTER_AND_SWIZZLE). It
+// returns false, having decoded nothing, if that's not applicable (e.g. the
+// image decoder isn't Wuffs' PNG decoder). Otherwise, it returns true and
+// sets message to the first error, if any.
+//
+// The two stages use two separate decoders (selected by callbacks and
+// configured like image_decoder), as a decoder's methods must not be called
+// concurrently. The original image_decoder is left positioned at the start of
+// the frame, which decode_frame_config will skip over.
+bool  //
+DecodeImageFramePipelined(std::string& message,
+                          wuffs_base__image_decoder::unique_ptr& image_decoder,
+                          DecodeImageCallbacks& callbacks,
+                          wuffs_base__io_buffer& io_buf,
+                          const QuirkKeyValuePair* quirks_ptr,
+                          const size_t quirks_len,
+                          uint32_t fourcc,
+                          uint64_t start_pos,
+                          wuffs_base__pixel_buffer& pixel_buffer,
+                          wuffs_base__pixel_blend pixel_blend,
+                          wuffs_base__slice_u8 workbuf,
+                          Executor* executor) {
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__PNG)
+  // Small images aren't worth the synchronization overhead.
+  static constexpr size_t min_workbuf_len = 0x40000;
+
+  size_t n = executor ? executor->NumWorkers() : 0;
+  if ((n <= 1) || (fourcc != WUFFS_BASE__FOURCC__PNG) ||
+      (workbuf.len < min_workbuf_len) || !io_buf.meta.closed ||
+      (io_buf.meta.pos > start_pos) ||
+      (io_buf.writer_position() < start_pos) ||
+      !DecodeImageAsPNGDecoder(image_decoder.get())) {
+    return false;
+  }
+  uint64_t ignore_checksum =
+      image_decoder->get_quirk(WUFFS_BASE__QUIRK_IGNORE_CHECKSUM);
+
+  // The "inflater" (index 0) and "filterer" (index 1) decoders each read the
+  // same input bytes (starting from the start of the image) from their own
+  // io_buffer. The filterer runs decode_frame up to its first "$filtered rows
+  // available" suspension, which prepares it for filter_and_swizzle_rows.
+  wuffs_base__slice_u8 input = wuffs_base__make_slice_u8(
+      io_buf.data.ptr + (start_pos - io_buf.meta.pos),
+      (size_t)(io_buf.writer_position() - start_pos));
+  wuffs_base__image_decoder::unique_ptr decoder_owners[2] = {
+      callbacks.SelectDecoder(fourcc, input, true),
+      callbacks.SelectDecoder(fourcc, input, true),
+  };
+  wuffs_png__decoder* decoders[2] = {
+      DecodeImageAsPNGDecoder(decoder_owners[0].get()),
+      DecodeImageAsPNGDecoder(decoder_owners[1].get()),
+  };
+  wuffs_base__io_buffer io_bufs[2];
+  for (int i = 0; i < 2; i++) {
+    wuffs_png__decoder* dec = decoders[i];
+    if (!dec) {
+      return false;
+    }
+    for (size_t j = 0; j < quirks_len; j++) {
+      dec->set_quirk(quirks_ptr[j].first, quirks_ptr[j].second);
+    }
+    dec->set_quirk(WUFFS_BASE__QUIRK_IGNORE_CHECKSUM, ignore_checksum);
+    dec->set_quirk(WUFFS_PNG__QUIRK_DEFER_FILTER_AND_SWIZZLE, 1);
+    io_bufs[i] = wuffs_base__ptr_u8__reader(input.ptr, input.len, true);
+    io_bufs[i].meta.pos = start_pos;
+    wuffs_base__status status = dec->decode_image_config(nullptr, &io_bufs[i]);
+    if (status.repr == nullptr) {
+      status = dec->decode_frame_config(nullptr, &io_bufs[i]);
+    }
+    if (status.repr != nullptr) {
+      return false;
+    }
+  }
+
+  // Interlaced frames aren't deferred. If so, the inflater decodes the whole
+  // frame in this first decode_frame call.
+  wuffs_base__status status = decoders[0]->decode_frame(
+      &pixel_buffer, &io_bufs[0], pixel_blend, workbuf, nullptr);
+  if (status.repr == wuffs_png__suspension__filtered_rows_available) {
+    status = decoders[1]->decode_frame(&pixel_buffer, &io_bufs[1],
+                                       pixel_blend, workbuf, nullptr);
+  }
+  if (status.repr != wuffs_png__suspension__filtered_rows_available) {
+    if (status.repr == wuffs_base__suspension__short_read) {
+      message = DecodeImage_UnexpectedEndOfFile;
+    } else if (status.repr != nullptr) {
+      message = status.message();
+    }
+    return true;
+  }
+
+  // Run the two stages in lockstep. In each step, one task inflates more rows
+  // while the other unfilters and swizzles the rows that were inflated by
+  // the end of the previous step. The two tasks touch disjoint rows and never
+  // wait for each other, so the executor may run them in either order,
+  // concurrently or not. Each step inflates up to (steps_per_run_all * 64
+  // KiB) or so, amortizing the RunAll overhead.
+  static constexpr int steps_per_run_all = 4;
+  wuffs_base__status statuses[2] = {
+      wuffs_base__make_status(nullptr),
+      wuffs_base__make_status(nullptr),
+  };
+  bool inflated = false;
+  uint32_t y = 0;
+  while (true) {
+    uint32_t ready = decoders[0]->num_deferred_rows();
+    if (inflated && (y >= ready)) {
+      break;
+    }
+    executor->RunAll(2, [&](size_t i) {
+      if (i == 0) {
+        for (int k = 0; !inflated && (k < steps_per_run_all); k++) {
+          wuffs_base__status s = decoders[0]->decode_frame(
+              &pixel_buffer, &io_bufs[0], pixel_blend, workbuf, nullptr);
+          if (s.repr != wuffs_png__suspension__filtered_rows_available) {
+            statuses[0] = s;
+            inflated = true;
+          }
+        }
+      } else if (ready > y) {
+        statuses[1] = decoders[1]->filter_and_swizzle_rows(&pixel_buffer,
+                                                           workbuf, y, ready);
+      }
+    });
+    if (statuses[1].repr != nullptr) {
+      break;
+    }
+    y = ready;
+  }
+
+  for (int i = 0; i < 2; i++) {
+    if (statuses[i].repr == wuffs_base__suspension__short_read) {
+      message = DecodeImage_UnexpectedEndOfFile;
+      break;
+    } else if (statuses[i].repr != nullptr) {
+      message = statuses[i].message();
+      break;
+    }
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
 DecodeImageResult  //
 DecodeImage0(wuffs_base__image_decoder::unique_ptr& image_decoder,
              DecodeImageCallbacks& callbacks,
@@ -327,7 +643,8 @@ DecodeImage0(wuffs_base__image_decoder::unique_ptr& image_decoder,
              wuffs_base__pixel_blend pixel_blend,
              wuffs_base__color_u32_argb_premul background_color,
              uint32_t max_incl_dimension,
-             uint64_t max_incl_metadata_length) {
+             uint64_t max_incl_metadata_length,
+             Executor* executor) {
   // Check args.
   switch (pixel_blend) {
     case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -559,23 +876,33 @@ redirect:
       frame_config.overwrite_instead_of_blend()) {
     pixel_blend = WUFFS_BASE__PIXEL_BLEND__SRC;
   }
-  while (true) {
-    wuffs_base__status id_df_status =
-        image_decoder->decode_frame(&pixel_buffer, &io_buf, pixel_blend,
-                                    alloc_workbuf_result.workbuf, nullptr);
-    if (id_df_status.repr == nullptr) {
-      break;
-    } else if (id_df_status.repr != wuffs_base__suspension__short_read) {
-      message = id_df_status.message();
-      break;
-    } else if (io_buf.meta.closed) {
-      message = DecodeImage_UnexpectedEndOfFile;
-      break;
-    } else {
-      std::string error_message = input.CopyIn(&io_buf);
-      if (!error_message.empty()) {
-        message = std::move(error_message);
+  if (redirected ||
+      (!DecodeImageFrameInBands(message, image_decoder, callbacks, io_buf,
+                                quirks_ptr, quirks_len, (uint32_t)fourcc,
+                                start_pos, pixel_buffer, pixel_blend,
+                                alloc_workbuf_result.workbuf, executor) &&
+       !DecodeImageFramePipelined(message, image_decoder, callbacks, io_buf,
+                                  quirks_ptr, quirks_len, (uint32_t)fourcc,
+                                  start_pos, pixel_buffer, pixel_blend,
+                                  alloc_workbuf_result.workbuf, executor))) {
+    while (true) {
+      wuffs_base__status id_df_status =
+          image_decoder->decode_frame(&pixel_buffer, &io_buf, pixel_blend,
+                                      alloc_workbuf_result.workbuf, nullptr);
+      if (id_df_status.repr == nullptr) {
+        break;
+      } else if (id_df_status.repr != wuffs_base__suspension__short_read) {
+        message = id_df_status.message();
         break;
+      } else if (io_buf.meta.closed) {
+        message = DecodeImage_UnexpectedEndOfFile;
+        break;
+      } else {
+        std::string error_message = input.CopyIn(&io_buf);
+        if (!error_message.empty()) {
+          message = std::move(error_message);
+          break;
+        }
       }
     }
   }
@@ -622,7 +949,8 @@ DecodeImage(DecodeImageCallbacks& callbacks,
             DecodeImageArgPixelBlend pixel_blend,
             DecodeImageArgBackgroundColor background_color,
             DecodeImageArgMaxInclDimension max_incl_dimension,
-            DecodeImageArgMaxInclMetadataLength max_incl_metadata_length) {
+            DecodeImageArgMaxInclMetadataLength max_incl_metadata_length,
+            DecodeImageArgExecutor executor) {
   wuffs_base__io_buffer* io_buf = input.BringsItsOwnIOBuffer();
   wuffs_base__io_buffer fallback_io_buf = wuffs_base__empty_io_buffer();
   std::unique_ptr<uint8_t[]> fallback_io_array(nullptr);
@@ -637,11 +965,69 @@ DecodeImage(DecodeImageCallbacks& callbacks,
   DecodeImageResult result = DecodeImage0(
       image_decoder, callbacks, input, *io_buf, quirks.ptr, quirks.len,
       flags.repr, pixel_blend.repr, background_color.repr,
-      max_incl_dimension.repr, max_incl_metadata_length.repr);
+      max_incl_dimension.repr, max_incl_metadata_length.repr, executor.repr);
   callbacks.Done(result, input, *io_buf, std::move(image_decoder));
   return result;
 }
 
+std::string  //
+ConvertPixelBuffer(wuffs_base__pixel_buffer& dst,
+                   wuffs_base__pixel_buffer& src,
+                   wuffs_base__pixel_blend pixel_blend,
+                   Executor* executor) {
+  // Each band should be big enough to amortize the synchronization overhead.
+  static constexpr uint64_t min_band_len = 0x40000;
+
+  wuffs_base__pixel_format dst_pixfmt = dst.pixel_format();
+  wuffs_base__pixel_format src_pixfmt = src.pixel_format();
+  uint32_t dst_bits_per_pixel = dst_pixfmt.bits_per_pixel();
+  uint32_t src_bits_per_pixel = src_pixfmt.bits_per_pixel();
+  if (!dst_pixfmt.is_interleaved() || !src_pixfmt.is_interleaved() ||
+      (dst_bits_per_pixel == 0) || ((dst_bits_per_pixel & 7) != 0) ||
+      (src_bits_per_pixel == 0) || ((src_bits_per_pixel & 7) != 0)) {
+    return ConvertPixelBuffer_UnsupportedPixelFormat;
+  }
+
+  wuffs_base__pixel_swizzler swizzler;
+  wuffs_base__status status = swizzler.prepare(
+      dst_pixfmt, dst.palette(), src_pixfmt, src.palette(), pixel_blend);
+  if (status.repr) {
+    return status.message();
+  }
+
+  uint64_t width = wuffs_base__u64__min(dst.pixcfg.width(), src.pixcfg.width());
+  uint64_t height =
+      wuffs_base__u64__min(dst.pixcfg.height(), src.pixcfg.height());
+  uint64_t dst_row_len = width * (dst_bits_per_pixel / 8);
+  uint64_t src_row_len = width * (src_bits_per_pixel / 8);
+  wuffs_base__table_u8 dst_tab = wuffs_base__table_u8__subtable_ij(
+      dst.plane(0), 0, 0, dst_row_len, height);
+  wuffs_base__table_u8 src_tab = wuffs_base__table_u8__subtable_ij(
+      src.plane(0), 0, 0, src_row_len, height);
+  if ((dst_tab.height != height) || (src_tab.height != height)) {
+    return ConvertPixelBuffer_UnsupportedPixelConfiguration;
+  }
+  wuffs_base__slice_u8 dst_palette = dst.palette();
+
+  uint64_t n = executor ? executor->NumWorkers() : 1;
+  n = wuffs_base__u64__min(n, (dst_row_len * height) / min_band_len);
+  n = wuffs_base__u64__min(n, height);
+  if (n <= 1) {
+    swizzler.swizzle_interleaved_from_table(dst_tab, dst_palette, src_tab);
+    return "";
+  }
+
+  executor->RunAll((size_t)n, [&](size_t i) {
+    uint64_t y0 = (height * i) / n;
+    uint64_t y1 = (height * (i + 1)) / n;
+    swizzler.swizzle_interleaved_from_table(
+        wuffs_base__table_u8__subtable_ij(dst_tab, 0, y0, dst_row_len, y1),
+        dst_palette,
+        wuffs_base__table_u8__subtable_ij(src_tab, 0, y0, src_row_len, y1));
+  });
+  return "";
+}
+
 }  // namespace wuffs_aux
 
 #endif  // !defined(WUFFS_CONFIG__MODULES) ||
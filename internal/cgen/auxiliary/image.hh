@@ -76,7 +76,9 @@ class DecodeImageCallbacks {
   //
   // SelectDecoder might be called more than once, since some image file
   // formats can wrap others. For example, a nominal BMP file can actually
-  // contain a JPEG or a PNG.
+  // contain a JPEG or a PNG. It is also called once per extra decoder when
+  // DecodeImage decodes an image in multiple bands or pipeline stages (see
+  // DecodeImageArgExecutor).
   //
   // The default SelectDecoder accepts the FOURCC codes listed below. For
   // modular builds (i.e. when #define'ing WUFFS_CONFIG__MODULES), acceptance
@@ -301,6 +303,16 @@ struct DecodeImageArgMaxInclMetadataLength {
   uint64_t repr;
 };
 
+// DecodeImageArgExecutor wraps an optional argument to DecodeImage.
+struct DecodeImageArgExecutor {
+  explicit DecodeImageArgExecutor(Executor* repr0);
+
+  // DefaultValue returns nullptr, meaning to decode on the calling thread.
+  static DecodeImageArgExecutor DefaultValue();
+
+  Executor* repr;
+};
+
 // DecodeImage decodes the image data in input. A variety of image file formats
 // can be decoded, depending on what callbacks.SelectDecoder returns.
 //
@@ -345,6 +357,27 @@ struct DecodeImageArgMaxInclMetadataLength {
 // Decoding fails (with DecodeImage_MaxInclDimensionExceeded) if the image's
 // width or height is greater than max_incl_dimension or if any opted-in (via
 // flags bits) metadata is longer than max_incl_metadata_length.
+//
+// If the executor is non-nullptr and its NumWorkers is more than one then
+// DecodeImage might split the image into horizontal bands, decoded by separate
+// image decoders (each with its own work buffer) running as executor tasks and
+// writing to disjoint rows of the same pixel buffer. This currently only
+// applies to JPEG images (see WUFFS_JPEG__QUIRK_DECODE_BAND) when the input's
+// IOBuffer holds the entire file (e.g. for a sync_io::MemoryInput). The extra
+// decoders and work buffers are created (via callbacks.SelectDecoder and
+// callbacks.AllocWorkbuf) on the calling thread, before any tasks run, but
+// only after the first band's decoder has found that the image can be split
+// (it needs restart markers and a single sequential scan). Each extra work
+// buffer only covers its band's rows, plus a margin.
+//
+// Under the same conditions, large non-interlaced PNG images are instead
+// decoded as a two-stage pipeline (see
+// WUFFS_PNG__QUIRK_DEFER_FILTER_AND_SWIZZLE), sharing the one work buffer.
+// Each executor->RunAll call has two independent tasks: one inflates more
+// rows while the other unfilters and swizzles rows inflated earlier. This
+// only applies when callbacks.SelectDecoder returns Wuffs' standard PNG
+// decoder, both for the image and for the two extra (per-stage) decoders.
+// Otherwise, the frame is decoded without the pipeline.
 DecodeImageResult  //
 DecodeImage(DecodeImageCallbacks& callbacks,
             sync_io::Input& input,
@@ -357,6 +390,33 @@ DecodeImage(DecodeImageCallbacks& callbacks,
             DecodeImageArgMaxInclDimension max_incl_dimension =
                 DecodeImageArgMaxInclDimension::DefaultValue(),
             DecodeImageArgMaxInclMetadataLength max_incl_metadata_length =
-                DecodeImageArgMaxInclMetadataLength::DefaultValue());
+                DecodeImageArgMaxInclMetadataLength::DefaultValue(),
+            DecodeImageArgExecutor executor =
+                DecodeImageArgExecutor::DefaultValue());
+
+extern const char ConvertPixelBuffer_UnsupportedPixelConfiguration[];
+extern const char ConvertPixelBuffer_UnsupportedPixelFormat[];
+
+// ConvertPixelBuffer converts src's pixels to dst's pixel format, compositing
+// them (per the pixel_blend) onto the top-left part of dst that both pixel
+// buffers' dimensions cover. It returns an empty string on success or an
+// error message on failure, such as when either pixel format is planar or is
+// not a whole number of bytes per pixel, or the conversion is unsupported.
+//
+// This is useful when an image is decoded to its natural pixel format (e.g.
+// for caching) and later converted to a display format. For a very large
+// frame, that conversion can dominate a single core.
+//
+// If the executor is non-nullptr and its NumWorkers is more than one then the
+// rectangle is split into horizontal bands, converted concurrently as
+// independent executor tasks that write to disjoint rows of dst. The one
+// wuffs_base__pixel_swizzler is prepared on the calling thread and then only
+// read by the tasks. Small rectangles are converted on the calling thread.
+std::string  //
+ConvertPixelBuffer(wuffs_base__pixel_buffer& dst,
+                   wuffs_base__pixel_buffer& src,
+                   wuffs_base__pixel_blend pixel_blend =
+                       WUFFS_BASE__PIXEL_BLEND__SRC,
+                   Executor* executor = nullptr);
 
 }  // namespace wuffs_aux
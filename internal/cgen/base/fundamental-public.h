@@ -107,6 +107,11 @@
 #if defined(__ARM_NEON)
 #include <arm_neon.h>
 #define WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON
+// Some NEON intrinsics (e.g. vtrn1q_u32) are only available on AArch64, not
+// on 32-bit ARM. Code that uses them is guarded by this macro instead.
+#if defined(__aarch64__)
+#define WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON_A64
+#endif  // defined(__aarch64__)
 #endif  // defined(__ARM_NEON)
 #endif  // defined(__ARM_FEATURE_UNALIGNED) etc
 
@@ -27,6 +27,21 @@ wuffs_base__pixel_swizzler__swizzle_interleaved_from_reader(
     const uint8_t** ptr_iop_r,
     const uint8_t* io2_r);
 
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_rows_from_reader(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__table_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    const uint8_t** ptr_iop_r,
+    const uint8_t* io2_r);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_rows_from_slice(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__table_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src);
+
 WUFFS_BASE__MAYBE_STATIC uint64_t  //
 wuffs_base__pixel_swizzler__swizzle_interleaved_transparent_black(
     const wuffs_base__pixel_swizzler* p,
@@ -43,6 +58,7 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
     uint32_t x_max_excl,
     uint32_t y_min_incl,
     uint32_t y_max_excl,
+    uint32_t src_y_min_incl,
     wuffs_base__slice_u8 src0,
     wuffs_base__slice_u8 src1,
     wuffs_base__slice_u8 src2,
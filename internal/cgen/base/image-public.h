@@ -148,7 +148,8 @@ wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(
 }
 
 // wuffs_base__color_u32_argb_premul__as__color_u32_argb_nonpremul converts
-// from premultiplied alpha to non-premultiplied alpha.
+// from premultiplied alpha to non-premultiplied alpha. Invalid premultiplied
+// colors (a color channel greater than alpha) saturate to 0xFF.
 static inline uint32_t  //
 wuffs_base__color_u32_argb_premul__as__color_u32_argb_nonpremul(
     wuffs_base__color_u32_argb_premul c) {
@@ -160,11 +161,11 @@ wuffs_base__color_u32_argb_premul__as__color_u32_argb_nonpremul(
   }
   uint32_t a16 = a * 0x101;
 
-  uint32_t r = 0xFF & (c >> 16);
+  uint32_t r = wuffs_base__u32__min(a, 0xFF & (c >> 16));
   r = ((r * (0x101 * 0xFFFF)) / a16) >> 8;
-  uint32_t g = 0xFF & (c >> 8);
+  uint32_t g = wuffs_base__u32__min(a, 0xFF & (c >> 8));
   g = ((g * (0x101 * 0xFFFF)) / a16) >> 8;
-  uint32_t b = 0xFF & (c >> 0);
+  uint32_t b = wuffs_base__u32__min(a, 0xFF & (c >> 0));
   b = ((b * (0x101 * 0xFFFF)) / a16) >> 8;
 
   return (a << 24) | (r << 16) | (g << 8) | (b << 0);
@@ -1333,6 +1334,9 @@ typedef struct wuffs_base__pixel_buffer__struct {
   inline wuffs_base__status set_from_slice(
       const wuffs_base__pixel_config* pixcfg,
       wuffs_base__slice_u8 pixbuf_memory);
+  inline wuffs_base__status set_planar(const wuffs_base__pixel_config* pixcfg,
+                                       const wuffs_base__table_u8* planes_ptr,
+                                       size_t planes_len);
   inline wuffs_base__slice_u8 palette();
   inline wuffs_base__slice_u8 palette_or_else(wuffs_base__slice_u8 fallback);
   inline wuffs_base__pixel_format pixel_format() const;
@@ -1480,6 +1484,69 @@ wuffs_base__pixel_buffer__set_from_slice(wuffs_base__pixel_buffer* pb,
   return wuffs_base__make_status(NULL);
 }
 
+// wuffs_base__pixel_buffer__set_planar sets up a pixel buffer for a planar
+// pixel format (such as WUFFS_BASE__PIXEL_FORMAT__YCBCR), with one 8 bits per
+// sample table per plane. planes_len must equal the pixel format's number of
+// planes and each table must be large enough for its plane's samples, per the
+// pixcfg's pixel subsampling. See
+// https://github.com/google/wuffs/blob/main/doc/note/pixel-subsampling.md
+static inline wuffs_base__status  //
+wuffs_base__pixel_buffer__set_planar(wuffs_base__pixel_buffer* pb,
+                                     const wuffs_base__pixel_config* pixcfg,
+                                     const wuffs_base__table_u8* planes_ptr,
+                                     size_t planes_len) {
+  if (!pb) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  memset(pb, 0, sizeof(*pb));
+  if (!pixcfg || !planes_ptr ||
+      !wuffs_base__pixel_format__is_planar(&pixcfg->private_impl.pixfmt) ||
+      wuffs_base__pixel_format__is_indexed(&pixcfg->private_impl.pixfmt)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  uint32_t num_planes =
+      wuffs_base__pixel_format__num_planes(&pixcfg->private_impl.pixfmt);
+  if (planes_len != num_planes) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+
+  uint32_t width = pixcfg->private_impl.width;
+  uint32_t height = pixcfg->private_impl.height;
+  uint32_t p;
+  for (p = 0; p < num_planes; p++) {
+    // Each planar channel's 4-bit encoding must be 8 bits per sample.
+    if (((pixcfg->private_impl.pixfmt.repr >> (4 * p)) & 0x0F) != 0x08) {
+      // TODO: support other sample depths, e.g. 16 bits per sample?
+      return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+    }
+    const wuffs_base__pixel_subsampling* pixsub = &pixcfg->private_impl.pixsub;
+    uint64_t plane_width =
+        (width == 0) ? 0
+                     : (((uint64_t)(width - 1) +
+                         wuffs_base__pixel_subsampling__bias_x(pixsub, p)) /
+                        wuffs_base__pixel_subsampling__denominator_x(pixsub,
+                                                                     p)) +
+                           1;
+    uint64_t plane_height =
+        (height == 0) ? 0
+                      : (((uint64_t)(height - 1) +
+                          wuffs_base__pixel_subsampling__bias_y(pixsub, p)) /
+                         wuffs_base__pixel_subsampling__denominator_y(pixsub,
+                                                                      p)) +
+                            1;
+    const wuffs_base__table_u8* tab = &planes_ptr[p];
+    if ((plane_width > tab->width) || (plane_height > tab->height)) {
+      return wuffs_base__make_status(wuffs_base__error__bad_argument);
+    }
+  }
+
+  pb->pixcfg = *pixcfg;
+  for (p = 0; p < num_planes; p++) {
+    pb->private_impl.planes[p] = planes_ptr[p];
+  }
+  return wuffs_base__make_status(NULL);
+}
+
 // wuffs_base__pixel_buffer__palette returns the palette color data. If
 // non-empty, it will have length
 // WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH.
@@ -1580,6 +1647,14 @@ wuffs_base__pixel_buffer::set_from_slice(
                                                   pixbuf_memory);
 }
 
+inline wuffs_base__status  //
+wuffs_base__pixel_buffer::set_planar(const wuffs_base__pixel_config* pixcfg_arg,
+                                     const wuffs_base__table_u8* planes_ptr,
+                                     size_t planes_len) {
+  return wuffs_base__pixel_buffer__set_planar(this, pixcfg_arg, planes_ptr,
+                                              planes_len);
+}
+
 inline wuffs_base__slice_u8  //
 wuffs_base__pixel_buffer::palette() {
   return wuffs_base__pixel_buffer__palette(this);
@@ -1633,16 +1708,113 @@ typedef struct wuffs_base__decode_frame_options__struct {
   // Do not access the private_impl's fields directly. There is no API/ABI
   // compatibility or safety guarantee if you do so.
   struct {
-    uint8_t TODO;
+    uint32_t scale_denominator;
+    wuffs_base__rect_ie_u32 region_of_interest;
   } private_impl;
 
 #ifdef __cplusplus
+  inline void set_scale_denominator(uint32_t d);
+  inline uint32_t scale_denominator() const;
+  inline void set_region_of_interest(wuffs_base__rect_ie_u32 r);
+  inline wuffs_base__rect_ie_u32 region_of_interest() const;
 #endif  // __cplusplus
 
 } wuffs_base__decode_frame_options;
 
+static inline wuffs_base__decode_frame_options  //
+wuffs_base__null_decode_frame_options(void) {
+  wuffs_base__decode_frame_options ret;
+  ret.private_impl.scale_denominator = 1;
+  ret.private_impl.region_of_interest = wuffs_base__empty_rect_ie_u32();
+  return ret;
+}
+
+// wuffs_base__decode_frame_options__set_scale_denominator requests that the
+// frame be decoded at a reduced size: (1 / d) of the full width and height,
+// rounded up. It is a hint. Decoders that can cheaply produce a downscaled
+// image (e.g. a JPEG decoder that can use a smaller inverse DCT) may use the
+// largest denominator that they support that is no greater than d. Other
+// decoders will ignore it. Zero is equivalent to one: full size.
+//
+// When honored, the decoded pixels are placed at the top-left of the
+// destination pixel buffer and the decoder's frame_dirty_rect method reports
+// the reduced size.
+static inline void  //
+wuffs_base__decode_frame_options__set_scale_denominator(
+    wuffs_base__decode_frame_options* o,
+    uint32_t d) {
+  if (o) {
+    o->private_impl.scale_denominator = d;
+  }
+}
+
+// wuffs_base__decode_frame_options__scale_denominator returns the requested
+// scale denominator, which is at least 1. A NULL o means full size.
+static inline uint32_t  //
+wuffs_base__decode_frame_options__scale_denominator(
+    const wuffs_base__decode_frame_options* o) {
+  return (o && (o->private_impl.scale_denominator > 1))
+             ? o->private_impl.scale_denominator
+             : 1;
+}
+
+// wuffs_base__decode_frame_options__set_region_of_interest requests that only
+// the pixels within r be decoded. It is a hint. Decoders may skip work (e.g.
+// entropy decoding, inverse DCTs or color conversion) for pixels outside of r
+// but they may also write some (or all) of those pixels, as not every file
+// format can be cropped precisely and cheaply. Every pixel within both r and
+// the frame is decoded as it would be without the hint. An empty r (the
+// default) means the whole frame.
+//
+// r is in the same coordinate space as the frame_dirty_rect, which is smaller
+// than the frame_config's bounds when a scale_denominator is also honored.
+// When the hint is honored, the decoder's frame_dirty_rect method reports the
+// (possibly larger than r) rectangle of pixels that it actually wrote.
+static inline void  //
+wuffs_base__decode_frame_options__set_region_of_interest(
+    wuffs_base__decode_frame_options* o,
+    wuffs_base__rect_ie_u32 r) {
+  if (o) {
+    o->private_impl.region_of_interest = r;
+  }
+}
+
+// wuffs_base__decode_frame_options__region_of_interest returns the requested
+// region of interest. An empty request, or a NULL o, means the whole frame,
+// which is returned as the largest possible (not empty) rectangle.
+static inline wuffs_base__rect_ie_u32  //
+wuffs_base__decode_frame_options__region_of_interest(
+    const wuffs_base__decode_frame_options* o) {
+  if (o && !wuffs_base__rect_ie_u32__is_empty(
+               &o->private_impl.region_of_interest)) {
+    return o->private_impl.region_of_interest;
+  }
+  return wuffs_base__make_rect_ie_u32(0u, 0u, 0xFFFFFFFFu, 0xFFFFFFFFu);
+}
+
 #ifdef __cplusplus
 
+inline void  //
+wuffs_base__decode_frame_options::set_scale_denominator(uint32_t d) {
+  wuffs_base__decode_frame_options__set_scale_denominator(this, d);
+}
+
+inline uint32_t  //
+wuffs_base__decode_frame_options::scale_denominator() const {
+  return wuffs_base__decode_frame_options__scale_denominator(this);
+}
+
+inline void  //
+wuffs_base__decode_frame_options::set_region_of_interest(
+    wuffs_base__rect_ie_u32 r) {
+  wuffs_base__decode_frame_options__set_region_of_interest(this, r);
+}
+
+inline wuffs_base__rect_ie_u32  //
+wuffs_base__decode_frame_options::region_of_interest() const {
+  return wuffs_base__decode_frame_options__region_of_interest(this);
+}
+
 #endif  // __cplusplus
 
 // --------
@@ -1700,6 +1872,10 @@ typedef struct wuffs_base__pixel_swizzler__struct {
       wuffs_base__slice_u8 dst,
       wuffs_base__slice_u8 dst_palette,
       wuffs_base__slice_u8 src) const;
+  inline uint64_t swizzle_interleaved_from_table(
+      wuffs_base__table_u8 dst,
+      wuffs_base__slice_u8 dst_palette,
+      wuffs_base__table_u8 src) const;
 #endif  // __cplusplus
 
 } wuffs_base__pixel_swizzler;
@@ -1731,6 +1907,26 @@ wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
     wuffs_base__slice_u8 dst_palette,
     wuffs_base__slice_u8 src);
 
+// wuffs_base__pixel_swizzler__swizzle_interleaved_from_table converts a
+// rectangle of pixels from a source format to a destination format. Each
+// table's width is measured in bytes, not pixels. The number of rows converted
+// is the minimum of the two tables' heights and it returns the number of
+// pixels converted.
+//
+// When both tables' rows are contiguous (each width equals its stride), the
+// rows are converted as a single span, amortizing the per-call overhead over
+// the whole rectangle instead of paying it once per row.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_from_table(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__table_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__table_u8 src);
+
 #ifdef __cplusplus
 
 inline wuffs_base__status  //
@@ -1752,4 +1948,13 @@ wuffs_base__pixel_swizzler::swizzle_interleaved_from_slice(
       this, dst, dst_palette, src);
 }
 
+uint64_t  //
+wuffs_base__pixel_swizzler::swizzle_interleaved_from_table(
+    wuffs_base__table_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__table_u8 src) const {
+  return wuffs_base__pixel_swizzler__swizzle_interleaved_from_table(
+      this, dst, dst_palette, src);
+}
+
 #endif  // __cplusplus
@@ -0,0 +1,1440 @@
+// Copyright 2024 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// https://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or https://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+// --------
+
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+
+// Unlike the x86_avx2 code, which works in 16-bit lanes, the arm_neon YCbCr
+// to BGRX/RGBX conversion works in 32-bit lanes, using the same 16.16 fixed
+// point arithmetic as wuffs_base__color_ycc__as__color_u32. Its output is
+// therefore identical to the non-SIMD code.
+//
+// vqshrun_n_s32 (saturating to 0x0000 ..= 0xFFFF) followed by vqmovn_u16
+// (saturating to 0x00 ..= 0xFF) is equivalent to the non-SIMD code's "if
+// (rr32 >> 24) etc" saturation.
+static inline uint8x8_t  //
+wuffs_private_impl__swizzle_ycc__narrow_16_16_arm_neon(int32x4_t lo,
+                                                       int32x4_t hi) {
+  return vqmovn_u16(vcombine_u16(vqshrun_n_s32(lo, 16),  //
+                                 vqshrun_n_s32(hi, 16)));
+}
+
+static void  //
+wuffs_private_impl__swizzle_ycc__convert_3_bgrx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2) {
+  if ((x + 8u) > x_end) {
+    wuffs_private_impl__swizzle_ycc__convert_3_bgrx(  //
+        dst, x, x_end, y, up0, up1, up2);
+    return;
+  }
+
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  const uint8x8_t u80 = vdup_n_u8(0x80);
+  const uint32x4_t u00008000 = vdupq_n_u32(0x8000);
+
+  uint8x8x4_t bgrx;
+  bgrx.val[3] = vdup_n_u8(0xFF);
+
+  while (x < x_end) {
+    // yy_lo = u32x4 [(y.0 << 16) | 0x8000 .. (y.3 << 16) | 0x8000]
+    // cb_lo = i32x4 [cb.0 - 0x80           .. cb.3 - 0x80          ]
+    //
+    // Ditto for the _hi (elements 4 ..= 7) and cr_xx Chroma-Red values.
+    uint16x8_t yy_all = vmovl_u8(vld1_u8(up0));
+    int16x8_t cb_all = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(up1), u80));
+    int16x8_t cr_all = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(up2), u80));
+    int32x4_t yy_lo = vreinterpretq_s32_u32(
+        vorrq_u32(vshll_n_u16(vget_low_u16(yy_all), 16), u00008000));
+    int32x4_t yy_hi = vreinterpretq_s32_u32(
+        vorrq_u32(vshll_n_u16(vget_high_u16(yy_all), 16), u00008000));
+    int32x4_t cb_lo = vmovl_s16(vget_low_s16(cb_all));
+    int32x4_t cb_hi = vmovl_s16(vget_high_s16(cb_all));
+    int32x4_t cr_lo = vmovl_s16(vget_low_s16(cr_all));
+    int32x4_t cr_hi = vmovl_s16(vget_high_s16(cr_all));
+
+    // R = Y                + 1.40200 * Cr
+    // G = Y - 0.34414 * Cb - 0.71414 * Cr
+    // B = Y + 1.77200 * Cb
+    int32x4_t rr_lo = vmlaq_n_s32(yy_lo, cr_lo, 0x166E9);
+    int32x4_t rr_hi = vmlaq_n_s32(yy_hi, cr_hi, 0x166E9);
+    int32x4_t gg_lo = vmlsq_n_s32(vmlsq_n_s32(yy_lo, cb_lo, 0x0581A),  //
+                                  cr_lo, 0x0B6D2);
+    int32x4_t gg_hi = vmlsq_n_s32(vmlsq_n_s32(yy_hi, cb_hi, 0x0581A),  //
+                                  cr_hi, 0x0B6D2);
+    int32x4_t bb_lo = vmlaq_n_s32(yy_lo, cb_lo, 0x1C5A2);
+    int32x4_t bb_hi = vmlaq_n_s32(yy_hi, cb_hi, 0x1C5A2);
+
+    // Narrow and interleave, writing 32 bytes (8 BGRX pixels).
+    bgrx.val[0] = wuffs_private_impl__swizzle_ycc__narrow_16_16_arm_neon(  //
+        bb_lo, bb_hi);
+    bgrx.val[1] = wuffs_private_impl__swizzle_ycc__narrow_16_16_arm_neon(  //
+        gg_lo, gg_hi);
+    bgrx.val[2] = wuffs_private_impl__swizzle_ycc__narrow_16_16_arm_neon(  //
+        rr_lo, rr_hi);
+    vst4_u8(dst_iter, bgrx);
+
+    // Advance by up to 8 pixels. The first iteration might be smaller than 8
+    // so that all of the remaining steps are exactly 8.
+    uint32_t n = 8u - (7u & (x - x_end));
+    dst_iter += 4u * n;
+    up0 += n;
+    up1 += n;
+    up2 += n;
+    x += n;
+  }
+}
+
+// The rgbx flavor (below) is exactly the same as the bgrx flavor (above)
+// except for the lines marked with a § and that comments were stripped.
+static void  //
+wuffs_private_impl__swizzle_ycc__convert_3_rgbx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2) {
+  if ((x + 8u) > x_end) {
+    wuffs_private_impl__swizzle_ycc__convert_3_rgbx(  // §
+        dst, x, x_end, y, up0, up1, up2);
+    return;
+  }
+
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  const uint8x8_t u80 = vdup_n_u8(0x80);
+  const uint32x4_t u00008000 = vdupq_n_u32(0x8000);
+
+  uint8x8x4_t rgbx;  // §
+  rgbx.val[3] = vdup_n_u8(0xFF);
+
+  while (x < x_end) {
+    uint16x8_t yy_all = vmovl_u8(vld1_u8(up0));
+    int16x8_t cb_all = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(up1), u80));
+    int16x8_t cr_all = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(up2), u80));
+    int32x4_t yy_lo = vreinterpretq_s32_u32(
+        vorrq_u32(vshll_n_u16(vget_low_u16(yy_all), 16), u00008000));
+    int32x4_t yy_hi = vreinterpretq_s32_u32(
+        vorrq_u32(vshll_n_u16(vget_high_u16(yy_all), 16), u00008000));
+    int32x4_t cb_lo = vmovl_s16(vget_low_s16(cb_all));
+    int32x4_t cb_hi = vmovl_s16(vget_high_s16(cb_all));
+    int32x4_t cr_lo = vmovl_s16(vget_low_s16(cr_all));
+    int32x4_t cr_hi = vmovl_s16(vget_high_s16(cr_all));
+
+    int32x4_t rr_lo = vmlaq_n_s32(yy_lo, cr_lo, 0x166E9);
+    int32x4_t rr_hi = vmlaq_n_s32(yy_hi, cr_hi, 0x166E9);
+    int32x4_t gg_lo = vmlsq_n_s32(vmlsq_n_s32(yy_lo, cb_lo, 0x0581A),  //
+                                  cr_lo, 0x0B6D2);
+    int32x4_t gg_hi = vmlsq_n_s32(vmlsq_n_s32(yy_hi, cb_hi, 0x0581A),  //
+                                  cr_hi, 0x0B6D2);
+    int32x4_t bb_lo = vmlaq_n_s32(yy_lo, cb_lo, 0x1C5A2);
+    int32x4_t bb_hi = vmlaq_n_s32(yy_hi, cb_hi, 0x1C5A2);
+
+    rgbx.val[0] = wuffs_private_impl__swizzle_ycc__narrow_16_16_arm_neon(  // §
+        rr_lo, rr_hi);
+    rgbx.val[1] = wuffs_private_impl__swizzle_ycc__narrow_16_16_arm_neon(  // §
+        gg_lo, gg_hi);
+    rgbx.val[2] = wuffs_private_impl__swizzle_ycc__narrow_16_16_arm_neon(  // §
+        bb_lo, bb_hi);
+    vst4_u8(dst_iter, rgbx);  // §
+
+    uint32_t n = 8u - (7u & (x - x_end));
+    dst_iter += 4u * n;
+    up0 += n;
+    up1 += n;
+    up2 += n;
+    x += n;
+  }
+}
+
+// wuffs_private_impl__swizzle_cmyk__scale_arm_neon returns (((a * w) + 0x7F)
+// / 0xFF) for each u8x8 element. With t = (a * w), vraddhn_u16(t,
+// vrshrq_n_u16(t, 8)) is the classic "divide by 255, rounding to nearest"
+// trick, which matches the non-SIMD code exactly.
+static inline uint8x8_t  //
+wuffs_private_impl__swizzle_cmyk__scale_arm_neon(uint8x8_t a, uint8x8_t w) {
+  uint16x8_t t = vmull_u8(a, w);
+  return vraddhn_u16(t, vrshrq_n_u16(t, 8));
+}
+
+static void  //
+wuffs_private_impl__swizzle_cmyk__convert_4_bgrx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  if ((x + 8u) > x_end) {
+    wuffs_private_impl__swizzle_cmyk__convert_4_general(  //
+        dst, x, x_end, y, up0, up1, up2, up3);
+    return;
+  }
+
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  uint8x8x4_t bgrx;
+  bgrx.val[3] = vdup_n_u8(0xFF);
+
+  while (x < x_end) {
+    // As per wuffs_private_impl__swizzle_cmyk__convert_4_general, "CMYK" is
+    // really RGBW and the inversions cancel out.
+    uint8x8_t ww = vld1_u8(up3);
+    bgrx.val[0] = wuffs_private_impl__swizzle_cmyk__scale_arm_neon(  //
+        vld1_u8(up2), ww);
+    bgrx.val[1] = wuffs_private_impl__swizzle_cmyk__scale_arm_neon(  //
+        vld1_u8(up1), ww);
+    bgrx.val[2] = wuffs_private_impl__swizzle_cmyk__scale_arm_neon(  //
+        vld1_u8(up0), ww);
+    vst4_u8(dst_iter, bgrx);
+
+    // Advance by up to 8 pixels. The first iteration might be smaller than 8
+    // so that all of the remaining steps are exactly 8.
+    uint32_t n = 8u - (7u & (x - x_end));
+    dst_iter += 4u * n;
+    up0 += n;
+    up1 += n;
+    up2 += n;
+    up3 += n;
+    x += n;
+  }
+}
+
+// The rgbx flavor (below) is exactly the same as the bgrx flavor (above)
+// except for the lines marked with a § and that comments were stripped.
+static void  //
+wuffs_private_impl__swizzle_cmyk__convert_4_rgbx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  if ((x + 8u) > x_end) {
+    wuffs_private_impl__swizzle_cmyk__convert_4_general(  //
+        dst, x, x_end, y, up0, up1, up2, up3);
+    return;
+  }
+
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  uint8x8x4_t rgbx;  // §
+  rgbx.val[3] = vdup_n_u8(0xFF);
+
+  while (x < x_end) {
+    uint8x8_t ww = vld1_u8(up3);
+    rgbx.val[0] = wuffs_private_impl__swizzle_cmyk__scale_arm_neon(  //
+        vld1_u8(up0), ww);                                          // §
+    rgbx.val[1] = wuffs_private_impl__swizzle_cmyk__scale_arm_neon(  //
+        vld1_u8(up1), ww);
+    rgbx.val[2] = wuffs_private_impl__swizzle_cmyk__scale_arm_neon(  //
+        vld1_u8(up2), ww);                                          // §
+    vst4_u8(dst_iter, rgbx);
+
+    uint32_t n = 8u - (7u & (x - x_end));
+    dst_iter += 4u * n;
+    up0 += n;
+    up1 += n;
+    up2 += n;
+    up3 += n;
+    x += n;
+  }
+}
+
+static void  //
+wuffs_private_impl__swizzle_ycck__convert_4_bgrx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  if ((x + 8u) > x_end) {
+    wuffs_private_impl__swizzle_ycck__convert_4_general(  //
+        dst, x, x_end, y, up0, up1, up2, up3);
+    return;
+  }
+
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  const uint8x8_t u80 = vdup_n_u8(0x80);
+  const uint32x4_t u00008000 = vdupq_n_u32(0x8000);
+
+  uint8x8x4_t bgrx;
+  bgrx.val[3] = vdup_n_u8(0xFF);
+
+  while (x < x_end) {
+    // The YCbCr to RGB conversion is the same as for convert_3_bgrx_arm_neon.
+    uint16x8_t yy_all = vmovl_u8(vld1_u8(up0));
+    int16x8_t cb_all = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(up1), u80));
+    int16x8_t cr_all = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(up2), u80));
+    int32x4_t yy_lo = vreinterpretq_s32_u32(
+        vorrq_u32(vshll_n_u16(vget_low_u16(yy_all), 16), u00008000));
+    int32x4_t yy_hi = vreinterpretq_s32_u32(
+        vorrq_u32(vshll_n_u16(vget_high_u16(yy_all), 16), u00008000));
+    int32x4_t cb_lo = vmovl_s16(vget_low_s16(cb_all));
+    int32x4_t cb_hi = vmovl_s16(vget_high_s16(cb_all));
+    int32x4_t cr_lo = vmovl_s16(vget_low_s16(cr_all));
+    int32x4_t cr_hi = vmovl_s16(vget_high_s16(cr_all));
+
+    int32x4_t rr_lo = vmlaq_n_s32(yy_lo, cr_lo, 0x166E9);
+    int32x4_t rr_hi = vmlaq_n_s32(yy_hi, cr_hi, 0x166E9);
+    int32x4_t gg_lo = vmlsq_n_s32(vmlsq_n_s32(yy_lo, cb_lo, 0x0581A),  //
+                                  cr_lo, 0x0B6D2);
+    int32x4_t gg_hi = vmlsq_n_s32(vmlsq_n_s32(yy_hi, cb_hi, 0x0581A),  //
+                                  cr_hi, 0x0B6D2);
+    int32x4_t bb_lo = vmlaq_n_s32(yy_lo, cb_lo, 0x1C5A2);
+    int32x4_t bb_hi = vmlaq_n_s32(yy_hi, cb_hi, 0x1C5A2);
+
+    // Narrow and invert (0xFF means no ink instead of full ink), then scale
+    // by the K channel.
+    uint8x8_t ww = vld1_u8(up3);
+    bgrx.val[0] = wuffs_private_impl__swizzle_cmyk__scale_arm_neon(
+        vmvn_u8(wuffs_private_impl__swizzle_ycc__narrow_16_16_arm_neon(
+            bb_lo, bb_hi)),
+        ww);
+    bgrx.val[1] = wuffs_private_impl__swizzle_cmyk__scale_arm_neon(
+        vmvn_u8(wuffs_private_impl__swizzle_ycc__narrow_16_16_arm_neon(
+            gg_lo, gg_hi)),
+        ww);
+    bgrx.val[2] = wuffs_private_impl__swizzle_cmyk__scale_arm_neon(
+        vmvn_u8(wuffs_private_impl__swizzle_ycc__narrow_16_16_arm_neon(
+            rr_lo, rr_hi)),
+        ww);
+    vst4_u8(dst_iter, bgrx);
+
+    // Advance by up to 8 pixels. The first iteration might be smaller than 8
+    // so that all of the remaining steps are exactly 8.
+    uint32_t n = 8u - (7u & (x - x_end));
+    dst_iter += 4u * n;
+    up0 += n;
+    up1 += n;
+    up2 += n;
+    up3 += n;
+    x += n;
+  }
+}
+
+// The rgbx flavor (below) is exactly the same as the bgrx flavor (above)
+// except for the lines marked with a § and that comments were stripped.
+static void  //
+wuffs_private_impl__swizzle_ycck__convert_4_rgbx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  if ((x + 8u) > x_end) {
+    wuffs_private_impl__swizzle_ycck__convert_4_general(  //
+        dst, x, x_end, y, up0, up1, up2, up3);
+    return;
+  }
+
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  const uint8x8_t u80 = vdup_n_u8(0x80);
+  const uint32x4_t u00008000 = vdupq_n_u32(0x8000);
+
+  uint8x8x4_t rgbx;  // §
+  rgbx.val[3] = vdup_n_u8(0xFF);
+
+  while (x < x_end) {
+    uint16x8_t yy_all = vmovl_u8(vld1_u8(up0));
+    int16x8_t cb_all = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(up1), u80));
+    int16x8_t cr_all = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(up2), u80));
+    int32x4_t yy_lo = vreinterpretq_s32_u32(
+        vorrq_u32(vshll_n_u16(vget_low_u16(yy_all), 16), u00008000));
+    int32x4_t yy_hi = vreinterpretq_s32_u32(
+        vorrq_u32(vshll_n_u16(vget_high_u16(yy_all), 16), u00008000));
+    int32x4_t cb_lo = vmovl_s16(vget_low_s16(cb_all));
+    int32x4_t cb_hi = vmovl_s16(vget_high_s16(cb_all));
+    int32x4_t cr_lo = vmovl_s16(vget_low_s16(cr_all));
+    int32x4_t cr_hi = vmovl_s16(vget_high_s16(cr_all));
+
+    int32x4_t rr_lo = vmlaq_n_s32(yy_lo, cr_lo, 0x166E9);
+    int32x4_t rr_hi = vmlaq_n_s32(yy_hi, cr_hi, 0x166E9);
+    int32x4_t gg_lo = vmlsq_n_s32(vmlsq_n_s32(yy_lo, cb_lo, 0x0581A),  //
+                                  cr_lo, 0x0B6D2);
+    int32x4_t gg_hi = vmlsq_n_s32(vmlsq_n_s32(yy_hi, cb_hi, 0x0581A),  //
+                                  cr_hi, 0x0B6D2);
+    int32x4_t bb_lo = vmlaq_n_s32(yy_lo, cb_lo, 0x1C5A2);
+    int32x4_t bb_hi = vmlaq_n_s32(yy_hi, cb_hi, 0x1C5A2);
+
+    uint8x8_t ww = vld1_u8(up3);
+    rgbx.val[0] = wuffs_private_impl__swizzle_cmyk__scale_arm_neon(
+        vmvn_u8(wuffs_private_impl__swizzle_ycc__narrow_16_16_arm_neon(
+            rr_lo, rr_hi)),  // §
+        ww);
+    rgbx.val[1] = wuffs_private_impl__swizzle_cmyk__scale_arm_neon(
+        vmvn_u8(wuffs_private_impl__swizzle_ycc__narrow_16_16_arm_neon(
+            gg_lo, gg_hi)),
+        ww);
+    rgbx.val[2] = wuffs_private_impl__swizzle_cmyk__scale_arm_neon(
+        vmvn_u8(wuffs_private_impl__swizzle_ycc__narrow_16_16_arm_neon(
+            bb_lo, bb_hi)),  // §
+        ww);
+    vst4_u8(dst_iter, rgbx);
+
+    uint32_t n = 8u - (7u & (x - x_end));
+    dst_iter += 4u * n;
+    up0 += n;
+    up1 += n;
+    up2 += n;
+    up3 += n;
+    x += n;
+  }
+}
+
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h2v1_triangle_arm_neon(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column,
+    bool last_column) {
+  uint8_t* dp = dst_ptr;
+  const uint8_t* sp = src_ptr_major;
+
+  if (first_column) {
+    src_len--;
+    if ((src_len <= 0u) && last_column) {
+      uint8_t sv = *sp++;
+      *dp++ = sv;
+      *dp++ = sv;
+      return dst_ptr;
+    }
+    uint32_t svp1 = sp[+1];
+    uint8_t sv = *sp++;
+    *dp++ = sv;
+    *dp++ = (uint8_t)(((3u * (uint32_t)sv) + svp1 + 2u) >> 2u);
+    if (src_len <= 0u) {
+      return dst_ptr;
+    }
+  }
+
+  if (last_column) {
+    src_len--;
+  }
+
+  if (src_len < 16) {
+    // This fallback is the same as the non-SIMD-capable code path.
+    for (; src_len > 0u; src_len--) {
+      uint32_t svm1 = sp[-1];
+      uint32_t svp1 = sp[+1];
+      uint32_t sv3 = 3u * (uint32_t)(*sp++);
+      *dp++ = (uint8_t)((sv3 + svm1 + 1u) >> 2u);
+      *dp++ = (uint8_t)((sv3 + svp1 + 2u) >> 2u);
+    }
+
+  } else {
+    const uint8x8_t u03 = vdup_n_u8(3);
+    const uint16x8_t u0001 = vdupq_n_u16(1);
+    const uint16x8_t u0002 = vdupq_n_u16(2);
+
+    while (src_len > 0u) {
+      // Load 1+16+1 samples (three u8x16 vectors).
+      //
+      // p0 = [s00 s01 s02 s03 .. s12 s13 s14 s15]   // p0 = "plus  0"
+      // m1 = [sm1 s00 s01 s02 .. s11 s12 s13 s14]   // m1 = "minus 1"
+      // p1 = [s01 s02 s03 s04 .. s13 s14 s15 s16]   // p1 = "plus  1"
+      uint8x16_t p0 = vld1q_u8(sp + 0);
+      uint8x16_t m1 = vld1q_u8(sp - 1);
+      uint8x16_t p1 = vld1q_u8(sp + 1);
+
+      // Compute the u16x8 weighted sums, low and high halves. For example:
+      //
+      // m1_lo[0] = ((3*s00) + (1*sm1) + 1) as u16
+      // p1_hi[7] = ((3*s15) + (1*s16) + 2) as u16
+      uint16x8_t m1_lo = vaddq_u16(
+          vmlal_u8(vmovl_u8(vget_low_u8(m1)), vget_low_u8(p0), u03), u0001);
+      uint16x8_t m1_hi = vaddq_u16(
+          vmlal_u8(vmovl_u8(vget_high_u8(m1)), vget_high_u8(p0), u03), u0001);
+      uint16x8_t p1_lo = vaddq_u16(
+          vmlal_u8(vmovl_u8(vget_low_u8(p1)), vget_low_u8(p0), u03), u0002);
+      uint16x8_t p1_hi = vaddq_u16(
+          vmlal_u8(vmovl_u8(vget_high_u8(p1)), vget_high_u8(p0), u03), u0002);
+
+      // Divide by 4 (which is 3+1), narrow and interleave (the m1 and p1 sums
+      // are the even and odd destination samples) and store.
+      uint8x16x2_t dst;
+      dst.val[0] = vcombine_u8(vshrn_n_u16(m1_lo, 2), vshrn_n_u16(m1_hi, 2));
+      dst.val[1] = vcombine_u8(vshrn_n_u16(p1_lo, 2), vshrn_n_u16(p1_hi, 2));
+      vst2q_u8(dp, dst);
+
+      // Advance by up to 16 source samples (32 destination samples). The
+      // first iteration might be smaller than 16 so that all of the
+      // remaining steps are exactly 16.
+      size_t n = 16u - (15u & (0u - src_len));
+      dp += 2u * n;
+      sp += n;
+      src_len -= n;
+    }
+  }
+
+  if (last_column) {
+    uint32_t svm1 = sp[-1];
+    uint8_t sv = *sp++;
+    *dp++ = (uint8_t)(((3u * (uint32_t)sv) + svm1 + 1u) >> 2u);
+    *dp++ = sv;
+  }
+
+  return dst_ptr;
+}
+
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h2v2_triangle_arm_neon(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column,
+    bool last_column) {
+  uint8_t* dp = dst_ptr;
+  const uint8_t* sp_major = src_ptr_major;
+  const uint8_t* sp_minor = src_ptr_minor;
+
+  if (first_column) {
+    src_len--;
+    if ((src_len <= 0u) && last_column) {
+      uint32_t sv = (12u * ((uint32_t)(*sp_major++))) +  //
+                    (4u * ((uint32_t)(*sp_minor++)));
+      *dp++ = (uint8_t)((sv + 8u) >> 4u);
+      *dp++ = (uint8_t)((sv + 7u) >> 4u);
+      return dst_ptr;
+    }
+
+    uint32_t sv_major_m1 = sp_major[-0];  // Clamp offset to zero.
+    uint32_t sv_minor_m1 = sp_minor[-0];  // Clamp offset to zero.
+    uint32_t sv_major_p1 = sp_major[+1];
+    uint32_t sv_minor_p1 = sp_minor[+1];
+
+    uint32_t sv = (9u * ((uint32_t)(*sp_major++))) +  //
+                  (3u * ((uint32_t)(*sp_minor++)));
+    *dp++ = (uint8_t)((sv + (3u * sv_major_m1) + (sv_minor_m1) + 8u) >> 4u);
+    *dp++ = (uint8_t)((sv + (3u * sv_major_p1) + (sv_minor_p1) + 7u) >> 4u);
+    if (src_len <= 0u) {
+      return dst_ptr;
+    }
+  }
+
+  if (last_column) {
+    src_len--;
+  }
+
+  if (src_len < 16) {
+    // This fallback is the same as the non-SIMD-capable code path.
+    for (; src_len > 0u; src_len--) {
+      uint32_t sv_major_m1 = sp_major[-1];
+      uint32_t sv_minor_m1 = sp_minor[-1];
+      uint32_t sv_major_p1 = sp_major[+1];
+      uint32_t sv_minor_p1 = sp_minor[+1];
+
+      uint32_t sv = (9u * ((uint32_t)(*sp_major++))) +  //
+                    (3u * ((uint32_t)(*sp_minor++)));
+      *dp++ = (uint8_t)((sv + (3u * sv_major_m1) + (sv_minor_m1) + 8u) >> 4u);
+      *dp++ = (uint8_t)((sv + (3u * sv_major_p1) + (sv_minor_p1) + 7u) >> 4u);
+    }
+
+  } else {
+    const uint8x8_t u01 = vdup_n_u8(1);
+    const uint8x8_t u03 = vdup_n_u8(3);
+    const uint8x8_t u09 = vdup_n_u8(9);
+    const uint16x8_t u0007 = vdupq_n_u16(7);
+    const uint16x8_t u0008 = vdupq_n_u16(8);
+
+    while (src_len > 0u) {
+      // Load 1+16+1 samples (six u8x16 vectors) from the major (jxx) and minor
+      // (nxx) rows.
+      //
+      // major_p0 = [j00 j01 j02 j03 .. j12 j13 j14 j15]   // p0 = "plus  0"
+      // minor_p0 = [n00 n01 n02 n03 .. n12 n13 n14 n15]   // p0 = "plus  0"
+      // major_m1 = [jm1 j00 j01 j02 .. j11 j12 j13 j14]   // m1 = "minus 1"
+      // minor_m1 = [nm1 n00 n01 n02 .. n11 n12 n13 n14]   // m1 = "minus 1"
+      // major_p1 = [j01 j02 j03 j04 .. j13 j14 j15 j16]   // p1 = "plus  1"
+      // minor_p1 = [n01 n02 n03 n04 .. n13 n14 n15 n16]   // p1 = "plus  1"
+      uint8x16_t major_p0 = vld1q_u8(sp_major + 0);
+      uint8x16_t minor_p0 = vld1q_u8(sp_minor + 0);
+      uint8x16_t major_m1 = vld1q_u8(sp_major - 1);
+      uint8x16_t minor_m1 = vld1q_u8(sp_minor - 1);
+      uint8x16_t major_p1 = vld1q_u8(sp_major + 1);
+      uint8x16_t minor_p1 = vld1q_u8(sp_minor + 1);
+
+      // Multiply-add to get u16x8 vectors.
+      //
+      // step1_p0_lo = [9*j00+3*n00 9*j01+3*n01 .. 9*j07+3*n07]
+      // step1_p0_hi = [9*j08+3*n08 9*j09+3*n09 .. 9*j15+3*n15]
+      // step1_m1_lo = [3*jm1+1*nm1 3*j00+1*n00 .. 3*j06+1*n06]
+      // step1_m1_hi = [3*j07+1*n07 3*j08+1*n08 .. 3*j14+1*n14]
+      // step1_p1_lo = [3*j01+1*n01 3*j02+1*n02 .. 3*j08+1*n08]
+      // step1_p1_hi = [3*j09+1*n09 3*j10+1*n10 .. 3*j16+1*n16]
+      uint16x8_t step1_p0_lo = vmlal_u8(
+          vmull_u8(vget_low_u8(major_p0), u09), vget_low_u8(minor_p0), u03);
+      uint16x8_t step1_p0_hi = vmlal_u8(
+          vmull_u8(vget_high_u8(major_p0), u09), vget_high_u8(minor_p0), u03);
+      uint16x8_t step1_m1_lo = vmlal_u8(
+          vmull_u8(vget_low_u8(major_m1), u03), vget_low_u8(minor_m1), u01);
+      uint16x8_t step1_m1_hi = vmlal_u8(
+          vmull_u8(vget_high_u8(major_m1), u03), vget_high_u8(minor_m1), u01);
+      uint16x8_t step1_p1_lo = vmlal_u8(
+          vmull_u8(vget_low_u8(major_p1), u03), vget_low_u8(minor_p1), u01);
+      uint16x8_t step1_p1_hi = vmlal_u8(
+          vmull_u8(vget_high_u8(major_p1), u03), vget_high_u8(minor_p1), u01);
+
+      // Compute the weighted sums of (p0, m1) and (p0, p1), biased by 8 (on
+      // the left) or 7 (on the right). For example:
+      //
+      // step2_m1_lo[0] = ((9*j00) + (3*n00) + (3*jm1) + (1*nm1) + 8) as u16
+      // step2_p1_hi[7] = ((9*j15) + (3*n15) + (3*j16) + (1*n16) + 7) as u16
+      uint16x8_t step2_m1_lo =
+          vaddq_u16(vaddq_u16(step1_p0_lo, step1_m1_lo), u0008);
+      uint16x8_t step2_m1_hi =
+          vaddq_u16(vaddq_u16(step1_p0_hi, step1_m1_hi), u0008);
+      uint16x8_t step2_p1_lo =
+          vaddq_u16(vaddq_u16(step1_p0_lo, step1_p1_lo), u0007);
+      uint16x8_t step2_p1_hi =
+          vaddq_u16(vaddq_u16(step1_p0_hi, step1_p1_hi), u0007);
+
+      // Divide by 16 (which is 9+3+3+1), narrow and interleave (the m1 and p1
+      // sums are the even and odd destination samples) and store.
+      uint8x16x2_t dst;
+      dst.val[0] = vcombine_u8(vshrn_n_u16(step2_m1_lo, 4),  //
+                               vshrn_n_u16(step2_m1_hi, 4));
+      dst.val[1] = vcombine_u8(vshrn_n_u16(step2_p1_lo, 4),  //
+                               vshrn_n_u16(step2_p1_hi, 4));
+      vst2q_u8(dp, dst);
+
+      // Advance by up to 16 source samples (32 destination samples). The
+      // first iteration might be smaller than 16 so that all of the
+      // remaining steps are exactly 16.
+      size_t n = 16u - (15u & (0u - src_len));
+      dp += 2u * n;
+      sp_major += n;
+      sp_minor += n;
+      src_len -= n;
+    }
+  }
+
+  if (last_column) {
+    uint32_t sv_major_m1 = sp_major[-1];
+    uint32_t sv_minor_m1 = sp_minor[-1];
+    uint32_t sv_major_p1 = sp_major[+0];  // Clamp offset to zero.
+    uint32_t sv_minor_p1 = sp_minor[+0];  // Clamp offset to zero.
+
+    uint32_t sv = (9u * ((uint32_t)(*sp_major++))) +  //
+                  (3u * ((uint32_t)(*sp_minor++)));
+    *dp++ = (uint8_t)((sv + (3u * sv_major_m1) + (sv_minor_m1) + 8u) >> 4u);
+    *dp++ = (uint8_t)((sv + (3u * sv_major_p1) + (sv_minor_p1) + 7u) >> 4u);
+  }
+
+  return dst_ptr;
+}
+
+// --------
+
+// The src_over arm_neon code below composites onto premultiplied 8-bit BGRA
+// destinations, 8 pixels at a time. Like the x86_avx2 code, it works with the
+// same 16-bit color components as the non-SIMD code and divides by 0xFFFF as
+// ((x + (x >> 16) + 1) >> 16), so that the output matches exactly. vld4 and
+// vst4 de-interleave and re-interleave the channels, so that RGBA sources
+// only need their b and r channels swapped.
+
+// wuffs_private_impl__swizzle_src_over__div_ffff_arm_neon returns (x / 0xFFFF)
+// for each u32x4 element in the range 0 ..= 0xFFFE0001, narrowed to u16x4.
+static inline uint16x4_t  //
+wuffs_private_impl__swizzle_src_over__div_ffff_arm_neon(uint32x4_t x) {
+  return vshrn_n_u32(vaddq_u32(vsraq_n_u32(x, x, 16), vdupq_n_u32(1)), 16);
+}
+
+// wuffs_private_impl__swizzle_src_over__composite_arm_neon composites one
+// channel of 8 pixels, given as 16-bit color components, returning 8-bit
+// color. For the alpha channel, pass (s = sa) for premul src and (s = 0xFFFF)
+// for nonpremul src.
+static inline uint8x8_t  //
+wuffs_private_impl__swizzle_src_over__composite_arm_neon(uint16x8_t d,
+                                                         uint16x8_t s,
+                                                         uint16x8_t sa,
+                                                         uint16x8_t ia,
+                                                         bool src_premul) {
+  if (src_premul) {
+    // s + ((d * ia) / 0xFFFF). The saturating add only matters for invalid
+    // premul input, where a color exceeds its alpha.
+    uint16x8_t q = vcombine_u16(
+        wuffs_private_impl__swizzle_src_over__div_ffff_arm_neon(
+            vmull_u16(vget_low_u16(d), vget_low_u16(ia))),
+        wuffs_private_impl__swizzle_src_over__div_ffff_arm_neon(
+            vmull_u16(vget_high_u16(d), vget_high_u16(ia))));
+    return vshrn_n_u16(vqaddq_u16(s, q), 8);
+  }
+
+  // ((s * sa) + (d * ia)) / 0xFFFF.
+  uint16x8_t q = vcombine_u16(
+      wuffs_private_impl__swizzle_src_over__div_ffff_arm_neon(
+          vmlal_u16(vmull_u16(vget_low_u16(s), vget_low_u16(sa)),  //
+                    vget_low_u16(d), vget_low_u16(ia))),
+      wuffs_private_impl__swizzle_src_over__div_ffff_arm_neon(
+          vmlal_u16(vmull_u16(vget_high_u16(s), vget_high_u16(sa)),  //
+                    vget_high_u16(d), vget_high_u16(ia))));
+  return vshrn_n_u16(q, 8);
+}
+
+// wuffs_private_impl__swizzle_src_over__bgra_premul_arm_neon composites groups
+// of 8 pixels and returns the number of pixels processed, a multiple of 8.
+// The caller handles any remaining pixels.
+//
+// The src is 4 bytes (or 8 bytes if src_4x16le) per pixel. If src_swap_rb
+// then it is RGBA order instead of BGRA order.
+static inline WUFFS_BASE__FORCE_INLINE size_t  //
+wuffs_private_impl__swizzle_src_over__bgra_premul_arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    const uint8_t* src_ptr,
+    size_t src_len,
+    bool src_4x16le,
+    bool src_premul,
+    bool src_swap_rb) {
+  size_t src_bpp = src_4x16le ? 8u : 4u;
+  size_t dst_len4 = dst_len / 4;
+  size_t src_lenx = src_len / src_bpp;
+  size_t len = ((dst_len4 < src_lenx) ? dst_len4 : src_lenx) & ~(size_t)7u;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  const uint16x8_t uFFFF = vdupq_n_u16(0xFFFF);
+
+  while (n >= 8) {
+    uint16x8_t sb;
+    uint16x8_t sg;
+    uint16x8_t sr;
+    uint16x8_t sa;
+
+    if (src_4x16le) {
+      uint16x8x4_t s16 = vld4q_u16((const uint16_t*)(const void*)s);
+      sb = s16.val[src_swap_rb ? 2 : 0];
+      sg = s16.val[1];
+      sr = s16.val[src_swap_rb ? 0 : 2];
+      sa = s16.val[3];
+
+    } else {
+      uint8x8x4_t s8 = vld4_u8(s);
+      if (src_swap_rb) {
+        uint8x8_t tmp = s8.val[0];
+        s8.val[0] = s8.val[2];
+        s8.val[2] = tmp;
+      }
+
+      // Fast paths: fully opaque src replaces dst. Fully transparent src
+      // leaves dst unchanged. Both match the non-SIMD code exactly.
+      uint64_t all_a = vget_lane_u64(vreinterpret_u64_u8(s8.val[3]), 0);
+      uint64_t any_x = all_a;
+      if (src_premul) {
+        any_x |= vget_lane_u64(
+            vreinterpret_u64_u8(vorr_u8(vorr_u8(s8.val[0], s8.val[1]),  //
+                                        s8.val[2])),
+            0);
+      }
+      if (all_a == 0xFFFFFFFFFFFFFFFFu) {
+        vst4_u8(d, s8);
+        s += 8 * 4;
+        d += 8 * 4;
+        n -= 8;
+        continue;
+      } else if (any_x == 0) {
+        s += 8 * 4;
+        d += 8 * 4;
+        n -= 8;
+        continue;
+      }
+
+      sb = vmulq_n_u16(vmovl_u8(s8.val[0]), 0x101);
+      sg = vmulq_n_u16(vmovl_u8(s8.val[1]), 0x101);
+      sr = vmulq_n_u16(vmovl_u8(s8.val[2]), 0x101);
+      sa = vmulq_n_u16(vmovl_u8(s8.val[3]), 0x101);
+    }
+
+    uint8x8x4_t d8 = vld4_u8(d);
+    uint16x8_t ia = vsubq_u16(uFFFF, sa);
+    uint8x8x4_t o8;
+    o8.val[0] = wuffs_private_impl__swizzle_src_over__composite_arm_neon(
+        vmulq_n_u16(vmovl_u8(d8.val[0]), 0x101), sb, sa, ia, src_premul);
+    o8.val[1] = wuffs_private_impl__swizzle_src_over__composite_arm_neon(
+        vmulq_n_u16(vmovl_u8(d8.val[1]), 0x101), sg, sa, ia, src_premul);
+    o8.val[2] = wuffs_private_impl__swizzle_src_over__composite_arm_neon(
+        vmulq_n_u16(vmovl_u8(d8.val[2]), 0x101), sr, sa, ia, src_premul);
+    o8.val[3] = wuffs_private_impl__swizzle_src_over__composite_arm_neon(
+        vmulq_n_u16(vmovl_u8(d8.val[3]), 0x101), src_premul ? sa : uFFFF, sa,
+        ia, src_premul);
+    vst4_u8(d, o8);
+
+    s += 8 * src_bpp;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_src_over__bgra_premul_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, false, false, false);
+  return n + wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src_over(
+                 dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_src_over__bgra_premul_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, true, false, false);
+  return n +
+         wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src_over(
+             dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+             dst_palette_len, src_ptr + (8 * n), src_len - (8 * n));
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_src_over__bgra_premul_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, false, true, false);
+  return n + wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over(
+                 dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_premul_4x16le__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_src_over__bgra_premul_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, true, true, false);
+  return n +
+         wuffs_private_impl__swizzle_bgra_premul__bgra_premul_4x16le__src_over(
+             dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+             dst_palette_len, src_ptr + (8 * n), src_len - (8 * n));
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_src_over__bgra_premul_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, false, false, true);
+  return n + wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src_over(
+                 dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_src_over__bgra_premul_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, true, false, true);
+  return n +
+         wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src_over(
+             dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+             dst_palette_len, src_ptr + (8 * n), src_len - (8 * n));
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_src_over__bgra_premul_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, false, true, true);
+  return n + wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over(
+                 dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_premul_4x16le__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_src_over__bgra_premul_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, true, true, true);
+  return n +
+         wuffs_private_impl__swizzle_bgra_premul__rgba_premul_4x16le__src_over(
+             dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+             dst_palette_len, src_ptr + (8 * n), src_len - (8 * n));
+}
+
+// --------
+
+// The arm_neon code below implements the most commonly used SRC swizzlers,
+// like the equivalent x86_avx2 code. vld3, vld4, vst3 and vst4 de-interleave
+// and re-interleave the channels, so that converting between 1, 3 and 4 bytes
+// per pixel, or swapping the b and r channels, costs nothing extra. The output
+// matches the non-SIMD code exactly, apart from saturating instead of
+// overflowing for invalid (color > alpha) premul input.
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgrw__bgr__arm_neon(uint8_t* dst_ptr,
+                                                size_t dst_len,
+                                                uint8_t* dst_palette_ptr,
+                                                size_t dst_palette_len,
+                                                const uint8_t* src_ptr,
+                                                size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 16) {
+    uint8x16x3_t s3 = vld3q_u8(s);
+    uint8x16x4_t d4;
+    d4.val[0] = s3.val[0];
+    d4.val[1] = s3.val[1];
+    d4.val[2] = s3.val[2];
+    d4.val[3] = vdupq_n_u8(0xFF);
+    vst4q_u8(d, d4);
+
+    s += 16 * 3;
+    d += 16 * 4;
+    n -= 16;
+  }
+
+  return (len - n) + wuffs_private_impl__swizzle_bgrw__bgr(
+                         d, 4 * n, dst_palette_ptr, dst_palette_len, s, 3 * n);
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgrw__rgb__arm_neon(uint8_t* dst_ptr,
+                                                size_t dst_len,
+                                                uint8_t* dst_palette_ptr,
+                                                size_t dst_palette_len,
+                                                const uint8_t* src_ptr,
+                                                size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 16) {
+    uint8x16x3_t s3 = vld3q_u8(s);
+    uint8x16x4_t d4;
+    d4.val[0] = s3.val[2];
+    d4.val[1] = s3.val[1];
+    d4.val[2] = s3.val[0];
+    d4.val[3] = vdupq_n_u8(0xFF);
+    vst4q_u8(d, d4);
+
+    s += 16 * 3;
+    d += 16 * 4;
+    n -= 16;
+  }
+
+  return (len - n) + wuffs_private_impl__swizzle_bgrw__rgb(
+                         d, 4 * n, dst_palette_ptr, dst_palette_len, s, 3 * n);
+}
+
+// wuffs_private_impl__swizzle_xxx__xxxx_shuffle_arm_neon drops the fourth
+// byte of each pixel, optionally swapping the first and third bytes.
+static inline WUFFS_BASE__FORCE_INLINE size_t  //
+wuffs_private_impl__swizzle_xxx__xxxx_shuffle_arm_neon(uint8_t* dst_ptr,
+                                                       size_t dst_len,
+                                                       const uint8_t* src_ptr,
+                                                       size_t src_len,
+                                                       bool swap_rb) {
+  size_t dst_len3 = dst_len / 3;
+  size_t src_len4 = src_len / 4;
+  size_t len = ((dst_len3 < src_len4) ? dst_len3 : src_len4) & ~(size_t)15u;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 16) {
+    uint8x16x4_t s4 = vld4q_u8(s);
+    uint8x16x3_t d3;
+    d3.val[0] = s4.val[swap_rb ? 2 : 0];
+    d3.val[1] = s4.val[1];
+    d3.val[2] = s4.val[swap_rb ? 0 : 2];
+    vst3q_u8(d, d3);
+
+    s += 16 * 4;
+    d += 16 * 3;
+    n -= 16;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_xxx__xxxx__arm_neon(uint8_t* dst_ptr,
+                                                size_t dst_len,
+                                                uint8_t* dst_palette_ptr,
+                                                size_t dst_palette_len,
+                                                const uint8_t* src_ptr,
+                                                size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_xxx__xxxx_shuffle_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, false);
+  return n + wuffs_private_impl__swizzle_xxx__xxxx(
+                 dst_ptr + (3 * n), dst_len - (3 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgr__rgba_premul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_xxx__xxxx_shuffle_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, true);
+  return n + wuffs_private_impl__swizzle_bgr__rgba_premul__src(
+                 dst_ptr + (3 * n), dst_len - (3 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_xxxx__y__arm_neon(uint8_t* dst_ptr,
+                                              size_t dst_len,
+                                              uint8_t* dst_palette_ptr,
+                                              size_t dst_palette_len,
+                                              const uint8_t* src_ptr,
+                                              size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t len = (dst_len4 < src_len) ? dst_len4 : src_len;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 16) {
+    uint8x16_t y = vld1q_u8(s);
+    uint8x16x4_t d4;
+    d4.val[0] = y;
+    d4.val[1] = y;
+    d4.val[2] = y;
+    d4.val[3] = vdupq_n_u8(0xFF);
+    vst4q_u8(d, d4);
+
+    s += 16 * 1;
+    d += 16 * 4;
+    n -= 16;
+  }
+
+  return (len - n) + wuffs_private_impl__swizzle_xxxx__y(
+                         d, 4 * n, dst_palette_ptr, dst_palette_len, s, n);
+}
+
+// wuffs_private_impl__swizzle_premul__convert_arm_neon converts one channel
+// of 8 pixels, given as 16-bit nonpremul color and alpha, to 8-bit premul
+// color: ((c * a) / 0xFFFF) >> 8, like
+// wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul.
+static inline uint8x8_t  //
+wuffs_private_impl__swizzle_premul__convert_arm_neon(uint16x8_t c,
+                                                     uint16x8_t a) {
+  return vshrn_n_u16(
+      vcombine_u16(wuffs_private_impl__swizzle_src_over__div_ffff_arm_neon(
+                       vmull_u16(vget_low_u16(c), vget_low_u16(a))),
+                   wuffs_private_impl__swizzle_src_over__div_ffff_arm_neon(
+                       vmull_u16(vget_high_u16(c), vget_high_u16(a)))),
+      8);
+}
+
+// wuffs_private_impl__swizzle_premul__nonpremul_arm_neon converts groups of 8
+// pixels from nonpremul (4 or 8 bytes per pixel) to 8-bit BGRA premul and
+// returns the number of pixels processed, a multiple of 8.
+static inline WUFFS_BASE__FORCE_INLINE size_t  //
+wuffs_private_impl__swizzle_premul__nonpremul_arm_neon(uint8_t* dst_ptr,
+                                                       size_t dst_len,
+                                                       const uint8_t* src_ptr,
+                                                       size_t src_len,
+                                                       bool src_4x16le,
+                                                       bool src_swap_rb) {
+  size_t src_bpp = src_4x16le ? 8u : 4u;
+  size_t dst_len4 = dst_len / 4;
+  size_t src_lenx = src_len / src_bpp;
+  size_t len = ((dst_len4 < src_lenx) ? dst_len4 : src_lenx) & ~(size_t)7u;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint16x8_t sb;
+    uint16x8_t sg;
+    uint16x8_t sr;
+    uint16x8_t sa;
+
+    if (src_4x16le) {
+      uint16x8x4_t s16 = vld4q_u16((const uint16_t*)(const void*)s);
+      sb = s16.val[src_swap_rb ? 2 : 0];
+      sg = s16.val[1];
+      sr = s16.val[src_swap_rb ? 0 : 2];
+      sa = s16.val[3];
+
+    } else {
+      uint8x8x4_t s8 = vld4_u8(s);
+      if (src_swap_rb) {
+        uint8x8_t tmp = s8.val[0];
+        s8.val[0] = s8.val[2];
+        s8.val[2] = tmp;
+      }
+
+      // Fast path: fully opaque pixels are unchanged.
+      if (vget_lane_u64(vreinterpret_u64_u8(s8.val[3]), 0) ==
+          0xFFFFFFFFFFFFFFFFu) {
+        vst4_u8(d, s8);
+        s += 8 * 4;
+        d += 8 * 4;
+        n -= 8;
+        continue;
+      }
+
+      sb = vmulq_n_u16(vmovl_u8(s8.val[0]), 0x101);
+      sg = vmulq_n_u16(vmovl_u8(s8.val[1]), 0x101);
+      sr = vmulq_n_u16(vmovl_u8(s8.val[2]), 0x101);
+      sa = vmulq_n_u16(vmovl_u8(s8.val[3]), 0x101);
+    }
+
+    uint8x8x4_t o8;
+    o8.val[0] = wuffs_private_impl__swizzle_premul__convert_arm_neon(sb, sa);
+    o8.val[1] = wuffs_private_impl__swizzle_premul__convert_arm_neon(sg, sa);
+    o8.val[2] = wuffs_private_impl__swizzle_premul__convert_arm_neon(sr, sa);
+    o8.val[3] = vshrn_n_u16(sa, 8);
+    vst4_u8(d, o8);
+
+    s += 8 * src_bpp;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  return len;
+}
+
+// vdivq_f32 is AArch64-only.
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON_A64)
+
+// wuffs_private_impl__swizzle_nonpremul__convert_arm_neon converts one
+// channel of 8 pixels from 8-bit premul to 8-bit nonpremul color, like
+// wuffs_base__color_u32_argb_premul__as__color_u32_argb_nonpremul. a holds
+// the pixels' alpha, den_lo and den_hi hold (a * 0x100) as floats and a_mask
+// is 0xFF where a is non-zero. See
+// wuffs_private_impl__swizzle_nonpremul__convert_x86_avx2 for why clamping c
+// to a and then dividing in float32 gives exactly the same result as the
+// non-SIMD code.
+static inline uint8x8_t  //
+wuffs_private_impl__swizzle_nonpremul__convert_arm_neon(uint8x8_t c,
+                                                        uint8x8_t a,
+                                                        float32x4_t den_lo,
+                                                        float32x4_t den_hi,
+                                                        uint8x8_t a_mask) {
+  uint16x8_t c16 = vmovl_u8(vmin_u8(c, a));
+  uint32x4_t q_lo = vcvtq_u32_f32(vdivq_f32(
+      vcvtq_f32_u32(vmulq_n_u32(vmovl_u16(vget_low_u16(c16)), 0xFFFF)),
+      den_lo));
+  uint32x4_t q_hi = vcvtq_u32_f32(vdivq_f32(
+      vcvtq_f32_u32(vmulq_n_u32(vmovl_u16(vget_high_u16(c16)), 0xFFFF)),
+      den_hi));
+  return vand_u8(
+      vqmovn_u16(vcombine_u16(vqmovn_u32(q_lo), vqmovn_u32(q_hi))), a_mask);
+}
+
+// wuffs_private_impl__swizzle_nonpremul__premul_arm_neon converts groups of 8
+// pixels from 8-bit premul to 8-bit BGRA nonpremul and returns the number of
+// pixels processed, a multiple of 8.
+static inline WUFFS_BASE__FORCE_INLINE size_t  //
+wuffs_private_impl__swizzle_nonpremul__premul_arm_neon(uint8_t* dst_ptr,
+                                                       size_t dst_len,
+                                                       const uint8_t* src_ptr,
+                                                       size_t src_len,
+                                                       bool src_swap_rb) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = ((dst_len4 < src_len4) ? dst_len4 : src_len4) & ~(size_t)7u;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint8x8x4_t s8 = vld4_u8(s);
+    if (src_swap_rb) {
+      uint8x8_t tmp = s8.val[0];
+      s8.val[0] = s8.val[2];
+      s8.val[2] = tmp;
+    }
+
+    // Fast path: fully opaque pixels are unchanged.
+    if (vget_lane_u64(vreinterpret_u64_u8(s8.val[3]), 0) ==
+        0xFFFFFFFFFFFFFFFFu) {
+      vst4_u8(d, s8);
+      s += 8 * 4;
+      d += 8 * 4;
+      n -= 8;
+      continue;
+    }
+
+    uint16x8_t a16 = vmovl_u8(s8.val[3]);
+    float32x4_t den_lo = vcvtq_f32_u32(vshll_n_u16(vget_low_u16(a16), 8));
+    float32x4_t den_hi = vcvtq_f32_u32(vshll_n_u16(vget_high_u16(a16), 8));
+    uint8x8_t a_mask = vtst_u8(s8.val[3], s8.val[3]);
+
+    uint8x8x4_t o8;
+    o8.val[0] = wuffs_private_impl__swizzle_nonpremul__convert_arm_neon(
+        s8.val[0], s8.val[3], den_lo, den_hi, a_mask);
+    o8.val[1] = wuffs_private_impl__swizzle_nonpremul__convert_arm_neon(
+        s8.val[1], s8.val[3], den_lo, den_hi, a_mask);
+    o8.val[2] = wuffs_private_impl__swizzle_nonpremul__convert_arm_neon(
+        s8.val[2], s8.val[3], den_lo, den_hi, a_mask);
+    o8.val[3] = s8.val[3];
+    vst4_u8(d, o8);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  return len;
+}
+
+#endif  // defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON_A64)
+
+// wuffs_private_impl__swizzle_narrow__4x16le_arm_neon converts groups of 8
+// pixels from 4x16le to 4x8 (keeping the high byte of each channel),
+// optionally swapping the first and third channels, and returns the number of
+// pixels processed, a multiple of 8.
+static inline WUFFS_BASE__FORCE_INLINE size_t  //
+wuffs_private_impl__swizzle_narrow__4x16le_arm_neon(uint8_t* dst_ptr,
+                                                    size_t dst_len,
+                                                    const uint8_t* src_ptr,
+                                                    size_t src_len,
+                                                    bool swap_rb) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = ((dst_len4 < src_len8) ? dst_len4 : src_len8) & ~(size_t)7u;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint16x8x4_t s16 = vld4q_u16((const uint16_t*)(const void*)s);
+    uint8x8x4_t o8;
+    o8.val[0] = vshrn_n_u16(s16.val[swap_rb ? 2 : 0], 8);
+    o8.val[1] = vshrn_n_u16(s16.val[1], 8);
+    o8.val[2] = vshrn_n_u16(s16.val[swap_rb ? 0 : 2], 8);
+    o8.val[3] = vshrn_n_u16(s16.val[3], 8);
+    vst4_u8(d, o8);
+
+    s += 8 * 8;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_premul__nonpremul_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, false, false);
+  return n + wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src(
+                 dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_premul__nonpremul_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, false, true);
+  return n + wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src(
+                 dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_premul__nonpremul_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, true, false);
+  return n +
+         wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src(
+             dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+             dst_palette_len, src_ptr + (8 * n), src_len - (8 * n));
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_premul__nonpremul_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, true, true);
+  return n +
+         wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src(
+             dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+             dst_palette_len, src_ptr + (8 * n), src_len - (8 * n));
+}
+
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON_A64)
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_nonpremul__premul_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, false);
+  return n + wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src(
+                 dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_nonpremul__premul_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, true);
+  return n + wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src(
+                 dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+#endif  // defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON_A64)
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_nonpremul__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_narrow__4x16le_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, false);
+  return n +
+         wuffs_private_impl__swizzle_bgra_nonpremul__bgra_nonpremul_4x16le__src(
+             dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+             dst_palette_len, src_ptr + (8 * n), src_len - (8 * n));
+}
+
+static uint64_t  //
+wuffs_private_impl__swizzle_rgba_nonpremul__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_narrow__4x16le_arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, true);
+  return n +
+         wuffs_private_impl__swizzle_rgba_nonpremul__bgra_nonpremul_4x16le__src(
+             dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+             dst_palette_len, src_ptr + (8 * n), src_len - (8 * n));
+}
+#endif  // defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
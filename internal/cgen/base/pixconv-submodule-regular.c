@@ -47,6 +47,411 @@ wuffs_private_impl__swizzle_xxxx__y__x86_sse42(uint8_t* dst_ptr,
                                                size_t src_len);
 #endif  // defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V2)
 
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_premul_4x16le__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_premul_4x16le__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgr__rgba_premul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_nonpremul__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgrw__bgr__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgrw__rgb__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_rgba_nonpremul__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_xxx__xxxx__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_xxxx__y__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+#endif  // defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_premul_4x16le__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_premul_4x16le__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgr__rgba_premul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_nonpremul__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON_A64)
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+#endif  // defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON_A64)
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgrw__bgr__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_bgrw__rgb__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_rgba_nonpremul__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_xxx__xxxx__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_private_impl__swizzle_xxxx__y__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+#endif  // defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+
 // --------
 
 static inline uint32_t  //
@@ -6409,6 +6814,16 @@ wuffs_private_impl__pixel_swizzler__prepare__y(
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        return wuffs_private_impl__swizzle_xxxx__y__x86_avx2;
+      }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+      if (wuffs_base__cpu_arch__have_arm_neon()) {
+        return wuffs_private_impl__swizzle_xxxx__y__arm_neon;
+      }
+#endif
 #if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V2)
       if (wuffs_base__cpu_arch__have_x86_sse42()) {
         return wuffs_private_impl__swizzle_xxxx__y__x86_sse42;
@@ -6973,6 +7388,16 @@ wuffs_private_impl__pixel_swizzler__prepare__bgr(
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        return wuffs_private_impl__swizzle_bgrw__bgr__x86_avx2;
+      }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+      if (wuffs_base__cpu_arch__have_arm_neon()) {
+        return wuffs_private_impl__swizzle_bgrw__bgr__arm_neon;
+      }
+#endif
 #if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V2)
       if (wuffs_base__cpu_arch__have_x86_sse42()) {
         return wuffs_private_impl__swizzle_bgrw__bgr__x86_sse42;
@@ -6991,6 +7416,16 @@ wuffs_private_impl__pixel_swizzler__prepare__bgr(
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        return wuffs_private_impl__swizzle_bgrw__rgb__x86_avx2;
+      }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+      if (wuffs_base__cpu_arch__have_arm_neon()) {
+        return wuffs_private_impl__swizzle_bgrw__rgb__arm_neon;
+      }
+#endif
 #if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V2)
       if (wuffs_base__cpu_arch__have_x86_sse42()) {
         return wuffs_private_impl__swizzle_bgrw__rgb__x86_sse42;
@@ -7057,8 +7492,28 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_nonpremul(
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src_over__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src_over;
       }
       return NULL;
@@ -7094,8 +7549,28 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_nonpremul(
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src_over__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src_over;
       }
       return NULL;
@@ -7146,6 +7621,16 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_nonpremul_4x16le(
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_nonpremul__bgra_nonpremul_4x16le__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_nonpremul__bgra_nonpremul_4x16le__src__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_nonpremul__bgra_nonpremul_4x16le__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_private_impl__swizzle_bgra_nonpremul__bgra_nonpremul_4x16le__src_over;
@@ -7164,8 +7649,28 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_nonpremul_4x16le(
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src_over__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src_over;
       }
       return NULL;
@@ -7187,6 +7692,16 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_nonpremul_4x16le(
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_rgba_nonpremul__bgra_nonpremul_4x16le__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_rgba_nonpremul__bgra_nonpremul_4x16le__src__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_rgba_nonpremul__bgra_nonpremul_4x16le__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_private_impl__swizzle_rgba_nonpremul__bgra_nonpremul_4x16le__src_over;
@@ -7196,8 +7711,28 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_nonpremul_4x16le(
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src_over__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src_over;
       }
       return NULL;
@@ -7239,6 +7774,16 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_premul(
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_xxx__xxxx__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_xxx__xxxx__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgr__bgra_premul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_private_impl__swizzle_bgr__bgra_premul__src_over;
@@ -7248,6 +7793,16 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_premul(
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON_A64)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src_over;
@@ -7268,6 +7823,16 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_premul(
         case WUFFS_BASE__PIXEL_BLEND__SRC:
           return wuffs_private_impl__swizzle_copy_4_4;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over;
       }
       return NULL;
@@ -7275,6 +7840,16 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_premul(
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgr__rgba_premul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgr__rgba_premul__src__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgr__rgba_premul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_private_impl__swizzle_bgr__rgba_premul__src_over;
@@ -7284,6 +7859,16 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_premul(
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON_A64)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src_over;
@@ -7300,6 +7885,16 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_premul(
 #endif
           return wuffs_private_impl__swizzle_swap_rgbx_bgrx;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over;
       }
       return NULL;
@@ -7366,6 +7961,16 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_premul_4x16le(
         case WUFFS_BASE__PIXEL_BLEND__SRC:
           return wuffs_private_impl__swizzle_bgra_premul__bgra_premul_4x16le__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_premul_4x16le__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_premul_4x16le__src_over__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__bgra_premul_4x16le__src_over;
       }
       return NULL;
@@ -7407,6 +8012,16 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_premul_4x16le(
         case WUFFS_BASE__PIXEL_BLEND__SRC:
           return wuffs_private_impl__swizzle_bgra_premul__rgba_premul_4x16le__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_premul_4x16le__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_premul_4x16le__src_over__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__rgba_premul_4x16le__src_over;
       }
       return NULL;
@@ -7448,6 +8063,16 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_binary(
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_xxx__xxxx__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_xxx__xxxx__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgr__bgra_premul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_private_impl__swizzle_bgr__bgra_premul__src_over;
@@ -7478,6 +8103,16 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_binary(
         case WUFFS_BASE__PIXEL_BLEND__SRC:
           return wuffs_private_impl__swizzle_copy_4_4;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over;
       }
       return NULL;
@@ -7485,6 +8120,16 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_binary(
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgr__rgba_premul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgr__rgba_premul__src__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgr__rgba_premul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_private_impl__swizzle_bgr__rgba_premul__src_over;
@@ -7515,6 +8160,16 @@ wuffs_private_impl__pixel_swizzler__prepare__bgra_binary(
 #endif
           return wuffs_private_impl__swizzle_swap_rgbx_bgrx;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over;
       }
       return NULL;
@@ -7537,6 +8192,16 @@ wuffs_private_impl__pixel_swizzler__prepare__bgrx(
       return wuffs_private_impl__swizzle_bgr_565__bgrx;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        return wuffs_private_impl__swizzle_xxx__xxxx__x86_avx2;
+      }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+      if (wuffs_base__cpu_arch__have_arm_neon()) {
+        return wuffs_private_impl__swizzle_xxx__xxxx__arm_neon;
+      }
+#endif
       return wuffs_private_impl__swizzle_xxx__xxxx;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
@@ -7583,6 +8248,16 @@ wuffs_private_impl__pixel_swizzler__prepare__rgb(
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        return wuffs_private_impl__swizzle_bgrw__rgb__x86_avx2;
+      }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+      if (wuffs_base__cpu_arch__have_arm_neon()) {
+        return wuffs_private_impl__swizzle_bgrw__rgb__arm_neon;
+      }
+#endif
 #if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V2)
       if (wuffs_base__cpu_arch__have_x86_sse42()) {
         return wuffs_private_impl__swizzle_bgrw__rgb__x86_sse42;
@@ -7600,6 +8275,16 @@ wuffs_private_impl__pixel_swizzler__prepare__rgb(
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        return wuffs_private_impl__swizzle_bgrw__bgr__x86_avx2;
+      }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+      if (wuffs_base__cpu_arch__have_arm_neon()) {
+        return wuffs_private_impl__swizzle_bgrw__bgr__arm_neon;
+      }
+#endif
 #if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V2)
       if (wuffs_base__cpu_arch__have_x86_sse42()) {
         return wuffs_private_impl__swizzle_bgrw__bgr__x86_sse42;
@@ -7671,8 +8356,28 @@ wuffs_private_impl__pixel_swizzler__prepare__rgba_nonpremul(
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src_over__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src_over;
       }
       return NULL;
@@ -7703,8 +8408,28 @@ wuffs_private_impl__pixel_swizzler__prepare__rgba_nonpremul(
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src_over__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src_over;
       }
       return NULL;
@@ -7746,6 +8471,16 @@ wuffs_private_impl__pixel_swizzler__prepare__rgba_premul(
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgr__rgba_premul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgr__rgba_premul__src__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgr__rgba_premul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_private_impl__swizzle_bgr__rgba_premul__src_over;
@@ -7755,6 +8490,16 @@ wuffs_private_impl__pixel_swizzler__prepare__rgba_premul(
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON_A64)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src_over;
@@ -7780,6 +8525,16 @@ wuffs_private_impl__pixel_swizzler__prepare__rgba_premul(
 #endif
           return wuffs_private_impl__swizzle_swap_rgbx_bgrx;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over;
       }
       return NULL;
@@ -7787,6 +8542,16 @@ wuffs_private_impl__pixel_swizzler__prepare__rgba_premul(
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_xxx__xxxx__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_xxx__xxxx__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgr__bgra_premul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_private_impl__swizzle_bgr__bgra_premul__src_over;
@@ -7796,6 +8561,16 @@ wuffs_private_impl__pixel_swizzler__prepare__rgba_premul(
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON_A64)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src_over;
@@ -7807,6 +8582,16 @@ wuffs_private_impl__pixel_swizzler__prepare__rgba_premul(
         case WUFFS_BASE__PIXEL_BLEND__SRC:
           return wuffs_private_impl__swizzle_copy_4_4;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over__arm_neon;
+          }
+#endif
           return wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over;
       }
       return NULL;
@@ -8064,6 +8849,130 @@ wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
   return 0;
 }
 
+// wuffs_private_impl__pixel_swizzler__swizzle_rect converts height rows of
+// pixels. Each row's dst and src spans are dst_row_len and src_row_len bytes
+// long and consecutive rows are dst_stride and src_stride bytes apart.
+static uint64_t  //
+wuffs_private_impl__pixel_swizzler__swizzle_rect(
+    const wuffs_base__pixel_swizzler* p,
+    uint8_t* dst_ptr,
+    size_t dst_row_len,
+    size_t dst_stride,
+    wuffs_base__slice_u8 dst_palette,
+    const uint8_t* src_ptr,
+    size_t src_row_len,
+    size_t src_stride,
+    size_t height) {
+  wuffs_base__pixel_swizzler__func func = p->private_impl.func;
+  size_t dst_bpp = p->private_impl.dst_pixfmt_bytes_per_pixel;
+  size_t src_bpp = p->private_impl.src_pixfmt_bytes_per_pixel;
+  if (height == 0) {
+    return 0;
+  }
+
+  // When both sides' rows are contiguous (their length equals their stride)
+  // and hold the same number of pixels, the rows collapse into one long span
+  // and a single call converts the whole rectangle.
+  if ((dst_row_len == dst_stride) && (src_row_len == src_stride) &&  //
+      (dst_bpp > 0) && ((dst_row_len % dst_bpp) == 0) &&              //
+      (src_bpp > 0) && ((src_row_len % src_bpp) == 0) &&              //
+      ((dst_row_len / dst_bpp) == (src_row_len / src_bpp))) {
+    return (*func)(dst_ptr, dst_row_len * height, dst_palette.ptr,
+                   dst_palette.len, src_ptr, src_row_len * height);
+  }
+
+  uint64_t n = 0;
+  for (size_t y = 0; y < height; y++) {
+    n += (*func)(dst_ptr, dst_row_len, dst_palette.ptr, dst_palette.len,
+                 src_ptr, src_row_len);
+    dst_ptr += dst_stride;
+    src_ptr += src_stride;
+  }
+  return n;
+}
+
+// wuffs_private_impl__pixel_swizzler__swizzle_rows converts src pixels,
+// packed as rows as wide as the dst table, to fill the dst table's rows in
+// order. The final row written to may be partially filled.
+static uint64_t  //
+wuffs_private_impl__pixel_swizzler__swizzle_rows(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__table_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_bpp = p->private_impl.dst_pixfmt_bytes_per_pixel;
+  size_t src_bpp = p->private_impl.src_pixfmt_bytes_per_pixel;
+  if ((dst_bpp == 0) || (src_bpp == 0)) {
+    return 0;
+  }
+  size_t width = dst.width / dst_bpp;
+  if ((width == 0) || (width > (SIZE_MAX / src_bpp))) {
+    return 0;
+  }
+  size_t dst_row_len = width * dst_bpp;
+  size_t src_row_len = width * src_bpp;
+
+  size_t num_whole_rows = src_len / src_row_len;
+  if (num_whole_rows > dst.height) {
+    num_whole_rows = dst.height;
+  }
+  uint64_t n = wuffs_private_impl__pixel_swizzler__swizzle_rect(
+      p, dst.ptr, dst_row_len, dst.stride, dst_palette, src_ptr, src_row_len,
+      src_row_len, num_whole_rows);
+  if (num_whole_rows < dst.height) {
+    n += (*p->private_impl.func)(
+        dst.ptr + (num_whole_rows * dst.stride), dst_row_len, dst_palette.ptr,
+        dst_palette.len, src_ptr + (num_whole_rows * src_row_len),
+        src_len - (num_whole_rows * src_row_len));
+  }
+  return n;
+}
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_from_table(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__table_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__table_u8 src) {
+  if (p && p->private_impl.func) {
+    return wuffs_private_impl__pixel_swizzler__swizzle_rect(
+        p, dst.ptr, dst.width, dst.stride, dst_palette, src.ptr, src.width,
+        src.stride, (dst.height < src.height) ? dst.height : src.height);
+  }
+  return 0;
+}
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_rows_from_reader(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__table_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    const uint8_t** ptr_iop_r,
+    const uint8_t* io2_r) {
+  if (p && p->private_impl.func) {
+    const uint8_t* iop_r = *ptr_iop_r;
+    uint64_t n = wuffs_private_impl__pixel_swizzler__swizzle_rows(
+        p, dst, dst_palette, iop_r, (size_t)(io2_r - iop_r));
+    *ptr_iop_r += n * p->private_impl.src_pixfmt_bytes_per_pixel;
+    return n;
+  }
+  return 0;
+}
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_rows_from_slice(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__table_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src) {
+  if (p && p->private_impl.func) {
+    return wuffs_private_impl__pixel_swizzler__swizzle_rows(
+        p, dst, dst_palette, src.ptr, src.len);
+  }
+  return 0;
+}
+
 WUFFS_BASE__MAYBE_STATIC uint64_t  //
 wuffs_base__pixel_swizzler__swizzle_interleaved_transparent_black(
     const wuffs_base__pixel_swizzler* p,
@@ -433,6 +433,356 @@ wuffs_private_impl__swizzle_ycc__convert_3_rgbx_x86_avx2(
   }
 }
 
+// wuffs_private_impl__swizzle_cmyk__scale_x86_avx2 returns (((a * w) + 0x7F)
+// / 0xFF) for each u16x16 element, where both a and w are in the range 0x00
+// ..= 0xFF. With t = ((a * w) + 0x80), that's ((t + (t >> 8)) >> 8), which
+// fits in 16 bits and matches the non-SIMD code exactly.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m256i  //
+wuffs_private_impl__swizzle_cmyk__scale_x86_avx2(__m256i a, __m256i w) {
+  __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(a, w),  //
+                               _mm256_set1_epi16(0x0080));
+  return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+// wuffs_private_impl__swizzle_cmyk__store_x86_avx2 interleaves 16 pixels'
+// worth of u16x16 channel values (in the range 0x00 ..= 0xFF), plus an opaque
+// alpha channel, writing 64 bytes to dst_ptr. The ch0 values are written
+// first, so that passing (bb, gg, rr) writes BGRX and (rr, gg, bb) writes
+// RGBX.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline void  //
+wuffs_private_impl__swizzle_cmyk__store_x86_avx2(uint8_t* dst_ptr,
+                                                 __m256i ch0,
+                                                 __m256i ch1,
+                                                 __m256i ch2) {
+  // c01 = u16x16 [ch0.00|(ch1.00<<8) .. ch0.0F|(ch1.0F<<8)]
+  // c23 = u16x16 [ch2.00|0xFF00      .. ch2.0F|0xFF00     ]
+  __m256i c01 = _mm256_or_si256(ch0, _mm256_slli_epi16(ch1, 8));
+  __m256i c23 = _mm256_or_si256(ch2, _mm256_set1_epi16(-0x0100));
+
+  // lo = u32x8 [px.00 px.01 px.02 px.03  px.08 px.09 px.0A px.0B]
+  // hi = u32x8 [px.04 px.05 px.06 px.07  px.0C px.0D px.0E px.0F]
+  __m256i lo = _mm256_unpacklo_epi16(c01, c23);
+  __m256i hi = _mm256_unpackhi_epi16(c01, c23);
+
+  _mm256_storeu_si256((__m256i*)(void*)(dst_ptr + 0x00),
+                      _mm256_permute2x128_si256(lo, hi, 0x20));
+  _mm256_storeu_si256((__m256i*)(void*)(dst_ptr + 0x20),
+                      _mm256_permute2x128_si256(lo, hi, 0x31));
+}
+
+// wuffs_private_impl__swizzle_ycc__narrow_16_16_x86_avx2 shifts two i32x8
+// vectors (of 16.16 fixed point values) right by 16, clamps to 0x00 ..= 0xFF
+// and returns the result as an u16x16 vector. Like the arm_neon equivalent,
+// that clamping matches wuffs_base__color_ycc__as__color_u32 exactly.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m256i  //
+wuffs_private_impl__swizzle_ycc__narrow_16_16_x86_avx2(__m256i lo,
+                                                       __m256i hi) {
+  // _mm256_packus_epi32 works per 128-bit lane. The 0xD8 permutation puts the
+  // four 64-bit quarters back in order.
+  __m256i packed = _mm256_packus_epi32(_mm256_srai_epi32(lo, 16),
+                                       _mm256_srai_epi32(hi, 16));
+  return _mm256_min_epu16(_mm256_permute4x64_epi64(packed, 0xD8),
+                          _mm256_set1_epi16(0x00FF));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_cmyk__convert_4_bgrx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  if ((x + 16u) > x_end) {
+    wuffs_private_impl__swizzle_cmyk__convert_4_general(  //
+        dst, x, x_end, y, up0, up1, up2, up3);
+    return;
+  }
+
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  while (x < x_end) {
+    // Load 16 samples from each channel, zero-extended to u16x16. As per
+    // wuffs_private_impl__swizzle_cmyk__convert_4_general, "CMYK" is really
+    // RGBW and the inversions cancel out.
+    __m256i rr = _mm256_cvtepu8_epi16(
+        _mm_lddqu_si128((const __m128i*)(const void*)up0));
+    __m256i gg = _mm256_cvtepu8_epi16(
+        _mm_lddqu_si128((const __m128i*)(const void*)up1));
+    __m256i bb = _mm256_cvtepu8_epi16(
+        _mm_lddqu_si128((const __m128i*)(const void*)up2));
+    __m256i ww = _mm256_cvtepu8_epi16(
+        _mm_lddqu_si128((const __m128i*)(const void*)up3));
+
+    wuffs_private_impl__swizzle_cmyk__store_x86_avx2(
+        dst_iter,                                                  //
+        wuffs_private_impl__swizzle_cmyk__scale_x86_avx2(bb, ww),  //
+        wuffs_private_impl__swizzle_cmyk__scale_x86_avx2(gg, ww),  //
+        wuffs_private_impl__swizzle_cmyk__scale_x86_avx2(rr, ww));
+
+    // Advance by up to 16 pixels. The first iteration might be smaller than
+    // 16 so that all of the remaining steps are exactly 16.
+    uint32_t n = 16u - (15u & (x - x_end));
+    dst_iter += 4u * n;
+    up0 += n;
+    up1 += n;
+    up2 += n;
+    up3 += n;
+    x += n;
+  }
+}
+
+// The rgbx flavor (below) is exactly the same as the bgrx flavor (above)
+// except for the lines marked with a § and that comments were stripped.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_cmyk__convert_4_rgbx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  if ((x + 16u) > x_end) {
+    wuffs_private_impl__swizzle_cmyk__convert_4_general(  //
+        dst, x, x_end, y, up0, up1, up2, up3);
+    return;
+  }
+
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  while (x < x_end) {
+    __m256i rr = _mm256_cvtepu8_epi16(
+        _mm_lddqu_si128((const __m128i*)(const void*)up0));
+    __m256i gg = _mm256_cvtepu8_epi16(
+        _mm_lddqu_si128((const __m128i*)(const void*)up1));
+    __m256i bb = _mm256_cvtepu8_epi16(
+        _mm_lddqu_si128((const __m128i*)(const void*)up2));
+    __m256i ww = _mm256_cvtepu8_epi16(
+        _mm_lddqu_si128((const __m128i*)(const void*)up3));
+
+    wuffs_private_impl__swizzle_cmyk__store_x86_avx2(
+        dst_iter,                                                  //
+        wuffs_private_impl__swizzle_cmyk__scale_x86_avx2(rr, ww),  // §
+        wuffs_private_impl__swizzle_cmyk__scale_x86_avx2(gg, ww),  //
+        wuffs_private_impl__swizzle_cmyk__scale_x86_avx2(bb, ww));  // §
+
+    uint32_t n = 16u - (15u & (x - x_end));
+    dst_iter += 4u * n;
+    up0 += n;
+    up1 += n;
+    up2 += n;
+    up3 += n;
+    x += n;
+  }
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_ycck__convert_4_bgrx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  if ((x + 16u) > x_end) {
+    wuffs_private_impl__swizzle_ycck__convert_4_general(  //
+        dst, x, x_end, y, up0, up1, up2, up3);
+    return;
+  }
+
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  const __m256i u00000080 = _mm256_set1_epi32(0x0080);
+  const __m256i u00008000 = _mm256_set1_epi32(0x8000);
+  const __m256i u000166E9 = _mm256_set1_epi32(0x166E9);
+  const __m256i u0000581A = _mm256_set1_epi32(0x0581A);
+  const __m256i u0000B6D2 = _mm256_set1_epi32(0x0B6D2);
+  const __m256i u0001C5A2 = _mm256_set1_epi32(0x1C5A2);
+  const __m256i u00FF = _mm256_set1_epi16(0x00FF);
+
+  while (x < x_end) {
+    // Unlike convert_3_bgrx_x86_avx2, which works in 16-bit lanes, work in
+    // 32-bit lanes, using the same 16.16 fixed point arithmetic as
+    // wuffs_base__color_ycc__as__color_u32, so that the output is identical
+    // to the non-SIMD code. Each group of 16 pixels is split into _lo
+    // (elements 0 ..= 7) and _hi (elements 8 ..= 15) halves.
+    //
+    // yy_lo = i32x8 [(y.0 << 16) | 0x8000 .. (y.7 << 16) | 0x8000]
+    // cb_lo = i32x8 [cb.0 - 0x80           .. cb.7 - 0x80          ]
+    //
+    // Ditto for the cr_xx Chroma-Red values.
+    __m128i yy_all = _mm_lddqu_si128((const __m128i*)(const void*)up0);
+    __m128i cb_all = _mm_lddqu_si128((const __m128i*)(const void*)up1);
+    __m128i cr_all = _mm_lddqu_si128((const __m128i*)(const void*)up2);
+    __m256i yy_lo = _mm256_or_si256(
+        _mm256_slli_epi32(_mm256_cvtepu8_epi32(yy_all), 16), u00008000);
+    __m256i yy_hi = _mm256_or_si256(
+        _mm256_slli_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(yy_all, 8)), 16),
+        u00008000);
+    __m256i cb_lo = _mm256_sub_epi32(_mm256_cvtepu8_epi32(cb_all), u00000080);
+    __m256i cb_hi = _mm256_sub_epi32(
+        _mm256_cvtepu8_epi32(_mm_srli_si128(cb_all, 8)), u00000080);
+    __m256i cr_lo = _mm256_sub_epi32(_mm256_cvtepu8_epi32(cr_all), u00000080);
+    __m256i cr_hi = _mm256_sub_epi32(
+        _mm256_cvtepu8_epi32(_mm_srli_si128(cr_all, 8)), u00000080);
+
+    // R = Y                + 1.40200 * Cr
+    // G = Y - 0.34414 * Cb - 0.71414 * Cr
+    // B = Y + 1.77200 * Cb
+    __m256i rr_lo =
+        _mm256_add_epi32(yy_lo, _mm256_mullo_epi32(cr_lo, u000166E9));
+    __m256i rr_hi =
+        _mm256_add_epi32(yy_hi, _mm256_mullo_epi32(cr_hi, u000166E9));
+    __m256i gg_lo = _mm256_sub_epi32(
+        _mm256_sub_epi32(yy_lo, _mm256_mullo_epi32(cb_lo, u0000581A)),
+        _mm256_mullo_epi32(cr_lo, u0000B6D2));
+    __m256i gg_hi = _mm256_sub_epi32(
+        _mm256_sub_epi32(yy_hi, _mm256_mullo_epi32(cb_hi, u0000581A)),
+        _mm256_mullo_epi32(cr_hi, u0000B6D2));
+    __m256i bb_lo =
+        _mm256_add_epi32(yy_lo, _mm256_mullo_epi32(cb_lo, u0001C5A2));
+    __m256i bb_hi =
+        _mm256_add_epi32(yy_hi, _mm256_mullo_epi32(cb_hi, u0001C5A2));
+
+    // Narrow to u16x16 and invert: 0xFF means no ink instead of full ink.
+    __m256i rr = _mm256_sub_epi16(
+        u00FF, wuffs_private_impl__swizzle_ycc__narrow_16_16_x86_avx2(rr_lo,
+                                                                      rr_hi));
+    __m256i gg = _mm256_sub_epi16(
+        u00FF, wuffs_private_impl__swizzle_ycc__narrow_16_16_x86_avx2(gg_lo,
+                                                                      gg_hi));
+    __m256i bb = _mm256_sub_epi16(
+        u00FF, wuffs_private_impl__swizzle_ycc__narrow_16_16_x86_avx2(bb_lo,
+                                                                      bb_hi));
+    __m256i ww = _mm256_cvtepu8_epi16(
+        _mm_lddqu_si128((const __m128i*)(const void*)up3));
+
+    wuffs_private_impl__swizzle_cmyk__store_x86_avx2(
+        dst_iter,                                                  //
+        wuffs_private_impl__swizzle_cmyk__scale_x86_avx2(bb, ww),  //
+        wuffs_private_impl__swizzle_cmyk__scale_x86_avx2(gg, ww),  //
+        wuffs_private_impl__swizzle_cmyk__scale_x86_avx2(rr, ww));
+
+    // Advance by up to 16 pixels. The first iteration might be smaller than
+    // 16 so that all of the remaining steps are exactly 16.
+    uint32_t n = 16u - (15u & (x - x_end));
+    dst_iter += 4u * n;
+    up0 += n;
+    up1 += n;
+    up2 += n;
+    up3 += n;
+    x += n;
+  }
+}
+
+// The rgbx flavor (below) is exactly the same as the bgrx flavor (above)
+// except for the lines marked with a § and that comments were stripped.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_ycck__convert_4_rgbx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  if ((x + 16u) > x_end) {
+    wuffs_private_impl__swizzle_ycck__convert_4_general(  //
+        dst, x, x_end, y, up0, up1, up2, up3);
+    return;
+  }
+
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  const __m256i u00000080 = _mm256_set1_epi32(0x0080);
+  const __m256i u00008000 = _mm256_set1_epi32(0x8000);
+  const __m256i u000166E9 = _mm256_set1_epi32(0x166E9);
+  const __m256i u0000581A = _mm256_set1_epi32(0x0581A);
+  const __m256i u0000B6D2 = _mm256_set1_epi32(0x0B6D2);
+  const __m256i u0001C5A2 = _mm256_set1_epi32(0x1C5A2);
+  const __m256i u00FF = _mm256_set1_epi16(0x00FF);
+
+  while (x < x_end) {
+    __m128i yy_all = _mm_lddqu_si128((const __m128i*)(const void*)up0);
+    __m128i cb_all = _mm_lddqu_si128((const __m128i*)(const void*)up1);
+    __m128i cr_all = _mm_lddqu_si128((const __m128i*)(const void*)up2);
+    __m256i yy_lo = _mm256_or_si256(
+        _mm256_slli_epi32(_mm256_cvtepu8_epi32(yy_all), 16), u00008000);
+    __m256i yy_hi = _mm256_or_si256(
+        _mm256_slli_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(yy_all, 8)), 16),
+        u00008000);
+    __m256i cb_lo = _mm256_sub_epi32(_mm256_cvtepu8_epi32(cb_all), u00000080);
+    __m256i cb_hi = _mm256_sub_epi32(
+        _mm256_cvtepu8_epi32(_mm_srli_si128(cb_all, 8)), u00000080);
+    __m256i cr_lo = _mm256_sub_epi32(_mm256_cvtepu8_epi32(cr_all), u00000080);
+    __m256i cr_hi = _mm256_sub_epi32(
+        _mm256_cvtepu8_epi32(_mm_srli_si128(cr_all, 8)), u00000080);
+
+    __m256i rr_lo =
+        _mm256_add_epi32(yy_lo, _mm256_mullo_epi32(cr_lo, u000166E9));
+    __m256i rr_hi =
+        _mm256_add_epi32(yy_hi, _mm256_mullo_epi32(cr_hi, u000166E9));
+    __m256i gg_lo = _mm256_sub_epi32(
+        _mm256_sub_epi32(yy_lo, _mm256_mullo_epi32(cb_lo, u0000581A)),
+        _mm256_mullo_epi32(cr_lo, u0000B6D2));
+    __m256i gg_hi = _mm256_sub_epi32(
+        _mm256_sub_epi32(yy_hi, _mm256_mullo_epi32(cb_hi, u0000581A)),
+        _mm256_mullo_epi32(cr_hi, u0000B6D2));
+    __m256i bb_lo =
+        _mm256_add_epi32(yy_lo, _mm256_mullo_epi32(cb_lo, u0001C5A2));
+    __m256i bb_hi =
+        _mm256_add_epi32(yy_hi, _mm256_mullo_epi32(cb_hi, u0001C5A2));
+
+    __m256i rr = _mm256_sub_epi16(
+        u00FF, wuffs_private_impl__swizzle_ycc__narrow_16_16_x86_avx2(rr_lo,
+                                                                      rr_hi));
+    __m256i gg = _mm256_sub_epi16(
+        u00FF, wuffs_private_impl__swizzle_ycc__narrow_16_16_x86_avx2(gg_lo,
+                                                                      gg_hi));
+    __m256i bb = _mm256_sub_epi16(
+        u00FF, wuffs_private_impl__swizzle_ycc__narrow_16_16_x86_avx2(bb_lo,
+                                                                      bb_hi));
+    __m256i ww = _mm256_cvtepu8_epi16(
+        _mm_lddqu_si128((const __m128i*)(const void*)up3));
+
+    wuffs_private_impl__swizzle_cmyk__store_x86_avx2(
+        dst_iter,                                                  //
+        wuffs_private_impl__swizzle_cmyk__scale_x86_avx2(rr, ww),  // §
+        wuffs_private_impl__swizzle_cmyk__scale_x86_avx2(gg, ww),  //
+        wuffs_private_impl__swizzle_cmyk__scale_x86_avx2(bb, ww));  // §
+
+    uint32_t n = 16u - (15u & (x - x_end));
+    dst_iter += 4u * n;
+    up0 += n;
+    up1 += n;
+    up2 += n;
+    up3 += n;
+    x += n;
+  }
+}
+
 #if defined(__GNUC__) && !defined(__clang__)
 // No-op.
 #else
@@ -636,5 +986,1313 @@ wuffs_private_impl__swizzle_ycc__upsample_inv_h2v2_triangle_x86_avx2(
   return dst_ptr;
 }
 #endif
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h1v2_triangle_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias,
+    bool first_column,
+    bool last_column) {
+  uint8_t* dp = dst_ptr;
+  const uint8_t* sp_major = src_ptr_major;
+  const uint8_t* sp_minor = src_ptr_minor;
+
+  if (src_len < 32) {
+    // This fallback is the same as the non-SIMD-capable code path.
+    while (src_len--) {
+      *dp++ = (uint8_t)(((3u * ((uint32_t)(*sp_major++))) +  //
+                         (1u * ((uint32_t)(*sp_minor++))) +  //
+                         h1v2_bias) >>
+                        2u);
+    }
+    return dst_ptr;
+  }
+
+  const __m256i k0103 = _mm256_set1_epi16(0x0103);
+  const __m256i bias = _mm256_set1_epi16((int16_t)h1v2_bias);
+  while (src_len > 0u) {
+    // Load 32 samples (two u8x32 vectors) from the major (jxx) and minor (nxx)
+    // rows, interleave them and multiply-add to get u16x16 vectors:
+    //
+    // step1_lo = [3*j00+1*n00 .. 3*j07+1*n07  3*j16+1*n16 .. 3*j23+1*n23]
+    // step1_hi = [3*j08+1*n08 .. 3*j15+1*n15  3*j24+1*n24 .. 3*j31+1*n31]
+    __m256i major = _mm256_lddqu_si256((const __m256i*)(const void*)sp_major);
+    __m256i minor = _mm256_lddqu_si256((const __m256i*)(const void*)sp_minor);
+    __m256i step1_lo =
+        _mm256_maddubs_epi16(_mm256_unpacklo_epi8(major, minor), k0103);
+    __m256i step1_hi =
+        _mm256_maddubs_epi16(_mm256_unpackhi_epi8(major, minor), k0103);
+
+    // Bias, divide by 4 (which is 3+1) and pack back to u8x32. Packing works
+    // per 128-bit lane, which undoes the per-lane unpacking above, so no
+    // permute is needed.
+    __m256i step2_lo = _mm256_srli_epi16(_mm256_add_epi16(step1_lo, bias), 2);
+    __m256i step2_hi = _mm256_srli_epi16(_mm256_add_epi16(step1_hi, bias), 2);
+    _mm256_storeu_si256((__m256i*)(void*)dp,
+                        _mm256_packus_epi16(step2_lo, step2_hi));
+
+    // Advance by up to 32 samples. The first iteration might be smaller than
+    // 32 so that all of the remaining steps are exactly 32.
+    size_t n = 32u - (31u & (0u - src_len));
+    dp += n;
+    sp_major += n;
+    sp_minor += n;
+    src_len -= n;
+  }
+
+  return dst_ptr;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h2v1_triangle_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column,
+    bool last_column) {
+  uint8_t* dp = dst_ptr;
+  const uint8_t* sp = src_ptr_major;
+
+  if (first_column) {
+    src_len--;
+    if ((src_len <= 0u) && last_column) {
+      uint8_t sv = *sp++;
+      *dp++ = sv;
+      *dp++ = sv;
+      return dst_ptr;
+    }
+    uint32_t svp1 = sp[+1];
+    uint8_t sv = *sp++;
+    *dp++ = sv;
+    *dp++ = (uint8_t)(((3u * (uint32_t)sv) + svp1 + 2u) >> 2u);
+    if (src_len <= 0u) {
+      return dst_ptr;
+    }
+  }
+
+  if (last_column) {
+    src_len--;
+  }
+
+  if (src_len < 32) {
+    // This fallback is the same as the non-SIMD-capable code path.
+    for (; src_len > 0u; src_len--) {
+      uint32_t svm1 = sp[-1];
+      uint32_t svp1 = sp[+1];
+      uint32_t sv3 = 3u * (uint32_t)(*sp++);
+      *dp++ = (uint8_t)((sv3 + svm1 + 1u) >> 2u);
+      *dp++ = (uint8_t)((sv3 + svp1 + 2u) >> 2u);
+    }
+
+  } else {
+    const __m256i k0103 = _mm256_set1_epi16(0x0103);
+    while (src_len > 0u) {
+      // Load 1+32+1 samples (three u8x32 vectors).
+      //
+      // p0 = [s00 s01 s02 s03 .. s28 s29 s30 s31]   // p0 = "plus  0"
+      // m1 = [sm1 s00 s01 s02 .. s27 s28 s29 s30]   // m1 = "minus 1"
+      // p1 = [s01 s02 s03 s04 .. s29 s30 s31 s32]   // p1 = "plus  1"
+      __m256i p0 = _mm256_lddqu_si256((const __m256i*)(const void*)(sp + 0));
+      __m256i m1 = _mm256_lddqu_si256((const __m256i*)(const void*)(sp - 1));
+      __m256i p1 = _mm256_lddqu_si256((const __m256i*)(const void*)(sp + 1));
+
+      // Unpack and multiply-add to get u16x16 vectors. For example:
+      //
+      // step1_m1_lo = [3*s00+1*sm1 3*s01+1*s00 .. 3*s23+1*s22]
+      // step1_p1_hi = [3*s08+1*s09 3*s09+1*s10 .. 3*s31+1*s32]
+      __m256i step1_m1_lo =
+          _mm256_maddubs_epi16(_mm256_unpacklo_epi8(p0, m1), k0103);
+      __m256i step1_m1_hi =
+          _mm256_maddubs_epi16(_mm256_unpackhi_epi8(p0, m1), k0103);
+      __m256i step1_p1_lo =
+          _mm256_maddubs_epi16(_mm256_unpacklo_epi8(p0, p1), k0103);
+      __m256i step1_p1_hi =
+          _mm256_maddubs_epi16(_mm256_unpackhi_epi8(p0, p1), k0103);
+
+      // Bias by 1 (on the left) or 2 (on the right) and then divide by 4
+      // (which is 3+1). As for the h2v2 triangle filter, the right (p1)
+      // results are also shifted into the high byte of each u16 element.
+      __m256i step2_m1_lo = _mm256_srli_epi16(
+          _mm256_add_epi16(step1_m1_lo, _mm256_set1_epi16(1)), 2);
+      __m256i step2_p1_lo = _mm256_slli_epi16(
+          _mm256_srli_epi16(_mm256_add_epi16(step1_p1_lo, _mm256_set1_epi16(2)),
+                            2),
+          8);
+      __m256i step2_m1_hi = _mm256_srli_epi16(
+          _mm256_add_epi16(step1_m1_hi, _mm256_set1_epi16(1)), 2);
+      __m256i step2_p1_hi = _mm256_slli_epi16(
+          _mm256_srli_epi16(_mm256_add_epi16(step1_p1_hi, _mm256_set1_epi16(2)),
+                            2),
+          8);
+
+      // Bitwise-or, permute and store.
+      //
+      // step3_lo = [d00 d01 .. d14 d15  d32 d33 .. d46 d47]
+      // step3_hi = [d16 d17 .. d30 d31  d48 d49 .. d62 d63]
+      __m256i step3_lo = _mm256_or_si256(step2_m1_lo, step2_p1_lo);
+      __m256i step3_hi = _mm256_or_si256(step2_m1_hi, step2_p1_hi);
+      _mm256_storeu_si256((__m256i*)(void*)(dp + 0x00),
+                          _mm256_permute2x128_si256(step3_lo, step3_hi, 0x20));
+      _mm256_storeu_si256((__m256i*)(void*)(dp + 0x20),
+                          _mm256_permute2x128_si256(step3_lo, step3_hi, 0x31));
+
+      // Advance by up to 32 source samples (64 destination samples). The first
+      // iteration might be smaller than 32 so that all of the remaining steps
+      // are exactly 32.
+      size_t n = 32u - (31u & (0u - src_len));
+      dp += 2u * n;
+      sp += n;
+      src_len -= n;
+    }
+  }
+
+  if (last_column) {
+    uint32_t svm1 = sp[-1];
+    uint8_t sv = *sp++;
+    *dp++ = (uint8_t)(((3u * (uint32_t)sv) + svm1 + 1u) >> 2u);
+    *dp++ = sv;
+  }
+
+  return dst_ptr;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h2vn_box_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor_ignored,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column_ignored,
+    bool last_column_ignored) {
+  uint8_t* dp = dst_ptr;
+  const uint8_t* sp = src_ptr_major;
+
+  if (src_len < 32) {
+    // This fallback is the same as the non-SIMD-capable code path.
+    while (src_len--) {
+      uint8_t sv = *sp++;
+      *dp++ = sv;
+      *dp++ = sv;
+    }
+    return dst_ptr;
+  }
+
+  while (src_len > 0u) {
+    // x0 = [s00 s01 .. s30 s31]
+    // x1 = [s00 s00 s01 s01 .. s07 s07  s16 s16 s17 s17 .. s23 s23]
+    // x2 = [s08 s08 s09 s09 .. s15 s15  s24 s24 s25 s25 .. s31 s31]
+    __m256i x0 = _mm256_lddqu_si256((const __m256i*)(const void*)sp);
+    __m256i x1 = _mm256_unpacklo_epi8(x0, x0);
+    __m256i x2 = _mm256_unpackhi_epi8(x0, x0);
+    _mm256_storeu_si256((__m256i*)(void*)(dp + 0x00),
+                        _mm256_permute2x128_si256(x1, x2, 0x20));
+    _mm256_storeu_si256((__m256i*)(void*)(dp + 0x20),
+                        _mm256_permute2x128_si256(x1, x2, 0x31));
+
+    size_t n = 32u - (31u & (0u - src_len));
+    dp += 2u * n;
+    sp += n;
+    src_len -= n;
+  }
+
+  return dst_ptr;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h3vn_box_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor_ignored,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column_ignored,
+    bool last_column_ignored) {
+  uint8_t* dp = dst_ptr;
+  const uint8_t* sp = src_ptr_major;
+
+  if (src_len < 16) {
+    // This fallback is the same as the non-SIMD-capable code path.
+    while (src_len--) {
+      uint8_t sv = *sp++;
+      *dp++ = sv;
+      *dp++ = sv;
+      *dp++ = sv;
+    }
+    return dst_ptr;
+  }
+
+  // Each of the 16 source samples is repeated 3 times, for 48 destination
+  // samples: 32 from shuffling (both 128-bit lanes of) x1 and 16 from x0.
+  const __m256i shuffle01 = _mm256_set_epi8(  //
+      0x0A, 0x0A, 0x09, 0x09, 0x09, 0x08, 0x08, 0x08,  //
+      0x07, 0x07, 0x07, 0x06, 0x06, 0x06, 0x05, 0x05,  //
+      0x05, 0x04, 0x04, 0x04, 0x03, 0x03, 0x03, 0x02,  //
+      0x02, 0x02, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00);
+  const __m128i shuffle2 = _mm_set_epi8(  //
+      0x0F, 0x0F, 0x0F, 0x0E, 0x0E, 0x0E, 0x0D, 0x0D,  //
+      0x0D, 0x0C, 0x0C, 0x0C, 0x0B, 0x0B, 0x0B, 0x0A);
+  while (src_len > 0u) {
+    __m128i x0 = _mm_lddqu_si128((const __m128i*)(const void*)sp);
+    __m256i x1 = _mm256_broadcastsi128_si256(x0);
+    _mm256_storeu_si256((__m256i*)(void*)(dp + 0x00),
+                        _mm256_shuffle_epi8(x1, shuffle01));
+    _mm_storeu_si128((__m128i*)(void*)(dp + 0x20),
+                     _mm_shuffle_epi8(x0, shuffle2));
+
+    size_t n = 16u - (15u & (0u - src_len));
+    dp += 3u * n;
+    sp += n;
+    src_len -= n;
+  }
+
+  return dst_ptr;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h4vn_box_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor_ignored,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column_ignored,
+    bool last_column_ignored) {
+  uint8_t* dp = dst_ptr;
+  const uint8_t* sp = src_ptr_major;
+
+  if (src_len < 32) {
+    // This fallback is the same as the non-SIMD-capable code path.
+    while (src_len--) {
+      uint8_t sv = *sp++;
+      *dp++ = sv;
+      *dp++ = sv;
+      *dp++ = sv;
+      *dp++ = sv;
+    }
+    return dst_ptr;
+  }
+
+  while (src_len > 0u) {
+    // x0 = [s00 s01 .. s30 s31]
+    // x1 = [s00 s00 s01 s01 .. s07 s07  s16 s16 s17 s17 .. s23 s23]
+    // x2 = [s08 s08 s09 s09 .. s15 s15  s24 s24 s25 s25 .. s31 s31]
+    // x3 = [s00 s00 s00 s00 .. s03 s03  s16 s16 s16 s16 .. s19 s19]
+    // etc.
+    __m256i x0 = _mm256_lddqu_si256((const __m256i*)(const void*)sp);
+    __m256i x1 = _mm256_unpacklo_epi8(x0, x0);
+    __m256i x2 = _mm256_unpackhi_epi8(x0, x0);
+    __m256i x3 = _mm256_unpacklo_epi16(x1, x1);
+    __m256i x4 = _mm256_unpackhi_epi16(x1, x1);
+    __m256i x5 = _mm256_unpacklo_epi16(x2, x2);
+    __m256i x6 = _mm256_unpackhi_epi16(x2, x2);
+    _mm256_storeu_si256((__m256i*)(void*)(dp + 0x00),
+                        _mm256_permute2x128_si256(x3, x4, 0x20));
+    _mm256_storeu_si256((__m256i*)(void*)(dp + 0x20),
+                        _mm256_permute2x128_si256(x5, x6, 0x20));
+    _mm256_storeu_si256((__m256i*)(void*)(dp + 0x40),
+                        _mm256_permute2x128_si256(x3, x4, 0x31));
+    _mm256_storeu_si256((__m256i*)(void*)(dp + 0x60),
+                        _mm256_permute2x128_si256(x5, x6, 0x31));
+
+    size_t n = 32u - (31u & (0u - src_len));
+    dp += 4u * n;
+    sp += n;
+    src_len -= n;
+  }
+
+  return dst_ptr;
+}
+// --------
+
+// The src_over x86_avx2 code below composites onto premultiplied 8-bit BGRA
+// destinations. It works in u32x8 lanes (two pixels per __m256i) with the
+// same 16-bit color components as the non-SIMD
+// wuffs_private_impl__composite_premul_etc_axxx functions. Division by 0xFFFF
+// is done as ((x + (x >> 16) + 1) >> 16), which is exact for every x in the
+// range 0 ..= 0xFFFE0001. The output therefore matches the non-SIMD code
+// exactly, for valid (premultiplied) premul inputs.
+//
+// The nonpremul destinations don't have SIMD code paths. Converting back from
+// premul to nonpremul would need a per-pixel division by the alpha.
+
+// wuffs_private_impl__swizzle_src_over__composite_x86_avx2 returns the
+// composited pixels (as u32x8 values in the range 0x00 ..= 0xFF, but see
+// below) for two pixels' worth of u32x8 16-bit color components. Both d and s
+// are in BGRA order, so that lanes 3 and 7 hold the alpha.
+//
+// For invalid premul input, where a color exceeds its alpha, the return value
+// can exceed 0xFF. The caller's packus instructions saturate to 0xFF.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m256i  //
+wuffs_private_impl__swizzle_src_over__composite_x86_avx2(__m256i d,
+                                                         __m256i s,
+                                                         bool src_premul) {
+  const __m256i u0001 = _mm256_set1_epi32(0x0001);
+  const __m256i uFFFF = _mm256_set1_epi32(0xFFFF);
+
+  // sa = u32x8 [sa.0 sa.0 sa.0 sa.0  sa.1 sa.1 sa.1 sa.1]
+  // ia = 0xFFFF - sa
+  __m256i sa = _mm256_shuffle_epi32(s, 0xFF);
+  __m256i ia = _mm256_sub_epi32(uFFFF, sa);
+
+  if (src_premul) {
+    // s + ((d * ia) / 0xFFFF), then convert from 16-bit to 8-bit color.
+    __m256i x = _mm256_mullo_epi32(d, ia);
+    x = _mm256_srli_epi32(
+        _mm256_add_epi32(_mm256_add_epi32(x, _mm256_srli_epi32(x, 16)), u0001),
+        16);
+    return _mm256_srli_epi32(_mm256_add_epi32(s, x), 8);
+  }
+
+  // ((s * sa) + (d * ia)) / 0xFFFF, then convert from 16-bit to 8-bit color.
+  // Replacing the alpha lanes of s with 0xFFFF gives (sa + ((da * ia) /
+  // 0xFFFF)) for the alpha, as (sa * 0xFFFF) is an exact multiple of 0xFFFF.
+  __m256i x = _mm256_add_epi32(
+      _mm256_mullo_epi32(_mm256_blend_epi32(s, uFFFF, 0x88), sa),
+      _mm256_mullo_epi32(d, ia));
+  return _mm256_srli_epi32(
+      _mm256_add_epi32(_mm256_add_epi32(x, _mm256_srli_epi32(x, 16)), u0001),
+      24);
+}
+
+// wuffs_private_impl__swizzle_src_over__widen_x86_avx2 zero-extends the low 8
+// bytes of x to u32x8 and then multiplies by 0x101, converting from 8-bit to
+// 16-bit color.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m256i  //
+wuffs_private_impl__swizzle_src_over__widen_x86_avx2(__m128i x) {
+  __m256i y = _mm256_cvtepu8_epi32(x);
+  return _mm256_or_si256(y, _mm256_slli_epi32(y, 8));
+}
+
+// wuffs_private_impl__swizzle_src_over__bgra_premul_x86_avx2 composites
+// groups of 8 pixels and returns the number of pixels processed, a multiple
+// of 8. The caller handles any remaining pixels.
+//
+// The src is 4 bytes (or 8 bytes if src_4x16le) per pixel. If src_swap_rb
+// then it is RGBA order instead of BGRA order.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline WUFFS_BASE__FORCE_INLINE size_t  //
+wuffs_private_impl__swizzle_src_over__bgra_premul_x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    const uint8_t* src_ptr,
+    size_t src_len,
+    bool src_4x16le,
+    bool src_premul,
+    bool src_swap_rb) {
+  size_t src_bpp = src_4x16le ? 8u : 4u;
+  size_t dst_len4 = dst_len / 4;
+  size_t src_lenx = src_len / src_bpp;
+  size_t len = ((dst_len4 < src_lenx) ? dst_len4 : src_lenx) & ~(size_t)7u;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // alpha selects the alpha bytes of 8 BGRA pixels.
+  //
+  // swap32 converts 8-bit RGBA to BGRA (or vice versa).
+  //
+  // swap64 converts 16-bit RGBA to BGRA (or vice versa), within a __m128i.
+  //
+  // order puts packed pixels back in order. The packus instructions work per
+  // 128-bit lane, yielding [px.0 px.2 px.4 px.6  px.1 px.3 px.5 px.7].
+  const __m256i alpha = _mm256_set1_epi32((int32_t)0xFF000000u);
+  const __m256i swap32 = _mm256_set_epi8(  //
+      +0x0F, +0x0C, +0x0D, +0x0E,          //
+      +0x0B, +0x08, +0x09, +0x0A,          //
+      +0x07, +0x04, +0x05, +0x06,          //
+      +0x03, +0x00, +0x01, +0x02,          //
+      +0x0F, +0x0C, +0x0D, +0x0E,          //
+      +0x0B, +0x08, +0x09, +0x0A,          //
+      +0x07, +0x04, +0x05, +0x06,          //
+      +0x03, +0x00, +0x01, +0x02);
+  const __m128i swap64 = _mm_set_epi8(  //
+      +0x0F, +0x0E, +0x09, +0x08,       //
+      +0x0B, +0x0A, +0x0D, +0x0C,       //
+      +0x07, +0x06, +0x01, +0x00,       //
+      +0x03, +0x02, +0x05, +0x04);
+  const __m256i order = _mm256_set_epi32(7, 3, 6, 2, 5, 1, 4, 0);
+
+  while (n >= 8) {
+    __m256i d8 = _mm256_lddqu_si256((const __m256i*)(const void*)d);
+    __m256i c0;
+    __m256i c1;
+    __m256i c2;
+    __m256i c3;
+
+    if (src_4x16le) {
+      __m128i s0 = _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x00));
+      __m128i s1 = _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x10));
+      __m128i s2 = _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x20));
+      __m128i s3 = _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x30));
+      if (src_swap_rb) {
+        s0 = _mm_shuffle_epi8(s0, swap64);
+        s1 = _mm_shuffle_epi8(s1, swap64);
+        s2 = _mm_shuffle_epi8(s2, swap64);
+        s3 = _mm_shuffle_epi8(s3, swap64);
+      }
+      __m128i dlo = _mm256_castsi256_si128(d8);
+      __m128i dhi = _mm256_extracti128_si256(d8, 1);
+      c0 = wuffs_private_impl__swizzle_src_over__composite_x86_avx2(
+          wuffs_private_impl__swizzle_src_over__widen_x86_avx2(dlo),
+          _mm256_cvtepu16_epi32(s0), src_premul);
+      c1 = wuffs_private_impl__swizzle_src_over__composite_x86_avx2(
+          wuffs_private_impl__swizzle_src_over__widen_x86_avx2(
+              _mm_srli_si128(dlo, 8)),
+          _mm256_cvtepu16_epi32(s1), src_premul);
+      c2 = wuffs_private_impl__swizzle_src_over__composite_x86_avx2(
+          wuffs_private_impl__swizzle_src_over__widen_x86_avx2(dhi),
+          _mm256_cvtepu16_epi32(s2), src_premul);
+      c3 = wuffs_private_impl__swizzle_src_over__composite_x86_avx2(
+          wuffs_private_impl__swizzle_src_over__widen_x86_avx2(
+              _mm_srli_si128(dhi, 8)),
+          _mm256_cvtepu16_epi32(s3), src_premul);
+
+    } else {
+      __m256i s8 = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+      if (src_swap_rb) {
+        s8 = _mm256_shuffle_epi8(s8, swap32);
+      }
+
+      // Fast paths: fully opaque src replaces dst. Fully transparent src
+      // leaves dst unchanged. Both match the non-SIMD code exactly.
+      if (_mm256_testc_si256(s8, alpha)) {
+        _mm256_storeu_si256((__m256i*)(void*)d, s8);
+        s += 8 * 4;
+        d += 8 * 4;
+        n -= 8;
+        continue;
+      } else if (src_premul ? _mm256_testz_si256(s8, s8)
+                            : _mm256_testz_si256(s8, alpha)) {
+        s += 8 * 4;
+        d += 8 * 4;
+        n -= 8;
+        continue;
+      }
+
+      __m128i slo = _mm256_castsi256_si128(s8);
+      __m128i shi = _mm256_extracti128_si256(s8, 1);
+      __m128i dlo = _mm256_castsi256_si128(d8);
+      __m128i dhi = _mm256_extracti128_si256(d8, 1);
+      c0 = wuffs_private_impl__swizzle_src_over__composite_x86_avx2(
+          wuffs_private_impl__swizzle_src_over__widen_x86_avx2(dlo),
+          wuffs_private_impl__swizzle_src_over__widen_x86_avx2(slo),
+          src_premul);
+      c1 = wuffs_private_impl__swizzle_src_over__composite_x86_avx2(
+          wuffs_private_impl__swizzle_src_over__widen_x86_avx2(
+              _mm_srli_si128(dlo, 8)),
+          wuffs_private_impl__swizzle_src_over__widen_x86_avx2(
+              _mm_srli_si128(slo, 8)),
+          src_premul);
+      c2 = wuffs_private_impl__swizzle_src_over__composite_x86_avx2(
+          wuffs_private_impl__swizzle_src_over__widen_x86_avx2(dhi),
+          wuffs_private_impl__swizzle_src_over__widen_x86_avx2(shi),
+          src_premul);
+      c3 = wuffs_private_impl__swizzle_src_over__composite_x86_avx2(
+          wuffs_private_impl__swizzle_src_over__widen_x86_avx2(
+              _mm_srli_si128(dhi, 8)),
+          wuffs_private_impl__swizzle_src_over__widen_x86_avx2(
+              _mm_srli_si128(shi, 8)),
+          src_premul);
+    }
+
+    _mm256_storeu_si256(
+        (__m256i*)(void*)d,
+        _mm256_permutevar8x32_epi32(
+            _mm256_packus_epi16(_mm256_packus_epi32(c0, c1),
+                                _mm256_packus_epi32(c2, c3)),
+            order));
+
+    s += 8 * src_bpp;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_src_over__bgra_premul_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, false, false, false);
+  return n + wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src_over(
+                 dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_src_over__bgra_premul_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, true, false, false);
+  return n +
+         wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src_over(
+             dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+             dst_palette_len, src_ptr + (8 * n), src_len - (8 * n));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_src_over__bgra_premul_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, false, true, false);
+  return n + wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over(
+                 dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_premul_4x16le__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_src_over__bgra_premul_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, true, true, false);
+  return n +
+         wuffs_private_impl__swizzle_bgra_premul__bgra_premul_4x16le__src_over(
+             dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+             dst_palette_len, src_ptr + (8 * n), src_len - (8 * n));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_src_over__bgra_premul_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, false, false, true);
+  return n + wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src_over(
+                 dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_src_over__bgra_premul_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, true, false, true);
+  return n +
+         wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src_over(
+             dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+             dst_palette_len, src_ptr + (8 * n), src_len - (8 * n));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_src_over__bgra_premul_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, false, true, true);
+  return n + wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over(
+                 dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_premul_4x16le__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_src_over__bgra_premul_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, true, true, true);
+  return n +
+         wuffs_private_impl__swizzle_bgra_premul__rgba_premul_4x16le__src_over(
+             dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+             dst_palette_len, src_ptr + (8 * n), src_len - (8 * n));
+}
+
+// --------
+
+// The x86_avx2 code below implements the most commonly used SRC swizzlers:
+// shuffling between 1, 3 and 4 bytes per pixel, converting between
+// nonpremul and premul alpha and narrowing from 4x16le to 8 bits per channel.
+// Each function processes as many pixels as it can in SIMD-sized chunks and
+// hands any remainder to the equivalent non-SIMD function. Apart from
+// saturating instead of overflowing for invalid (color > alpha) premul input,
+// the output matches the non-SIMD code exactly.
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgrw__bgr__x86_avx2(uint8_t* dst_ptr,
+                                                size_t dst_len,
+                                                uint8_t* dst_palette_ptr,
+                                                size_t dst_palette_len,
+                                                const uint8_t* src_ptr,
+                                                size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // The low and high 128-bit lanes are loaded from s+0 and s+12, so each
+  // lane holds four 3-byte pixels (and four bytes of slack).
+  const __m256i shuffle = _mm256_set_epi8(  //
+      +0x00, +0x0B, +0x0A, +0x09,           //
+      +0x00, +0x08, +0x07, +0x06,           //
+      +0x00, +0x05, +0x04, +0x03,           //
+      +0x00, +0x02, +0x01, +0x00,           //
+      +0x00, +0x0B, +0x0A, +0x09,           //
+      +0x00, +0x08, +0x07, +0x06,           //
+      +0x00, +0x05, +0x04, +0x03,           //
+      +0x00, +0x02, +0x01, +0x00);
+  const __m256i or_ff = _mm256_set1_epi32((int32_t)0xFF000000u);
+
+  // Each iteration reads 28 bytes, for 24 bytes (8 pixels) of progress.
+  while (n >= 10) {
+    __m256i x = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x00))),
+        _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x0C)), 1);
+    x = _mm256_shuffle_epi8(x, shuffle);
+    x = _mm256_or_si256(x, or_ff);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 3;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  return (len - n) + wuffs_private_impl__swizzle_bgrw__bgr(
+                         d, 4 * n, dst_palette_ptr, dst_palette_len, s, 3 * n);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgrw__rgb__x86_avx2(uint8_t* dst_ptr,
+                                                size_t dst_len,
+                                                uint8_t* dst_palette_ptr,
+                                                size_t dst_palette_len,
+                                                const uint8_t* src_ptr,
+                                                size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  const __m256i shuffle = _mm256_set_epi8(  //
+      +0x00, +0x09, +0x0A, +0x0B,           //
+      +0x00, +0x06, +0x07, +0x08,           //
+      +0x00, +0x03, +0x04, +0x05,           //
+      +0x00, +0x00, +0x01, +0x02,           //
+      +0x00, +0x09, +0x0A, +0x0B,           //
+      +0x00, +0x06, +0x07, +0x08,           //
+      +0x00, +0x03, +0x04, +0x05,           //
+      +0x00, +0x00, +0x01, +0x02);
+  const __m256i or_ff = _mm256_set1_epi32((int32_t)0xFF000000u);
+
+  while (n >= 10) {
+    __m256i x = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x00))),
+        _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x0C)), 1);
+    x = _mm256_shuffle_epi8(x, shuffle);
+    x = _mm256_or_si256(x, or_ff);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 3;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  return (len - n) + wuffs_private_impl__swizzle_bgrw__rgb(
+                         d, 4 * n, dst_palette_ptr, dst_palette_len, s, 3 * n);
+}
+
+// wuffs_private_impl__swizzle_xxx__xxxx_shuffle_x86_avx2 drops the fourth
+// byte of each pixel, optionally swapping the first and third bytes.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline WUFFS_BASE__FORCE_INLINE size_t  //
+wuffs_private_impl__swizzle_xxx__xxxx_shuffle_x86_avx2(uint8_t* dst_ptr,
+                                               size_t dst_len,
+                                               const uint8_t* src_ptr,
+                                               size_t src_len,
+                                               bool swap_rb) {
+  size_t dst_len3 = dst_len / 3;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len3 < src_len4) ? dst_len3 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // The shuffle packs each 128-bit lane's 12 bytes of output at the start of
+  // that lane. The permutation then closes the 4-byte gap between the lanes.
+  const __m256i shuffle =
+      swap_rb ? _mm256_set_epi8(                             //
+                    -0x80, -0x80, -0x80, -0x80,              //
+                    +0x0C, +0x0D, +0x0E, +0x08,              //
+                    +0x09, +0x0A, +0x04, +0x05,              //
+                    +0x06, +0x00, +0x01, +0x02,              //
+                    -0x80, -0x80, -0x80, -0x80,              //
+                    +0x0C, +0x0D, +0x0E, +0x08,              //
+                    +0x09, +0x0A, +0x04, +0x05,              //
+                    +0x06, +0x00, +0x01, +0x02)              //
+              : _mm256_set_epi8(                             //
+                    -0x80, -0x80, -0x80, -0x80,              //
+                    +0x0E, +0x0D, +0x0C, +0x0A,              //
+                    +0x09, +0x08, +0x06, +0x05,              //
+                    +0x04, +0x02, +0x01, +0x00,              //
+                    -0x80, -0x80, -0x80, -0x80,              //
+                    +0x0E, +0x0D, +0x0C, +0x0A,              //
+                    +0x09, +0x08, +0x06, +0x05,              //
+                    +0x04, +0x02, +0x01, +0x00);
+  const __m256i order = _mm256_set_epi32(7, 3, 6, 5, 4, 2, 1, 0);
+
+  // Each iteration writes 32 bytes, for 24 bytes (8 pixels) of progress.
+  while (n >= 11) {
+    __m256i x = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+    x = _mm256_shuffle_epi8(x, shuffle);
+    x = _mm256_permutevar8x32_epi32(x, order);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 4;
+    d += 8 * 3;
+    n -= 8;
+  }
+
+  return len - n;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_xxx__xxxx__x86_avx2(uint8_t* dst_ptr,
+                                                size_t dst_len,
+                                                uint8_t* dst_palette_ptr,
+                                                size_t dst_palette_len,
+                                                const uint8_t* src_ptr,
+                                                size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_xxx__xxxx_shuffle_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, false);
+  return n + wuffs_private_impl__swizzle_xxx__xxxx(
+                 dst_ptr + (3 * n), dst_len - (3 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgr__rgba_premul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_xxx__xxxx_shuffle_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, true);
+  return n + wuffs_private_impl__swizzle_bgr__rgba_premul__src(
+                 dst_ptr + (3 * n), dst_len - (3 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_xxxx__y__x86_avx2(uint8_t* dst_ptr,
+                                              size_t dst_len,
+                                              uint8_t* dst_palette_ptr,
+                                              size_t dst_palette_len,
+                                              const uint8_t* src_ptr,
+                                              size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t len = (dst_len4 < src_len) ? dst_len4 : src_len;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // The 16 source bytes are broadcast to both 128-bit lanes. shuffle_lo
+  // picks the gray values for pixels 0..=3 (low lane) and 4..=7 (high lane).
+  // shuffle_hi does likewise for pixels 8..=15.
+  const __m256i shuffle_lo = _mm256_set_epi8(  //
+      +0x07, +0x07, +0x07, +0x07,              //
+      +0x06, +0x06, +0x06, +0x06,              //
+      +0x05, +0x05, +0x05, +0x05,              //
+      +0x04, +0x04, +0x04, +0x04,              //
+      +0x03, +0x03, +0x03, +0x03,              //
+      +0x02, +0x02, +0x02, +0x02,              //
+      +0x01, +0x01, +0x01, +0x01,              //
+      +0x00, +0x00, +0x00, +0x00);
+  const __m256i shuffle_hi = _mm256_add_epi8(shuffle_lo, _mm256_set1_epi8(8));
+  const __m256i or_ff = _mm256_set1_epi32((int32_t)0xFF000000u);
+
+  while (n >= 16) {
+    __m256i x = _mm256_broadcastsi128_si256(
+        _mm_lddqu_si128((const __m128i*)(const void*)s));
+    _mm256_storeu_si256(
+        (__m256i*)(void*)(d + 0x00),
+        _mm256_or_si256(_mm256_shuffle_epi8(x, shuffle_lo), or_ff));
+    _mm256_storeu_si256(
+        (__m256i*)(void*)(d + 0x20),
+        _mm256_or_si256(_mm256_shuffle_epi8(x, shuffle_hi), or_ff));
+
+    s += 16 * 1;
+    d += 16 * 4;
+    n -= 16;
+  }
+
+  return (len - n) + wuffs_private_impl__swizzle_xxxx__y(
+                         d, 4 * n, dst_palette_ptr, dst_palette_len, s, n);
+}
+
+// wuffs_private_impl__swizzle_premul__convert_x86_avx2 converts two pixels'
+// worth of u32x8 16-bit nonpremul color components (BGRA order, so lanes 3
+// and 7 hold the alpha) to 8-bit premul color. It is exactly
+// wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul (and its
+// u64 equivalent): ((c * a) / 0xFFFF) >> 8 for colors and (a >> 8) for the
+// alpha. Replacing the alpha lanes of c by 0xFFFF computes both at once.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m256i  //
+wuffs_private_impl__swizzle_premul__convert_x86_avx2(__m256i c) {
+  const __m256i u0001 = _mm256_set1_epi32(0x0001);
+  const __m256i uFFFF = _mm256_set1_epi32(0xFFFF);
+  __m256i x = _mm256_mullo_epi32(_mm256_blend_epi32(c, uFFFF, 0x88),
+                                 _mm256_shuffle_epi32(c, 0xFF));
+  return _mm256_srli_epi32(
+      _mm256_add_epi32(_mm256_add_epi32(x, _mm256_srli_epi32(x, 16)), u0001),
+      24);
+}
+
+// wuffs_private_impl__swizzle_premul__nonpremul_x86_avx2 converts groups of 8
+// pixels from nonpremul (4 or 8 bytes per pixel) to 8-bit BGRA premul and
+// returns the number of pixels processed, a multiple of 8.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline WUFFS_BASE__FORCE_INLINE size_t  //
+wuffs_private_impl__swizzle_premul__nonpremul_x86_avx2(uint8_t* dst_ptr,
+                                                       size_t dst_len,
+                                                       const uint8_t* src_ptr,
+                                                       size_t src_len,
+                                                       bool src_4x16le,
+                                                       bool src_swap_rb) {
+  size_t src_bpp = src_4x16le ? 8u : 4u;
+  size_t dst_len4 = dst_len / 4;
+  size_t src_lenx = src_len / src_bpp;
+  size_t len = ((dst_len4 < src_lenx) ? dst_len4 : src_lenx) & ~(size_t)7u;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // See wuffs_private_impl__swizzle_src_over__bgra_premul_x86_avx2 for what
+  // these constants do.
+  const __m256i alpha = _mm256_set1_epi32((int32_t)0xFF000000u);
+  const __m256i swap32 = _mm256_set_epi8(  //
+      +0x0F, +0x0C, +0x0D, +0x0E,          //
+      +0x0B, +0x08, +0x09, +0x0A,          //
+      +0x07, +0x04, +0x05, +0x06,          //
+      +0x03, +0x00, +0x01, +0x02,          //
+      +0x0F, +0x0C, +0x0D, +0x0E,          //
+      +0x0B, +0x08, +0x09, +0x0A,          //
+      +0x07, +0x04, +0x05, +0x06,          //
+      +0x03, +0x00, +0x01, +0x02);
+  const __m128i swap64 = _mm_set_epi8(  //
+      +0x0F, +0x0E, +0x09, +0x08,       //
+      +0x0B, +0x0A, +0x0D, +0x0C,       //
+      +0x07, +0x06, +0x01, +0x00,       //
+      +0x03, +0x02, +0x05, +0x04);
+  const __m256i order = _mm256_set_epi32(7, 3, 6, 2, 5, 1, 4, 0);
+
+  while (n >= 8) {
+    __m256i c0;
+    __m256i c1;
+    __m256i c2;
+    __m256i c3;
+
+    if (src_4x16le) {
+      __m128i s0 = _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x00));
+      __m128i s1 = _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x10));
+      __m128i s2 = _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x20));
+      __m128i s3 = _mm_lddqu_si128((const __m128i*)(const void*)(s + 0x30));
+      if (src_swap_rb) {
+        s0 = _mm_shuffle_epi8(s0, swap64);
+        s1 = _mm_shuffle_epi8(s1, swap64);
+        s2 = _mm_shuffle_epi8(s2, swap64);
+        s3 = _mm_shuffle_epi8(s3, swap64);
+      }
+      c0 = wuffs_private_impl__swizzle_premul__convert_x86_avx2(
+          _mm256_cvtepu16_epi32(s0));
+      c1 = wuffs_private_impl__swizzle_premul__convert_x86_avx2(
+          _mm256_cvtepu16_epi32(s1));
+      c2 = wuffs_private_impl__swizzle_premul__convert_x86_avx2(
+          _mm256_cvtepu16_epi32(s2));
+      c3 = wuffs_private_impl__swizzle_premul__convert_x86_avx2(
+          _mm256_cvtepu16_epi32(s3));
+
+    } else {
+      __m256i s8 = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+      if (src_swap_rb) {
+        s8 = _mm256_shuffle_epi8(s8, swap32);
+      }
+
+      // Fast path: fully opaque pixels are unchanged.
+      if (_mm256_testc_si256(s8, alpha)) {
+        _mm256_storeu_si256((__m256i*)(void*)d, s8);
+        s += 8 * 4;
+        d += 8 * 4;
+        n -= 8;
+        continue;
+      }
+
+      __m128i slo = _mm256_castsi256_si128(s8);
+      __m128i shi = _mm256_extracti128_si256(s8, 1);
+      c0 = wuffs_private_impl__swizzle_premul__convert_x86_avx2(
+          wuffs_private_impl__swizzle_src_over__widen_x86_avx2(slo));
+      c1 = wuffs_private_impl__swizzle_premul__convert_x86_avx2(
+          wuffs_private_impl__swizzle_src_over__widen_x86_avx2(
+              _mm_srli_si128(slo, 8)));
+      c2 = wuffs_private_impl__swizzle_premul__convert_x86_avx2(
+          wuffs_private_impl__swizzle_src_over__widen_x86_avx2(shi));
+      c3 = wuffs_private_impl__swizzle_premul__convert_x86_avx2(
+          wuffs_private_impl__swizzle_src_over__widen_x86_avx2(
+              _mm_srli_si128(shi, 8)));
+    }
+
+    _mm256_storeu_si256(
+        (__m256i*)(void*)d,
+        _mm256_permutevar8x32_epi32(
+            _mm256_packus_epi16(_mm256_packus_epi32(c0, c1),
+                                _mm256_packus_epi32(c2, c3)),
+            order));
+
+    s += 8 * src_bpp;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  return len;
+}
+
+// wuffs_private_impl__swizzle_nonpremul__convert_x86_avx2 converts two
+// pixels' worth of u32x8 8-bit premul color components (BGRA order) to 8-bit
+// nonpremul color, like
+// wuffs_base__color_u32_argb_premul__as__color_u32_argb_nonpremul.
+//
+// For colors, that function clamps c to at most a (invalid premul input can
+// have c > a) and then computes ((c * 0xFFFF) / a) >> 8, which equals
+// floor((c * 0xFFFF) / (a * 0x100)). Both the numerator (less than 1 << 24)
+// and the denominator are exact as 32-bit floats. The quotient is less than
+// 0x100 (as c <= a) and, if it's not an integer, it's at least (1 / 0xFF00)
+// away from the next integer. That's more than half of the float's ULP, so
+// rounding the division never reaches that integer and truncating the float
+// result matches the integer arithmetic exactly.
+//
+// Lanes whose pixel has zero alpha become zero, as per the non-SIMD code.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m256i  //
+wuffs_private_impl__swizzle_nonpremul__convert_x86_avx2(__m256i c) {
+  __m256i a = _mm256_shuffle_epi32(c, 0xFF);
+  c = _mm256_min_epu32(c, a);
+  __m256 num = _mm256_cvtepi32_ps(_mm256_mullo_epi32(  //
+      c, _mm256_set1_epi32(0xFFFF)));
+  __m256 den = _mm256_cvtepi32_ps(_mm256_slli_epi32(a, 8));
+  __m256i q = _mm256_cvttps_epi32(_mm256_div_ps(num, den));
+  q = _mm256_blend_epi32(q, a, 0x88);
+  return _mm256_andnot_si256(
+      _mm256_cmpeq_epi32(a, _mm256_setzero_si256()), q);
+}
+
+// wuffs_private_impl__swizzle_nonpremul__premul_x86_avx2 converts groups of 8
+// pixels from 8-bit premul to 8-bit BGRA nonpremul and returns the number of
+// pixels processed, a multiple of 8.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline WUFFS_BASE__FORCE_INLINE size_t  //
+wuffs_private_impl__swizzle_nonpremul__premul_x86_avx2(uint8_t* dst_ptr,
+                                                       size_t dst_len,
+                                                       const uint8_t* src_ptr,
+                                                       size_t src_len,
+                                                       bool src_swap_rb) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = ((dst_len4 < src_len4) ? dst_len4 : src_len4) & ~(size_t)7u;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  const __m256i alpha = _mm256_set1_epi32((int32_t)0xFF000000u);
+  const __m256i swap32 = _mm256_set_epi8(  //
+      +0x0F, +0x0C, +0x0D, +0x0E,          //
+      +0x0B, +0x08, +0x09, +0x0A,          //
+      +0x07, +0x04, +0x05, +0x06,          //
+      +0x03, +0x00, +0x01, +0x02,          //
+      +0x0F, +0x0C, +0x0D, +0x0E,          //
+      +0x0B, +0x08, +0x09, +0x0A,          //
+      +0x07, +0x04, +0x05, +0x06,          //
+      +0x03, +0x00, +0x01, +0x02);
+  const __m256i order = _mm256_set_epi32(7, 3, 6, 2, 5, 1, 4, 0);
+
+  while (n >= 8) {
+    __m256i s8 = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+    if (src_swap_rb) {
+      s8 = _mm256_shuffle_epi8(s8, swap32);
+    }
+
+    // Fast path: fully opaque pixels are unchanged.
+    if (_mm256_testc_si256(s8, alpha)) {
+      _mm256_storeu_si256((__m256i*)(void*)d, s8);
+      s += 8 * 4;
+      d += 8 * 4;
+      n -= 8;
+      continue;
+    }
+
+    __m128i slo = _mm256_castsi256_si128(s8);
+    __m128i shi = _mm256_extracti128_si256(s8, 1);
+    __m256i c0 = wuffs_private_impl__swizzle_nonpremul__convert_x86_avx2(
+        _mm256_cvtepu8_epi32(slo));
+    __m256i c1 = wuffs_private_impl__swizzle_nonpremul__convert_x86_avx2(
+        _mm256_cvtepu8_epi32(_mm_srli_si128(slo, 8)));
+    __m256i c2 = wuffs_private_impl__swizzle_nonpremul__convert_x86_avx2(
+        _mm256_cvtepu8_epi32(shi));
+    __m256i c3 = wuffs_private_impl__swizzle_nonpremul__convert_x86_avx2(
+        _mm256_cvtepu8_epi32(_mm_srli_si128(shi, 8)));
+
+    _mm256_storeu_si256(
+        (__m256i*)(void*)d,
+        _mm256_permutevar8x32_epi32(
+            _mm256_packus_epi16(_mm256_packus_epi32(c0, c1),
+                                _mm256_packus_epi32(c2, c3)),
+            order));
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  return len;
+}
+
+// wuffs_private_impl__swizzle_narrow__4x16le_x86_avx2 converts groups of 8
+// pixels from 4x16le to 4x8 (keeping the high byte of each channel),
+// optionally swapping the first and third channels, and returns the number of
+// pixels processed, a multiple of 8.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline WUFFS_BASE__FORCE_INLINE size_t  //
+wuffs_private_impl__swizzle_narrow__4x16le_x86_avx2(uint8_t* dst_ptr,
+                                                    size_t dst_len,
+                                                    const uint8_t* src_ptr,
+                                                    size_t src_len,
+                                                    bool swap_rb) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = ((dst_len4 < src_len8) ? dst_len4 : src_len8) & ~(size_t)7u;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  const __m256i swap32 = _mm256_set_epi8(  //
+      +0x0F, +0x0C, +0x0D, +0x0E,          //
+      +0x0B, +0x08, +0x09, +0x0A,          //
+      +0x07, +0x04, +0x05, +0x06,          //
+      +0x03, +0x00, +0x01, +0x02,          //
+      +0x0F, +0x0C, +0x0D, +0x0E,          //
+      +0x0B, +0x08, +0x09, +0x0A,          //
+      +0x07, +0x04, +0x05, +0x06,          //
+      +0x03, +0x00, +0x01, +0x02);
+
+  while (n >= 8) {
+    // _mm256_packus_epi16 works per 128-bit lane. The 0xD8 permutation puts
+    // the four 64-bit quarters (pixels 0..=1, 4..=5, 2..=3, 6..=7) in order.
+    __m256i x0 = _mm256_srli_epi16(
+        _mm256_lddqu_si256((const __m256i*)(const void*)(s + 0x00)), 8);
+    __m256i x1 = _mm256_srli_epi16(
+        _mm256_lddqu_si256((const __m256i*)(const void*)(s + 0x20)), 8);
+    __m256i x = _mm256_permute4x64_epi64(_mm256_packus_epi16(x0, x1), 0xD8);
+    if (swap_rb) {
+      x = _mm256_shuffle_epi8(x, swap32);
+    }
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 8;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_premul__nonpremul_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, false, false);
+  return n + wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src(
+                 dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_premul__nonpremul_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, false, true);
+  return n + wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src(
+                 dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_premul__nonpremul_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, true, false);
+  return n +
+         wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src(
+                     dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                     dst_palette_len, src_ptr + (8 * n), src_len - (8 * n));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_premul__nonpremul_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, true, true);
+  return n +
+         wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src(
+                     dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                     dst_palette_len, src_ptr + (8 * n), src_len - (8 * n));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_nonpremul__premul_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, false);
+  return n + wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src(
+                 dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_nonpremul__premul_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, true);
+  return n + wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src(
+                 dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                 dst_palette_len, src_ptr + (4 * n), src_len - (4 * n));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_bgra_nonpremul__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_narrow__4x16le_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, false);
+  return n +
+         wuffs_private_impl__swizzle_bgra_nonpremul__bgra_nonpremul_4x16le__src(
+                     dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                     dst_palette_len, src_ptr + (8 * n), src_len - (8 * n));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_private_impl__swizzle_rgba_nonpremul__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t n = wuffs_private_impl__swizzle_narrow__4x16le_x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, true);
+  return n +
+         wuffs_private_impl__swizzle_rgba_nonpremul__bgra_nonpremul_4x16le__src(
+                     dst_ptr + (4 * n), dst_len - (4 * n), dst_palette_ptr,
+                     dst_palette_len, src_ptr + (8 * n), src_len - (8 * n));
+}
 #endif  // defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
 // ‼ WUFFS MULTI-FILE SECTION -x86_avx2
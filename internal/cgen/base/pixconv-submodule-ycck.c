@@ -33,6 +33,54 @@ wuffs_private_impl__swizzle_ycc__convert_3_rgbx_x86_avx2(
     const uint8_t* up1,
     const uint8_t* up2);
 
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_cmyk__convert_4_bgrx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_cmyk__convert_4_rgbx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_ycck__convert_4_bgrx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_ycck__convert_4_rgbx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
 #if defined(__GNUC__) && !defined(__clang__)
 // No-op.
 #else
@@ -47,8 +95,149 @@ wuffs_private_impl__swizzle_ycc__upsample_inv_h2v2_triangle_x86_avx2(
     bool first_column,
     bool last_column);
 #endif
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h1v2_triangle_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias,
+    bool first_column,
+    bool last_column);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h2v1_triangle_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias,
+    bool first_column,
+    bool last_column);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h2vn_box_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias,
+    bool first_column,
+    bool last_column);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h3vn_box_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias,
+    bool first_column,
+    bool last_column);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h4vn_box_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias,
+    bool first_column,
+    bool last_column);
 #endif  // defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
 
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+static void  //
+wuffs_private_impl__swizzle_ycc__convert_3_bgrx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2);
+
+static void  //
+wuffs_private_impl__swizzle_ycc__convert_3_rgbx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2);
+
+static void  //
+wuffs_private_impl__swizzle_cmyk__convert_4_bgrx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
+static void  //
+wuffs_private_impl__swizzle_cmyk__convert_4_rgbx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
+static void  //
+wuffs_private_impl__swizzle_ycck__convert_4_bgrx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
+static void  //
+wuffs_private_impl__swizzle_ycck__convert_4_rgbx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h2v1_triangle_arm_neon(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column,
+    bool last_column);
+
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h2v2_triangle_arm_neon(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column,
+    bool last_column);
+#endif  // defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+
 // --------
 
 static inline uint32_t  //
@@ -525,7 +714,8 @@ wuffs_private_impl__swizzle_has_triangle_upsampler(uint32_t inv_h,
 static void  //
 wuffs_private_impl__swizzle_ycck__general__triangle_filter_edge_row(
     wuffs_base__pixel_buffer* dst,
-    uint32_t width,
+    uint32_t x_min_incl,
+    uint32_t x_max_excl,
     uint32_t y,
     const uint8_t* src_ptr0,
     const uint8_t* src_ptr1,
@@ -555,17 +745,17 @@ wuffs_private_impl__swizzle_ycck__general__triangle_filter_edge_row(
   const uint8_t* src1 = src_ptr1 + ((y / inv_v1) * (size_t)stride1);
   const uint8_t* src2 = src_ptr2 + ((y / inv_v2) * (size_t)stride2);
   const uint8_t* src3 = src_ptr3 + ((y / inv_v3) * (size_t)stride3);
-  uint32_t total_src_len0 = 0u;
-  uint32_t total_src_len1 = 0u;
-  uint32_t total_src_len2 = 0u;
-  uint32_t total_src_len3 = 0u;
+  uint32_t total_src_len0 = x_min_incl / inv_h0;
+  uint32_t total_src_len1 = x_min_incl / inv_h1;
+  uint32_t total_src_len2 = x_min_incl / inv_h2;
+  uint32_t total_src_len3 = x_min_incl / inv_h3;
 
-  uint32_t x = 0u;
-  while (x < width) {
+  uint32_t x = x_min_incl;
+  while (x < x_max_excl) {
     bool first_column = x == 0u;
     uint32_t end = x + 480u;
-    if (end > width) {
-      end = width;
+    if (end > x_max_excl) {
+      end = x_max_excl;
     }
 
     uint32_t src_len0 = ((end - x) + inv_h0 - 1u) / inv_h0;
@@ -650,10 +840,6 @@ wuffs_private_impl__swizzle_ycck__general__triangle_filter(
     uint8_t* scratch_buffer_2k_ptr,
     wuffs_private_impl__swizzle_ycc__upsample_func (*upfuncs)[4][4],
     wuffs_private_impl__swizzle_ycc__convert_4_func conv4func) {
-  if ((x_min_incl != 0) || (y_min_incl != 0)) {
-    return;
-  }
-
   wuffs_private_impl__swizzle_ycc__upsample_func upfunc0 =
       (*upfuncs)[(inv_h0 - 1u) & 3u][(inv_v0 - 1u) & 3u];
   wuffs_private_impl__swizzle_ycc__upsample_func upfunc1 =
@@ -664,24 +850,27 @@ wuffs_private_impl__swizzle_ycck__general__triangle_filter(
       (*upfuncs)[(inv_h3 - 1u) & 3u][(inv_v3 - 1u) & 3u];
 
   // First row.
-  uint32_t h1v2_bias = 1u;
-  wuffs_private_impl__swizzle_ycck__general__triangle_filter_edge_row(
-      dst, x_max_excl, 0u,                     //
-      src_ptr0, src_ptr1, src_ptr2, src_ptr3,  //
-      stride0, stride1, stride2, stride3,      //
-      inv_h0, inv_h1, inv_h2, inv_h3,          //
-      inv_v0, inv_v1, inv_v2, inv_v3,          //
-      half_width_for_2to1,                     //
-      h1v2_bias,                               //
-      scratch_buffer_2k_ptr,                   //
-      upfunc0, upfunc1, upfunc2, upfunc3, conv4func);
-  h1v2_bias = 2u;
+  uint32_t y = y_min_incl;
+  uint32_t h1v2_bias = (y & 1u) ? 2u : 1u;
+  if (y == 0u) {
+    wuffs_private_impl__swizzle_ycck__general__triangle_filter_edge_row(
+        dst, x_min_incl, x_max_excl, 0u,         //
+        src_ptr0, src_ptr1, src_ptr2, src_ptr3,  //
+        stride0, stride1, stride2, stride3,      //
+        inv_h0, inv_h1, inv_h2, inv_h3,          //
+        inv_v0, inv_v1, inv_v2, inv_v3,          //
+        half_width_for_2to1,                     //
+        h1v2_bias,                               //
+        scratch_buffer_2k_ptr,                   //
+        upfunc0, upfunc1, upfunc2, upfunc3, conv4func);
+    h1v2_bias = 2u;
+    y = 1u;
+  }
 
   // Middle rows.
   bool last_row = y_max_excl == 2u * half_height_for_2to1;
   uint32_t middle_y_max_excl = last_row ? (y_max_excl - 1u) : y_max_excl;
-  uint32_t y;
-  for (y = 1u; y < middle_y_max_excl; y++) {
+  for (; y < middle_y_max_excl; y++) {
     const uint8_t* src0_major = src_ptr0 + ((y / inv_v0) * (size_t)stride0);
     const uint8_t* src0_minor =
         (inv_v0 != 2u)
@@ -702,12 +891,12 @@ wuffs_private_impl__swizzle_ycck__general__triangle_filter(
         (inv_v3 != 2u)
             ? src3_major
             : ((y & 1u) ? (src3_major + stride3) : (src3_major - stride3));
-    uint32_t total_src_len0 = 0u;
-    uint32_t total_src_len1 = 0u;
-    uint32_t total_src_len2 = 0u;
-    uint32_t total_src_len3 = 0u;
+    uint32_t total_src_len0 = x_min_incl / inv_h0;
+    uint32_t total_src_len1 = x_min_incl / inv_h1;
+    uint32_t total_src_len2 = x_min_incl / inv_h2;
+    uint32_t total_src_len3 = x_min_incl / inv_h3;
 
-    uint32_t x = 0u;
+    uint32_t x = x_min_incl;
     while (x < x_max_excl) {
       bool first_column = x == 0u;
       uint32_t end = x + 480u;
@@ -770,14 +959,14 @@ wuffs_private_impl__swizzle_ycck__general__triangle_filter(
   // Last row.
   if (middle_y_max_excl != y_max_excl) {
     wuffs_private_impl__swizzle_ycck__general__triangle_filter_edge_row(
-        dst, x_max_excl, middle_y_max_excl,      //
-        src_ptr0, src_ptr1, src_ptr2, src_ptr3,  //
-        stride0, stride1, stride2, stride3,      //
-        inv_h0, inv_h1, inv_h2, inv_h3,          //
-        inv_v0, inv_v1, inv_v2, inv_v3,          //
-        half_width_for_2to1,                     //
-        h1v2_bias,                               //
-        scratch_buffer_2k_ptr,                   //
+        dst, x_min_incl, x_max_excl, middle_y_max_excl,  //
+        src_ptr0, src_ptr1, src_ptr2, src_ptr3,          //
+        stride0, stride1, stride2, stride3,              //
+        inv_h0, inv_h1, inv_h2, inv_h3,                  //
+        inv_v0, inv_v1, inv_v2, inv_v3,                  //
+        half_width_for_2to1,                             //
+        h1v2_bias,                                       //
+        scratch_buffer_2k_ptr,                           //
         upfunc0, upfunc1, upfunc2, upfunc3, conv4func);
   }
 }
@@ -785,7 +974,8 @@ wuffs_private_impl__swizzle_ycck__general__triangle_filter(
 static void  //
 wuffs_private_impl__swizzle_ycc__general__triangle_filter_edge_row(
     wuffs_base__pixel_buffer* dst,
-    uint32_t width,
+    uint32_t x_min_incl,
+    uint32_t x_max_excl,
     uint32_t y,
     const uint8_t* src_ptr0,
     const uint8_t* src_ptr1,
@@ -809,16 +999,16 @@ wuffs_private_impl__swizzle_ycc__general__triangle_filter_edge_row(
   const uint8_t* src0 = src_ptr0 + ((y / inv_v0) * (size_t)stride0);
   const uint8_t* src1 = src_ptr1 + ((y / inv_v1) * (size_t)stride1);
   const uint8_t* src2 = src_ptr2 + ((y / inv_v2) * (size_t)stride2);
-  uint32_t total_src_len0 = 0u;
-  uint32_t total_src_len1 = 0u;
-  uint32_t total_src_len2 = 0u;
+  uint32_t total_src_len0 = x_min_incl / inv_h0;
+  uint32_t total_src_len1 = x_min_incl / inv_h1;
+  uint32_t total_src_len2 = x_min_incl / inv_h2;
 
-  uint32_t x = 0u;
-  while (x < width) {
+  uint32_t x = x_min_incl;
+  while (x < x_max_excl) {
     bool first_column = x == 0u;
     uint32_t end = x + 672u;
-    if (end > width) {
-      end = width;
+    if (end > x_max_excl) {
+      end = x_max_excl;
     }
 
     uint32_t src_len0 = ((end - x) + inv_h0 - 1u) / inv_h0;
@@ -887,10 +1077,6 @@ wuffs_private_impl__swizzle_ycc__general__triangle_filter(
     uint8_t* scratch_buffer_2k_ptr,
     wuffs_private_impl__swizzle_ycc__upsample_func (*upfuncs)[4][4],
     wuffs_private_impl__swizzle_ycc__convert_3_func conv3func) {
-  if ((x_min_incl != 0) || (y_min_incl != 0)) {
-    return;
-  }
-
   wuffs_private_impl__swizzle_ycc__upsample_func upfunc0 =
       (*upfuncs)[(inv_h0 - 1u) & 3u][(inv_v0 - 1u) & 3u];
   wuffs_private_impl__swizzle_ycc__upsample_func upfunc1 =
@@ -899,24 +1085,27 @@ wuffs_private_impl__swizzle_ycc__general__triangle_filter(
       (*upfuncs)[(inv_h2 - 1u) & 3u][(inv_v2 - 1u) & 3u];
 
   // First row.
-  uint32_t h1v2_bias = 1u;
-  wuffs_private_impl__swizzle_ycc__general__triangle_filter_edge_row(
-      dst, x_max_excl, 0u,           //
-      src_ptr0, src_ptr1, src_ptr2,  //
-      stride0, stride1, stride2,     //
-      inv_h0, inv_h1, inv_h2,        //
-      inv_v0, inv_v1, inv_v2,        //
-      half_width_for_2to1,           //
-      h1v2_bias,                     //
-      scratch_buffer_2k_ptr,         //
-      upfunc0, upfunc1, upfunc2, conv3func);
-  h1v2_bias = 2u;
+  uint32_t y = y_min_incl;
+  uint32_t h1v2_bias = (y & 1u) ? 2u : 1u;
+  if (y == 0u) {
+    wuffs_private_impl__swizzle_ycc__general__triangle_filter_edge_row(
+        dst, x_min_incl, x_max_excl, 0u,  //
+        src_ptr0, src_ptr1, src_ptr2,     //
+        stride0, stride1, stride2,        //
+        inv_h0, inv_h1, inv_h2,           //
+        inv_v0, inv_v1, inv_v2,           //
+        half_width_for_2to1,              //
+        h1v2_bias,                        //
+        scratch_buffer_2k_ptr,            //
+        upfunc0, upfunc1, upfunc2, conv3func);
+    h1v2_bias = 2u;
+    y = 1u;
+  }
 
   // Middle rows.
   bool last_row = y_max_excl == 2u * half_height_for_2to1;
   uint32_t middle_y_max_excl = last_row ? (y_max_excl - 1u) : y_max_excl;
-  uint32_t y;
-  for (y = 1u; y < middle_y_max_excl; y++) {
+  for (; y < middle_y_max_excl; y++) {
     const uint8_t* src0_major = src_ptr0 + ((y / inv_v0) * (size_t)stride0);
     const uint8_t* src0_minor =
         (inv_v0 != 2u)
@@ -932,11 +1121,11 @@ wuffs_private_impl__swizzle_ycc__general__triangle_filter(
         (inv_v2 != 2u)
             ? src2_major
             : ((y & 1u) ? (src2_major + stride2) : (src2_major - stride2));
-    uint32_t total_src_len0 = 0u;
-    uint32_t total_src_len1 = 0u;
-    uint32_t total_src_len2 = 0u;
+    uint32_t total_src_len0 = x_min_incl / inv_h0;
+    uint32_t total_src_len1 = x_min_incl / inv_h1;
+    uint32_t total_src_len2 = x_min_incl / inv_h2;
 
-    uint32_t x = 0u;
+    uint32_t x = x_min_incl;
     while (x < x_max_excl) {
       bool first_column = x == 0u;
       uint32_t end = x + 672u;
@@ -988,14 +1177,14 @@ wuffs_private_impl__swizzle_ycc__general__triangle_filter(
   // Last row.
   if (middle_y_max_excl != y_max_excl) {
     wuffs_private_impl__swizzle_ycc__general__triangle_filter_edge_row(
-        dst, x_max_excl, middle_y_max_excl,  //
-        src_ptr0, src_ptr1, src_ptr2,        //
-        stride0, stride1, stride2,           //
-        inv_h0, inv_h1, inv_h2,              //
-        inv_v0, inv_v1, inv_v2,              //
-        half_width_for_2to1,                 //
-        h1v2_bias,                           //
-        scratch_buffer_2k_ptr,               //
+        dst, x_min_incl, x_max_excl, middle_y_max_excl,  //
+        src_ptr0, src_ptr1, src_ptr2,                    //
+        stride0, stride1, stride2,                       //
+        inv_h0, inv_h1, inv_h2,                          //
+        inv_v0, inv_v1, inv_v2,                          //
+        half_width_for_2to1,                             //
+        h1v2_bias,                                       //
+        scratch_buffer_2k_ptr,                           //
         upfunc0, upfunc1, upfunc2, conv3func);
   }
 }
@@ -1191,6 +1380,67 @@ wuffs_private_impl__swizzle_flattened_length(uint32_t width,
   return ((scaled_height - 1u) * stride) + scaled_width;
 }
 
+// wuffs_private_impl__swizzle_ycc__planar copies the (y_min_incl ..
+// y_max_excl, x_min_incl .. x_max_excl) pixels' samples from the srcN planes
+// to the dst planes as is, without upsampling or color conversion. The dst
+// pixel buffer's pixel subsampling has to match the srcN subsampling ratios.
+static wuffs_base__status  //
+wuffs_private_impl__swizzle_ycc__planar(wuffs_base__pixel_buffer* dst,
+                                        uint32_t x_min_incl,
+                                        uint32_t x_max_excl,
+                                        uint32_t y_min_incl,
+                                        uint32_t y_max_excl,
+                                        uint32_t src_x_min_incl,
+                                        uint32_t src_y_min_incl,
+                                        const wuffs_base__slice_u8* srcs,
+                                        const uint32_t* strides,
+                                        const uint32_t* inv_hs,
+                                        const uint32_t* inv_vs) {
+  const wuffs_base__pixel_subsampling* pixsub =
+      &dst->pixcfg.private_impl.pixsub;
+  uint32_t p;
+  for (p = 0; p < 3; p++) {
+    uint32_t inv_h = inv_hs[p];
+    uint32_t inv_v = inv_vs[p];
+    if ((wuffs_base__pixel_subsampling__bias_x(pixsub, p) != 0) ||
+        (wuffs_base__pixel_subsampling__bias_y(pixsub, p) != 0) ||
+        (wuffs_base__pixel_subsampling__denominator_x(pixsub, p) != inv_h) ||
+        (wuffs_base__pixel_subsampling__denominator_y(pixsub, p) != inv_v)) {
+      return wuffs_base__make_status(
+          wuffs_base__error__unsupported_pixel_swizzler_option);
+    }
+    const wuffs_base__table_u8* tab = &dst->private_impl.planes[p];
+    if ((((x_max_excl + inv_h - 1u) / inv_h) > tab->width) ||
+        (((y_max_excl + inv_v - 1u) / inv_v) > tab->height)) {
+      return wuffs_base__make_status(wuffs_base__error__bad_argument);
+    }
+  }
+
+  for (p = 0; p < 3; p++) {
+    uint32_t inv_h = inv_hs[p];
+    uint32_t inv_v = inv_vs[p];
+    uint32_t i0 = x_min_incl / inv_h;
+    uint32_t i1 = (x_max_excl + inv_h - 1u) / inv_h;
+    uint32_t j0 = y_min_incl / inv_v;
+    uint32_t j1 = (y_max_excl + inv_v - 1u) / inv_v;
+
+    const wuffs_base__table_u8* tab = &dst->private_impl.planes[p];
+    uint8_t* dst_ptr = tab->ptr + (((size_t)j0) * tab->stride) + i0;
+    const uint8_t* src_ptr =
+        srcs[p].ptr +
+        (((size_t)(j0 - (src_y_min_incl / inv_v))) * strides[p]) +
+        (i0 - (src_x_min_incl / inv_h));
+    size_t n = i1 - i0;
+    uint32_t j;
+    for (j = j0; j < j1; j++) {
+      memcpy(dst_ptr, src_ptr, n);
+      dst_ptr += tab->stride;
+      src_ptr += strides[p];
+    }
+  }
+  return wuffs_base__make_status(NULL);
+}
+
 WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
 wuffs_base__pixel_swizzler__swizzle_ycck(
     const wuffs_base__pixel_swizzler* p,
@@ -1200,6 +1450,7 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
     uint32_t x_max_excl,
     uint32_t y_min_incl,
     uint32_t y_max_excl,
+    uint32_t src_y_min_incl,
     wuffs_base__slice_u8 src0,
     wuffs_base__slice_u8 src1,
     wuffs_base__slice_u8 src2,
@@ -1234,13 +1485,13 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
              (x_max_excl > 0xFFFFu) ||           //
              (y_min_incl > y_max_excl) ||        //
              (y_max_excl > 0xFFFFu) ||           //
+             (src_y_min_incl > y_min_incl) ||    //
              (4u <= ((unsigned int)h0 - 1u)) ||  //
              (4u <= ((unsigned int)h1 - 1u)) ||  //
              (4u <= ((unsigned int)h2 - 1u)) ||  //
              (4u <= ((unsigned int)v0 - 1u)) ||  //
              (4u <= ((unsigned int)v1 - 1u)) ||  //
              (4u <= ((unsigned int)v2 - 1u)) ||  //
-             (triangle_filter_for_2to1 && ((x_min_incl | y_min_incl) > 0u)) ||
              (scratch_buffer_2k.len < 2048u)) {
     return wuffs_base__make_status(wuffs_base__error__bad_argument);
   }
@@ -1279,8 +1530,31 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
       return wuffs_base__make_status(wuffs_base__error__bad_argument);
     }
   }
+  if (src_y_min_incl != 0) {
+    if ((src_y_min_incl % inv_v0) || (src_y_min_incl % inv_v1) ||
+        (src_y_min_incl % inv_v2) || (inv_v3 && (src_y_min_incl % inv_v3))) {
+      return wuffs_base__make_status(wuffs_base__error__bad_argument);
+    }
+  }
+
+  // The srcN slices start at the (src_x_min_incl, src_y_min_incl) pixel. When
+  // triangle_filter_for_2to1 is true, src_x_min_incl is zero, even when
+  // x_min_incl is positive, as triangle filtering a pixel can also read the
+  // (subsampled) pixels around it. Likewise, src_y_min_incl has to be either
+  // zero or less than y_min_incl, so that there's a (subsampled) row above.
+  // Otherwise, src_x_min_incl is x_min_incl and src_y_min_incl can be up to
+  // y_min_incl.
+  uint32_t src_x_min_incl = triangle_filter_for_2to1 ? 0u : x_min_incl;
+  if (triangle_filter_for_2to1 && (src_y_min_incl != 0) &&
+      (src_y_min_incl == y_min_incl) && (y_min_incl < y_max_excl)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
 
-  uint32_t half_width_for_2to1 = ((x_max_excl - x_min_incl) + 1u) / 2u;
+  // The triangle filter's right column replicates the last column of any 2:1
+  // horizontally subsampled plane. That column is at the right edge of the
+  // image, not the right edge of the (possibly cropped) x_max_excl.
+  uint32_t half_width_for_2to1 =
+      (wuffs_base__pixel_config__width(&dst->pixcfg) + 1u) / 2u;
   if (inv_h0 == 2) {
     half_width_for_2to1 = wuffs_base__u32__min(half_width_for_2to1, width0);
   }
@@ -1294,7 +1568,10 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
     half_width_for_2to1 = wuffs_base__u32__min(half_width_for_2to1, width3);
   }
 
-  uint32_t half_height_for_2to1 = ((y_max_excl - y_min_incl) + 1u) / 2u;
+  // The triangle filter's bottom row replicates the last row of any 2:1
+  // vertically subsampled plane, so the heightN arguments should be exact
+  // (not rounded up to e.g. a multiple of 8) for those planes.
+  uint32_t half_height_for_2to1 = 0xFFFFu;
   if (inv_v0 == 2) {
     half_height_for_2to1 = wuffs_base__u32__min(half_height_for_2to1, height0);
   }
@@ -1308,28 +1585,35 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
     half_height_for_2to1 = wuffs_base__u32__min(half_height_for_2to1, height3);
   }
 
-  x_max_excl = wuffs_base__u32__min(                   //
-      wuffs_base__pixel_config__width(&dst->pixcfg),   //
-      x_min_incl + wuffs_private_impl__u32__min_of_5(  //
-                       x_max_excl - x_min_incl,        //
-                       width0 * inv_h0,                //
-                       width1 * inv_h1,                //
-                       width2 * inv_h2,                //
-                       inv_h3 ? (width3 * inv_h3) : 0xFFFFFFFF));
-  y_max_excl = wuffs_base__u32__min(                   //
-      wuffs_base__pixel_config__height(&dst->pixcfg),  //
-      y_min_incl + wuffs_private_impl__u32__min_of_5(  //
-                       y_max_excl - y_min_incl,        //
-                       height0 * inv_v0,               //
-                       height1 * inv_v1,               //
-                       height2 * inv_v2,               //
-                       inv_v3 ? (height3 * inv_v3) : 0xFFFFFFFF));
+  x_max_excl = wuffs_base__u32__min(                       //
+      wuffs_base__pixel_config__width(&dst->pixcfg),       //
+      src_x_min_incl + wuffs_private_impl__u32__min_of_5(  //
+                           x_max_excl - src_x_min_incl,    //
+                           width0 * inv_h0,                //
+                           width1 * inv_h1,                //
+                           width2 * inv_h2,                //
+                           inv_h3 ? (width3 * inv_h3) : 0xFFFFFFFF));
+
+  y_max_excl = wuffs_base__u32__min(                       //
+      wuffs_base__pixel_config__height(&dst->pixcfg),      //
+      src_y_min_incl + wuffs_private_impl__u32__min_of_5(  //
+                           y_max_excl - src_y_min_incl,    //
+                           height0 * inv_v0,               //
+                           height1 * inv_v1,               //
+                           height2 * inv_v2,               //
+                           inv_v3 ? (height3 * inv_v3) : 0xFFFFFFFF));
 
   if ((x_min_incl >= x_max_excl) || (y_min_incl >= y_max_excl)) {
     return wuffs_base__make_status(NULL);
   }
-  uint32_t width = x_max_excl - x_min_incl;
-  uint32_t height = y_max_excl - y_min_incl;
+  // The triangle filter's right column can also read the (subsampled) column
+  // to its right, if that's within the widthN columns.
+  uint32_t width = (x_max_excl - src_x_min_incl) +
+                   (triangle_filter_for_2to1 ? 2u : 0u);
+  // The triangle filter's bottom row can also read the (subsampled) row
+  // below, if that's within the heightN rows.
+  uint32_t height = (y_max_excl - src_y_min_incl) +
+                    (triangle_filter_for_2to1 ? 1u : 0u);
 
   if (((h0 * inv_h0) != max_incl_h) ||  //
       ((h1 * inv_h1) != max_incl_h) ||  //
@@ -1338,26 +1622,52 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
       ((v1 * inv_v1) != max_incl_v) ||  //
       ((v2 * inv_v2) != max_incl_v) ||  //
       (src0.len < wuffs_private_impl__swizzle_flattened_length(
-                      width, height, stride0, inv_h0, inv_v0)) ||
+                      wuffs_base__u32__min(width, width0 * inv_h0),
+                      wuffs_base__u32__min(height, height0 * inv_v0),
+                      stride0, inv_h0, inv_v0)) ||
       (src1.len < wuffs_private_impl__swizzle_flattened_length(
-                      width, height, stride1, inv_h1, inv_v1)) ||
+                      wuffs_base__u32__min(width, width1 * inv_h1),
+                      wuffs_base__u32__min(height, height1 * inv_v1),
+                      stride1, inv_h1, inv_v1)) ||
       (src2.len < wuffs_private_impl__swizzle_flattened_length(
-                      width, height, stride2, inv_h2, inv_v2))) {
+                      wuffs_base__u32__min(width, width2 * inv_h2),
+                      wuffs_base__u32__min(height, height2 * inv_v2),
+                      stride2, inv_h2, inv_v2))) {
     return wuffs_base__make_status(wuffs_base__error__bad_argument);
   }
   if ((h3 != 0u) || (v3 != 0u)) {
     if (((h3 * inv_h3) != max_incl_h) ||  //
         ((v3 * inv_v3) != max_incl_v) ||  //
         (src3.len < wuffs_private_impl__swizzle_flattened_length(
-                        width, height, stride3, inv_h3, inv_v3))) {
+                        wuffs_base__u32__min(width, width3 * inv_h3),
+                        wuffs_base__u32__min(height, height3 * inv_v3),
+                        stride3, inv_h3, inv_v3))) {
       return wuffs_base__make_status(wuffs_base__error__bad_argument);
     }
   }
 
   if (wuffs_base__pixel_format__is_planar(&dst->pixcfg.private_impl.pixfmt)) {
-    // TODO: see wuffs_base__pixel_buffer__set_color_u32_at's TODO.
+#if defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST)
     return wuffs_base__make_status(
-        wuffs_base__error__unsupported_pixel_swizzler_option);
+        wuffs_base__error__disabled_by_wuffs_config_dst_pixel_format_enable_allowlist);
+#else
+    // Planar YCbCr output skips upsampling and color conversion.
+    //
+    // TODO: support other planar pixel formats, e.g. YCbCrK.
+    if ((dst->pixcfg.private_impl.pixfmt.repr !=
+         WUFFS_BASE__PIXEL_FORMAT__YCBCR) ||
+        is_rgb_or_cmyk || (h3 != 0u) || (v3 != 0u)) {
+      return wuffs_base__make_status(
+          wuffs_base__error__unsupported_pixel_swizzler_option);
+    }
+    wuffs_base__slice_u8 srcs[3] = {src0, src1, src2};
+    uint32_t strides[3] = {stride0, stride1, stride2};
+    uint32_t inv_hs[3] = {inv_h0, inv_h1, inv_h2};
+    uint32_t inv_vs[3] = {inv_v0, inv_v1, inv_v2};
+    return wuffs_private_impl__swizzle_ycc__planar(
+        dst, x_min_incl, x_max_excl, y_min_incl, y_max_excl, src_x_min_incl,
+        src_y_min_incl, srcs, strides, inv_hs, inv_vs);
+#endif  // defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST)
   }
 
   // ----
@@ -1448,6 +1758,12 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
           conv3func = &wuffs_private_impl__swizzle_ycc__convert_3_bgrx_x86_avx2;
           break;
         }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+        if (wuffs_base__cpu_arch__have_arm_neon()) {
+          conv3func = &wuffs_private_impl__swizzle_ycc__convert_3_bgrx_arm_neon;
+          break;
+        }
 #endif
         conv3func = &wuffs_private_impl__swizzle_ycc__convert_3_bgrx;
         break;
@@ -1459,6 +1775,12 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
           conv3func = &wuffs_private_impl__swizzle_ycc__convert_3_rgbx_x86_avx2;
           break;
         }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+        if (wuffs_base__cpu_arch__have_arm_neon()) {
+          conv3func = &wuffs_private_impl__swizzle_ycc__convert_3_rgbx_arm_neon;
+          break;
+        }
 #endif
         conv3func = &wuffs_private_impl__swizzle_ycc__convert_3_rgbx;
         break;
@@ -1468,6 +1790,57 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
     }
   }
 
+  wuffs_private_impl__swizzle_ycc__convert_4_func conv4func =
+      is_rgb_or_cmyk ? &wuffs_private_impl__swizzle_cmyk__convert_4_general
+                     : &wuffs_private_impl__swizzle_ycck__convert_4_general;
+
+  switch (dst->pixcfg.private_impl.pixfmt.repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        conv4func =
+            is_rgb_or_cmyk
+                ? &wuffs_private_impl__swizzle_cmyk__convert_4_bgrx_x86_avx2
+                : &wuffs_private_impl__swizzle_ycck__convert_4_bgrx_x86_avx2;
+        break;
+      }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+      if (wuffs_base__cpu_arch__have_arm_neon()) {
+        conv4func =
+            is_rgb_or_cmyk
+                ? &wuffs_private_impl__swizzle_cmyk__convert_4_bgrx_arm_neon
+                : &wuffs_private_impl__swizzle_ycck__convert_4_bgrx_arm_neon;
+        break;
+      }
+#endif
+      break;
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        conv4func =
+            is_rgb_or_cmyk
+                ? &wuffs_private_impl__swizzle_cmyk__convert_4_rgbx_x86_avx2
+                : &wuffs_private_impl__swizzle_ycck__convert_4_rgbx_x86_avx2;
+        break;
+      }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+      if (wuffs_base__cpu_arch__have_arm_neon()) {
+        conv4func =
+            is_rgb_or_cmyk
+                ? &wuffs_private_impl__swizzle_cmyk__convert_4_rgbx_arm_neon
+                : &wuffs_private_impl__swizzle_ycck__convert_4_rgbx_arm_neon;
+        break;
+      }
+#endif
+      break;
+  }
+
   void (*func3)(wuffs_base__pixel_buffer * dst,  //
                 uint32_t x_min_incl,             //
                 uint32_t x_max_excl,             //
@@ -1524,6 +1897,21 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
   memcpy(&upfuncs, &wuffs_private_impl__swizzle_ycc__upsample_funcs,
          sizeof upfuncs);
 
+  wuffs_base__pixel_buffer shifted_dst;
+
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+  if (wuffs_base__cpu_arch__have_x86_avx2()) {
+    for (uint32_t i = 0; i < 4; i++) {
+      upfuncs[1][i] =
+          wuffs_private_impl__swizzle_ycc__upsample_inv_h2vn_box_x86_avx2;
+      upfuncs[2][i] =
+          wuffs_private_impl__swizzle_ycc__upsample_inv_h3vn_box_x86_avx2;
+      upfuncs[3][i] =
+          wuffs_private_impl__swizzle_ycc__upsample_inv_h4vn_box_x86_avx2;
+    }
+  }
+#endif
+
   if (triangle_filter_for_2to1 &&
       (wuffs_private_impl__swizzle_has_triangle_upsampler(inv_h0, inv_v0) ||
        wuffs_private_impl__swizzle_has_triangle_upsampler(inv_h1, inv_v1) ||
@@ -1555,13 +1943,52 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
           wuffs_private_impl__swizzle_ycc__upsample_inv_h2v2_triangle_x86_avx2;
     }
 #endif
+    if (wuffs_base__cpu_arch__have_x86_avx2()) {
+      upfuncs[0][1] =
+          wuffs_private_impl__swizzle_ycc__upsample_inv_h1v2_triangle_x86_avx2;
+      upfuncs[1][0] =
+          wuffs_private_impl__swizzle_ycc__upsample_inv_h2v1_triangle_x86_avx2;
+    }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+    if (wuffs_base__cpu_arch__have_arm_neon()) {
+      upfuncs[1][0] =
+          wuffs_private_impl__swizzle_ycc__upsample_inv_h2v1_triangle_arm_neon;
+      upfuncs[1][1] =
+          wuffs_private_impl__swizzle_ycc__upsample_inv_h2v2_triangle_arm_neon;
+    }
 #endif
+
+    // The triangle filter's src_ptrN arguments start at the image's top row.
+    // When the srcN slices start lower down, shift the dst pixel buffer (and
+    // the y coordinates) to match. Its top row is then never written to, as
+    // src_y_min_incl is less than y_min_incl.
+    if (src_y_min_incl != 0) {
+      shifted_dst = *dst;
+      shifted_dst.pixcfg.private_impl.height -= src_y_min_incl;
+      shifted_dst.private_impl.planes[0].ptr +=
+          ((size_t)src_y_min_incl) * dst->private_impl.planes[0].stride;
+      shifted_dst.private_impl.planes[0].height -= src_y_min_incl;
+      dst = &shifted_dst;
+      y_min_incl -= src_y_min_incl;
+      y_max_excl -= src_y_min_incl;
+    }
+
+  } else if ((src_x_min_incl != x_min_incl) ||
+             (src_y_min_incl != y_min_incl)) {
+    // The box filter's src_ptrN arguments start at the (x_min_incl,
+    // y_min_incl) pixel.
+    uint32_t dx = x_min_incl - src_x_min_incl;
+    uint32_t dy = y_min_incl - src_y_min_incl;
+    src0.ptr += ((dy / inv_v0) * (size_t)stride0) + (dx / inv_h0);
+    src1.ptr += ((dy / inv_v1) * (size_t)stride1) + (dx / inv_h1);
+    src2.ptr += ((dy / inv_v2) * (size_t)stride2) + (dx / inv_h2);
+    if (inv_v3) {
+      src3.ptr += ((dy / inv_v3) * (size_t)stride3) + (dx / inv_h3);
+    }
   }
 
   if ((h3 != 0u) || (v3 != 0u)) {
-    wuffs_private_impl__swizzle_ycc__convert_4_func conv4func =
-        is_rgb_or_cmyk ? &wuffs_private_impl__swizzle_cmyk__convert_4_general
-                       : &wuffs_private_impl__swizzle_ycck__convert_4_general;
     (*func4)(                                                 //
         dst, x_min_incl, x_max_excl, y_min_incl, y_max_excl,  //
         src0.ptr, src1.ptr, src2.ptr, src3.ptr,               //
@@ -58,6 +58,30 @@ wuffs_private_impl__range_ie_u64__get_max_excl(
   return r->max_excl;
 }
 
+static inline uint32_t  //
+wuffs_private_impl__rect_ie_u32__get_min_incl_x(
+    const wuffs_base__rect_ie_u32* r) {
+  return r->min_incl_x;
+}
+
+static inline uint32_t  //
+wuffs_private_impl__rect_ie_u32__get_min_incl_y(
+    const wuffs_base__rect_ie_u32* r) {
+  return r->min_incl_y;
+}
+
+static inline uint32_t  //
+wuffs_private_impl__rect_ie_u32__get_max_excl_x(
+    const wuffs_base__rect_ie_u32* r) {
+  return r->max_excl_x;
+}
+
+static inline uint32_t  //
+wuffs_private_impl__rect_ie_u32__get_max_excl_y(
+    const wuffs_base__rect_ie_u32* r) {
+  return r->max_excl_y;
+}
+
 // ---------------- Ranges and Rects (Utility)
 
 #define wuffs_base__utility__empty_range_ii_u32 wuffs_base__empty_range_ii_u32
@@ -93,6 +93,15 @@ func (g *gen) writeBuiltinCall(b *buffer, n *a.Expr, sideEffectsOnly bool, depth
 		return g.writeBuiltinNumType(b, recv, method.Ident(), n.Args(), depth)
 	} else if qid[1].IsBuiltInCPUArch() {
 		return g.writeBuiltinCPUArch(b, recv, method.Ident(), n.MType(), n.Args(), sideEffectsOnly, depth)
+	} else if qid[1].IsRangeType() || qid[1].IsRectType() {
+		if s := method.Ident().Str(g.tm); strings.HasPrefix(s, "get_") {
+			b.printf("wuffs_private_impl__%s__%s(&", qid[1].Str(g.tm), s)
+			if err := g.writeExpr(b, recv, false, depth); err != nil {
+				return err
+			}
+			b.writeb(')')
+			return nil
+		}
 	} else {
 		switch qid[1] {
 		case t.IDIOReader:
@@ -101,13 +110,11 @@ func (g *gen) writeBuiltinCall(b *buffer, n *a.Expr, sideEffectsOnly bool, depth
 			return g.writeBuiltinIOWriter(b, recv, method.Ident(), n.Args(), sideEffectsOnly, depth)
 		case t.IDPixelSwizzler:
 			switch method.Ident() {
-			case t.IDLimitedSwizzleU32InterleavedFromReader, t.IDSwizzleInterleavedFromReader:
+			case t.IDLimitedSwizzleU32InterleavedFromReader,
+				t.IDSwizzleInterleavedFromReader,
+				t.IDSwizzleInterleavedRowsFromReader:
 				b.writes("wuffs_base__pixel_swizzler__")
-				if method.Ident() == t.IDLimitedSwizzleU32InterleavedFromReader {
-					b.writes("limited_swizzle_u32_interleaved_from_reader")
-				} else {
-					b.writes("swizzle_interleaved_from_reader")
-				}
+				b.writes(method.Ident().Str(g.tm))
 				b.writes("(\n&")
 				if err := g.writeExpr(b, recv, false, depth); err != nil {
 					return err
@@ -557,6 +564,8 @@ func (g *gen) writeBuiltinCPUArchARMNeon(b *buffer, recv *a.Expr, method t.ID, a
 				before, ptr = "vld1_u8(", true
 			case "make_u8x16_slice128":
 				before, ptr = "vld1q_u8(", true
+			case "make_u16x8_slice_u16lex8":
+				before, ptr = "vld1q_u16(", true
 			default:
 				return fmt.Errorf("internal error: unsupported cpu_arch method %q", methodStr)
 			}
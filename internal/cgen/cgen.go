@@ -131,6 +131,7 @@ func Do(args []string) error {
 				"// ¡ INSERT base/floatconv-submodule.c.\n":        insertBaseFloatConvSubmoduleC,
 				"// ¡ INSERT base/intconv-submodule.c.\n":          insertBaseIntConvSubmoduleC,
 				"// ¡ INSERT base/magic-submodule.c.\n":            insertBaseMagicSubmoduleC,
+				"// ¡ INSERT base/pixconv-submodule-arm-neon.c.\n": insertBasePixConvSubmoduleARMNeonC,
 				"// ¡ INSERT base/pixconv-submodule-regular.c.\n":  insertBasePixConvSubmoduleRegularC,
 				"// ¡ INSERT base/pixconv-submodule-x86-avx2.c.\n": insertBasePixConvSubmoduleX86Avx2C,
 				"// ¡ INSERT base/pixconv-submodule-ycck.c.\n":     insertBasePixConvSubmoduleYcckC,
@@ -391,6 +392,11 @@ func insertBaseMagicSubmoduleC(buf *buffer) error {
 	return nil
 }
 
+func insertBasePixConvSubmoduleARMNeonC(buf *buffer) error {
+	buf.writes(embedBasePixConvSubmoduleARMNeonC.Trim())
+	return nil
+}
+
 func insertBasePixConvSubmoduleRegularC(buf *buffer) error {
 	buf.writes(embedBasePixConvSubmoduleRegularC.Trim())
 	return nil
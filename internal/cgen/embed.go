@@ -93,6 +93,9 @@ var embedBaseIntConvSubmoduleC EmbeddedString
 //go:embed base/magic-submodule.c
 var embedBaseMagicSubmoduleC EmbeddedString
 
+//go:embed base/pixconv-submodule-arm-neon.c
+var embedBasePixConvSubmoduleARMNeonC EmbeddedString
+
 //go:embed base/pixconv-submodule-regular.c
 var embedBasePixConvSubmoduleRegularC EmbeddedString
 
@@ -119,6 +122,12 @@ var embedAuxCborCc EmbeddedString
 //go:embed auxiliary/cbor.hh
 var embedAuxCborHh EmbeddedString
 
+//go:embed auxiliary/deflate.cc
+var embedAuxDeflateCc EmbeddedString
+
+//go:embed auxiliary/deflate.hh
+var embedAuxDeflateHh EmbeddedString
+
 //go:embed auxiliary/image.cc
 var embedAuxImageCc EmbeddedString
 
@@ -133,12 +142,14 @@ var embedAuxJsonHh EmbeddedString
 
 var EmbeddedStrings_AuxNonBaseCcFiles = []EmbeddedString{
 	embedAuxCborCc,
+	embedAuxDeflateCc,
 	embedAuxImageCc,
 	embedAuxJsonCc,
 }
 
 var EmbeddedStrings_AuxNonBaseHhFiles = []EmbeddedString{
 	embedAuxCborHh,
+	embedAuxDeflateHh,
 	embedAuxImageHh,
 	embedAuxJsonHh,
 }
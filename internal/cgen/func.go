@@ -201,7 +201,7 @@ func (g *gen) writeFuncSignature(b *buffer, n *a.Func, wfs uint32) error {
 }
 
 func (g *gen) writeFuncPrototype(b *buffer, n *a.Func) error {
-	caMacro, _, _, err := cpuArchCNames(n.Asserts())
+	caMacro, _, _, err := g.cpuArchCNames(n)
 	if err != nil {
 		return err
 	}
@@ -228,7 +228,7 @@ func (g *gen) writeFuncPrototype(b *buffer, n *a.Func) error {
 func (g *gen) writeFuncImpl(b *buffer, n *a.Func) error {
 	k := g.funks[n.QQID()]
 
-	caMacro, caName, caAttribute, err := cpuArchCNames(n.Asserts())
+	caMacro, caName, caAttribute, err := g.cpuArchCNames(n)
 	if err != nil {
 		return err
 	}
@@ -630,7 +630,7 @@ func (g *gen) writeFuncImplArgChecks(b *buffer, n *a.Func) error {
 	}
 	b.writes(") {\n")
 	b.writes("self->private_impl.magic = WUFFS_BASE__DISABLED;\n")
-	if g.currFunk.astFunc.Effect().Coroutine() {
+	if g.currFunk.astFunc.Effect().Coroutine() || g.currFunk.returnsStatus {
 		b.writes("return wuffs_base__make_status(wuffs_base__error__bad_argument);\n")
 	} else {
 		// TODO: don't assume that the return type is empty.
@@ -243,7 +243,7 @@ func (g *gen) writeStatementChoose(b *buffer, n *a.Choose, depth uint32) error {
 		if n.Name() == id {
 			suffix = "__choosy_default"
 		}
-		caMacro, caName, _, err := cpuArchCNames(g.findAstFunc(t.QQID{recv[0], recv[1], id}).Asserts())
+		caMacro, caName, _, err := g.cpuArchCNames(g.findAstFunc(t.QQID{recv[0], recv[1], id}))
 		if err != nil {
 			return err
 		}
@@ -265,9 +265,9 @@ func (g *gen) writeStatementChoose(b *buffer, n *a.Choose, depth uint32) error {
 	return nil
 }
 
-func cpuArchCNames(asserts []*a.Node) (caMacro string, caName string, caAttribute string, retErr error) {
+func (g *gen) cpuArchCNames(n *a.Func) (caMacro string, caName string, caAttribute string, retErr error) {
 	match := false
-	for _, o := range asserts {
+	for _, o := range n.Asserts() {
 		if o := o.AsAssert(); o.IsChooseCPUArch() {
 			if match {
 				// TODO: support multiple choose-cpu_arch preconditions?
@@ -280,6 +280,9 @@ func cpuArchCNames(asserts []*a.Node) (caMacro string, caName string, caAttribut
 				caMacro, caName, caAttribute = "ARM_CRC32", "arm_crc32", ""
 			case t.IDARMNeon:
 				caMacro, caName, caAttribute = "ARM_NEON", "arm_neon", ""
+				if g.usesARMNeonA64Only(n) {
+					caMacro = "ARM_NEON_A64"
+				}
 			case t.IDX86SSE42:
 				caMacro, caName, caAttribute =
 					"X86_64_V2",
@@ -301,6 +304,54 @@ func cpuArchCNames(asserts []*a.Node) (caMacro string, caName string, caAttribut
 	return caMacro, caName, caAttribute, nil
 }
 
+// usesARMNeonA64Only returns whether n calls any arm_neon built-in method
+// that AArch64's <arm_neon.h> has but 32-bit ARM's does not, such as
+// vtrn1q_u32 or vaddvq_u8.
+func (g *gen) usesARMNeonA64Only(n *a.Func) bool {
+	found := false
+	for _, o := range n.Body() {
+		o.Walk(func(o *a.Node) error {
+			if o.Kind() != a.KExpr {
+				return nil
+			}
+			e := o.AsExpr()
+			if e.Operator() != a.ExprOperatorCall {
+				return nil
+			}
+			method := e.LHS().AsExpr()
+			if method.LHS() == nil {
+				return nil
+			}
+			recvTyp := method.LHS().AsExpr().MType()
+			if (recvTyp == nil) || !recvTyp.QID()[1].IsBuiltInCPUArchARMNeon() {
+				return nil
+			}
+			if isARMNeonA64Only(method.Ident().Str(g.tm)) {
+				found = true
+			}
+			return nil
+		})
+	}
+	return found
+}
+
+func isARMNeonA64Only(methodStr string) bool {
+	if strings.Contains(methodStr, "_high_") && !strings.HasPrefix(methodStr, "vget_high_") {
+		return true
+	}
+	for _, prefix := range armNeonA64OnlyPrefixes {
+		if strings.HasPrefix(methodStr, prefix) {
+			return true
+		}
+	}
+	return false
+}
+
+var armNeonA64OnlyPrefixes = [...]string{
+	"vaddlv", "vaddv", "vceqz", "vcopy", "vmaxv", "vminv", "vpaddq", "vqtbl",
+	"vqtbx", "vrbit", "vtrn1", "vtrn2", "vuzp1", "vuzp2", "vzip1", "vzip2",
+}
+
 func (g *gen) writeStatementIOManip(b *buffer, n *a.IOManip, depth uint32) error {
 	if g.currFunk.ioManips > maxIOManips {
 		return fmt.Errorf("too many temporary variables required")
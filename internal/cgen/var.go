@@ -57,7 +57,8 @@ func (g *gen) needDerivedVar(name t.ID) bool {
 				// TODO: use a comprehensive list of such methods.
 				switch meth {
 				case t.IDLimitedSwizzleU32InterleavedFromReader,
-					t.IDSwizzleInterleavedFromReader:
+					t.IDSwizzleInterleavedFromReader,
+					t.IDSwizzleInterleavedRowsFromReader:
 					if recv.MType().Eq(typeExprPixelSwizzler) && argsContainsArgsDotFoo(args, name) {
 						return errNeedDerivedVar
 					}
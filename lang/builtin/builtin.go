@@ -433,6 +433,13 @@ var funcsOther = [...]string{
 	"range_ii_u64.intersect(r: range_ii_u64) range_ii_u64",
 	"range_ii_u64.unite(r: range_ii_u64) range_ii_u64",
 
+	// ---- rects
+
+	"rect_ie_u32.get_min_incl_x() u32",
+	"rect_ie_u32.get_min_incl_y() u32",
+	"rect_ie_u32.get_max_excl_x() u32",
+	"rect_ie_u32.get_max_excl_y() u32",
+
 	// ---- more_information
 
 	"more_information.set!(flavor: u32, w: u32, x: u64, y: u64, z: u64)",
@@ -658,6 +665,11 @@ var funcsOther = [...]string{
 
 	"token_writer.length() u64",
 
+	// ---- decode_frame_options
+
+	"decode_frame_options.region_of_interest() rect_ie_u32",
+	"decode_frame_options.scale_denominator() u32",
+
 	// ---- frame_config
 
 	"frame_config.blend() u8",
@@ -686,6 +698,7 @@ var funcsOther = [...]string{
 
 	"pixel_format.bits_per_pixel() u32[..= 256]",
 	"pixel_format.default_background_color() u32",
+	"pixel_format.is_planar() bool",
 
 	// ---- pixel_swizzler
 
@@ -699,6 +712,10 @@ var funcsOther = [...]string{
 		"dst: slice u8, dst_palette: slice u8, src: io_reader) u64",
 	"pixel_swizzler.swizzle_interleaved_from_slice!(" +
 		"dst: slice u8, dst_palette: slice u8, src: roslice u8) u64",
+	"pixel_swizzler.swizzle_interleaved_rows_from_reader!(" +
+		"dst: table u8, dst_palette: slice u8, src: io_reader) u64",
+	"pixel_swizzler.swizzle_interleaved_rows_from_slice!(" +
+		"dst: table u8, dst_palette: slice u8, src: roslice u8) u64",
 	"pixel_swizzler.swizzle_interleaved_transparent_black!(" +
 		"dst: slice u8, dst_palette: slice u8, num_pixels: u64) u64",
 	"pixel_swizzler.swizzle_ycck!(" +
@@ -708,6 +725,7 @@ var funcsOther = [...]string{
 		"x_max_excl: u32[..= 0xFFFF]," +
 		"y_min_incl: u32[..= 0xFFFF]," +
 		"y_max_excl: u32[..= 0xFFFF]," +
+		"src_y_min_incl: u32[..= 0xFFFF]," +
 		"src0: slice u8," +
 		"src1: slice u8," +
 		"src2: slice u8," +
@@ -785,6 +803,7 @@ var funcsOther = [...]string{
 
 	"arm_neon_utility.make_u8x8_slice64(a: roslice base.u8) arm_neon_u8x8",
 	"arm_neon_utility.make_u8x16_slice128(a: roslice base.u8) arm_neon_u8x16",
+	"arm_neon_utility.make_u16x8_slice_u16lex8(a: roslice base.u16) arm_neon_u16x8",
 
 	// ---- arm_neon_uAxB.as_uCxD
 
@@ -849,6 +868,7 @@ var funcsOther = [...]string{
 	"x86_m128i._mm_add_epi32(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_add_epi64(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_add_epi8(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_adds_epu16(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_and_si128(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_avg_epu16(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_avg_epu8(b: x86_m128i) x86_m128i",
@@ -877,6 +897,7 @@ var funcsOther = [...]string{
 	"x86_m128i._mm_min_epu16(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_min_epu32(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_min_epu8(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_mulhi_epu16(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_mullo_epi32(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_or_si128(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_packs_epi16(b: x86_m128i) x86_m128i",
@@ -888,6 +909,7 @@ var funcsOther = [...]string{
 	"x86_m128i._mm_slli_epi32(imm8: u32) x86_m128i",
 	"x86_m128i._mm_slli_epi64(imm8: u32) x86_m128i",
 	"x86_m128i._mm_slli_si128(imm8: u32) x86_m128i",
+	"x86_m128i._mm_srai_epi16(imm8: u32) x86_m128i",
 	"x86_m128i._mm_srli_epi16(imm8: u32) x86_m128i",
 	"x86_m128i._mm_srli_epi32(imm8: u32) x86_m128i",
 	"x86_m128i._mm_srli_epi64(imm8: u32) x86_m128i",
@@ -896,6 +918,7 @@ var funcsOther = [...]string{
 	"x86_m128i._mm_sub_epi32(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_sub_epi64(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_sub_epi8(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_subs_epu16(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_unpackhi_epi16(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_unpackhi_epi32(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_unpackhi_epi64(b: x86_m128i) x86_m128i",
@@ -705,6 +705,7 @@ const (
 
 	IDLimitedSwizzleU32InterleavedFromReader = ID(0x280)
 	IDSwizzleInterleavedFromReader           = ID(0x281)
+	IDSwizzleInterleavedRowsFromReader       = ID(0x282)
 
 	// -------- 0x300 block.
 
@@ -1154,6 +1155,7 @@ var builtInsByID = [nBuiltInIDs]string{
 
 	IDLimitedSwizzleU32InterleavedFromReader: "limited_swizzle_u32_interleaved_from_reader",
 	IDSwizzleInterleavedFromReader:           "swizzle_interleaved_from_reader",
+	IDSwizzleInterleavedRowsFromReader:       "swizzle_interleaved_rows_from_reader",
 
 	// -------- 0x300 block.
 
@@ -0,0 +1,798 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// https://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or https://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+// ----------------
+
+/*
+This test program is typically run indirectly, by the build-all.sh script. It
+tests wuffs_aux (C++) code, such as BuildDeflateIndex, DecodeDeflateRange and
+DecodeDeflateParallel, checking their output against decoding the whole stream
+in one pass, on one thread.
+
+To manually run this test:
+
+for CXX in clang++ g++; do
+  $CXX -std=c++11 -Wall -Werror -pthread deflate.cc && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+*/
+
+#define WUFFS_IMPLEMENTATION
+
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+#include "../testlib/auxtestlib.cc"
+
+// ---------------- Helpers
+
+std::string  //
+Crc32(const std::string& s) {
+  wuffs_crc32__ieee_hasher h;
+  wuffs_base__status status =
+      h.initialize(sizeof h, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+  if (status.repr) {
+    return "";
+  }
+  uint32_t x = h.update_u32(wuffs_base__make_slice_u8(
+      reinterpret_cast<uint8_t*>(const_cast<char*>(s.data())), s.size()));
+  uint8_t buf[4];
+  wuffs_base__poke_u32le__no_bounds_check(&buf[0], x);
+  return std::string(reinterpret_cast<const char*>(&buf[0]), 4);
+}
+
+// WrapAsGzip wraps raw DEFLATE data, which decodes to decoded, in a minimal
+// gzip member.
+std::string  //
+WrapAsGzip(const std::string& raw, const std::string& decoded) {
+  static const char header[10] = {'\x1F', '\x8B', '\x08', 0, 0, 0, 0, 0, 0,
+                                  '\xFF'};
+  uint8_t buf[4];
+  wuffs_base__poke_u32le__no_bounds_check(
+      &buf[0], static_cast<uint32_t>(decoded.size()));
+  return std::string(&header[0], 10) + raw + Crc32(decoded) +
+         std::string(reinterpret_cast<const char*>(&buf[0]), 4);
+}
+
+// ReadTestStreams sets srcs to several gzip and zlib encodings of want: a
+// single gzip member with many small DEFLATE blocks, a zlib stream and a
+// multi-member gzip stream.
+std::string  //
+ReadTestStreams(std::vector<std::string>& srcs, std::string& want) {
+  std::string status = read_file(want, "test/data/pi.txt");
+  if (!status.empty()) {
+    return status;
+  }
+  std::string raw;
+  status = read_file(raw, "test/data/pi.txt.small-blocks.deflate");
+  if (!status.empty()) {
+    return status;
+  }
+  std::string gz;
+  status = read_file(gz, "test/data/pi.txt.gz");
+  if (!status.empty()) {
+    return status;
+  }
+  std::string zlib;
+  status = read_file(zlib, "test/data/pi.txt.zlib");
+  if (!status.empty()) {
+    return status;
+  }
+  srcs.clear();
+  srcs.push_back(WrapAsGzip(raw, want));
+  srcs.push_back(zlib);
+  srcs.push_back(WrapAsGzip(raw, want) + gz);
+  return "";
+}
+
+// DoTestDecodeDeflateRanges checks DecodeDeflateRange, for a variety of
+// ranges, against the wanted decoding of the whole stream.
+std::string  //
+DoTestDecodeDeflateRanges(const wuffs_aux::DeflateIndex& index,
+                          const std::string& src,
+                          const std::string& want) {
+  const uint64_t n = want.size();
+  const uint64_t ranges[][2] = {
+      {0, 1},          //
+      {0, 10000},      //
+      {5000, 30000},   //
+      {12345, 0},      //
+      {n / 3, n / 3},  //
+      {n / 2, 1},      //
+      {n - 10, 10},    //
+      {n - 10, 1000},  //
+      {n, 10},         //
+      {n + 10, 10},    //
+      {0, n},          //
+  };
+  for (const auto& r : ranges) {
+    uint64_t pos = r[0];
+    uint64_t length = r[1];
+    const wuffs_aux::DeflateCheckpoint* checkpoint = index.Find(pos);
+    if (!checkpoint) {
+      return "Find(" + std::to_string(pos) + "): no checkpoint";
+    } else if (checkpoint->decompressed_pos > pos) {
+      return "Find(" + std::to_string(pos) + "): checkpoint is too late";
+    }
+    wuffs_aux::sync_io::MemoryInput input(
+        src.data() + checkpoint->compressed_pos,
+        src.size() - static_cast<size_t>(checkpoint->compressed_pos));
+    std::string have;
+    std::string error_message = wuffs_aux::DecodeDeflateRange(
+        have, index, *checkpoint, input, pos, length);
+    if (!error_message.empty()) {
+      return "DecodeDeflateRange(" + std::to_string(pos) + ", " +
+             std::to_string(length) + "): " + error_message;
+    }
+    std::string w = (pos < want.size())
+                        ? want.substr(static_cast<size_t>(pos),
+                                      static_cast<size_t>(length))
+                        : std::string();
+    if (have != w) {
+      return "DecodeDeflateRange(" + std::to_string(pos) + ", " +
+             std::to_string(length) + "): output differs";
+    }
+  }
+  return "";
+}
+
+// Encode compresses src as a gzip (if fourcc is WUFFS_BASE__FOURCC__GZ) or
+// zlib stream.
+std::string  //
+Encode(std::string& dst, const std::string& src, uint32_t fourcc) {
+  wuffs_base__io_transformer::unique_ptr enc(nullptr);
+  if (fourcc == WUFFS_BASE__FOURCC__GZ) {
+    enc = wuffs_gzip__encoder::alloc_as__wuffs_base__io_transformer();
+  } else {
+    enc = wuffs_zlib__encoder::alloc_as__wuffs_base__io_transformer();
+  }
+  if (!enc) {
+    return "Encode: out of memory";
+  }
+  // Favor speed, as the test streams are large.
+  wuffs_base__status status =
+      enc->set_quirk(WUFFS_BASE__QUIRK_QUALITY,
+                     WUFFS_BASE__QUIRK_QUALITY__VALUE__LOWER_QUALITY);
+  if (status.repr) {
+    return status.message();
+  }
+  std::vector<uint8_t> workbuf(
+      static_cast<size_t>(enc->workbuf_len().max_incl));
+  uint8_t buf[65536];
+  wuffs_base__io_buffer src_buf = wuffs_base__ptr_u8__reader(
+      reinterpret_cast<uint8_t*>(const_cast<char*>(src.data())), src.size(),
+      true);
+  dst.clear();
+  while (true) {
+    wuffs_base__io_buffer dst_buf =
+        wuffs_base__ptr_u8__writer(&buf[0], sizeof(buf));
+    status = enc->transform_io(
+        &dst_buf, &src_buf,
+        wuffs_base__make_slice_u8(workbuf.data(), workbuf.size()));
+    dst.append(reinterpret_cast<const char*>(&buf[0]), dst_buf.meta.wi);
+    if (status.repr != wuffs_base__suspension__short_write) {
+      return status.message() ? status.message() : "";
+    }
+  }
+}
+
+// MakeLargeTestStreams sets srcs and wants to compressed streams (and their
+// decodings) that are long enough for DecodeDeflateParallel to split into
+// several chunks: gzip and zlib encodings of text (which have dynamic
+// Huffman blocks) and a gzip encoding of random bytes (which has stored
+// blocks).
+std::string  //
+MakeLargeTestStreams(std::vector<std::string>& srcs,
+                     std::vector<std::string>& wants) {
+  static std::vector<std::string> s_srcs;
+  static std::vector<std::string> s_wants;
+  if (s_srcs.empty()) {
+    uint32_t rng = 1;
+    std::vector<std::string> words;
+    for (int i = 0; i < 4000; i++) {
+      std::string w;
+      for (uint32_t n = 2 + (i % 8); n > 0; n--) {
+        rng = (rng * 1103515245u) + 12345u;
+        w.push_back(static_cast<char>('a' + ((rng >> 16) % 12)));
+      }
+      words.push_back(w);
+    }
+    std::string text;
+    while (text.size() < 0x1000000) {
+      rng = (rng * 1103515245u) + 12345u;
+      text += words[(rng >> 8) % words.size()];
+      text.push_back((rng & 0x1F) ? ' ' : '\n');
+    }
+    std::string random;
+    while (random.size() < 0x900000) {
+      rng = (rng * 1103515245u) + 12345u;
+      random.push_back(static_cast<char>(rng >> 24));
+    }
+
+    std::string gz_text;
+    std::string zlib_text;
+    std::string gz_random;
+    std::string status = Encode(gz_text, text, WUFFS_BASE__FOURCC__GZ);
+    if (status.empty()) {
+      status = Encode(zlib_text, text, WUFFS_BASE__FOURCC__ZLIB);
+    }
+    if (status.empty()) {
+      status = Encode(gz_random, random, WUFFS_BASE__FOURCC__GZ);
+    }
+    if (!status.empty()) {
+      return status;
+    }
+    s_srcs = {gz_text, zlib_text, gz_random};
+    s_wants = {text, text, random};
+  }
+  srcs = s_srcs;
+  wants = s_wants;
+  return "";
+}
+
+// DecodeParallel calls DecodeDeflateParallel, appending the output to dst.
+std::string  //
+DecodeParallel(std::string& dst,
+               const std::string& src,
+               wuffs_aux::Executor* executor) {
+  dst.clear();
+  return wuffs_aux::DecodeDeflateParallel(
+      reinterpret_cast<const uint8_t*>(src.data()), src.size(),
+      [&](const uint8_t* ptr, size_t len) -> std::string {
+        dst.append(reinterpret_cast<const char*>(ptr), len);
+        return "";
+      },
+      executor);
+}
+
+// DoTestDecodeDeflateParallel checks that DecodeDeflateParallel, with no
+// executor and with various executors, decodes src to want.
+std::string  //
+DoTestDecodeDeflateParallel(const std::string& src, const std::string& want) {
+  std::string have;
+  std::string status = DecodeParallel(have, src, nullptr);
+  if (!status.empty()) {
+    return "no executor: " + status;
+  } else if (have != want) {
+    return "no executor: output differs";
+  }
+  for (size_t n : {1, 2, 4}) {
+    ThreadExecutor thread_executor(n);
+    ReverseExecutor reverse_executor(n);
+    for (int e = 0; e < 2; e++) {
+      wuffs_aux::Executor* executor = &thread_executor;
+      if (e != 0) {
+        executor = &reverse_executor;
+      }
+      status = DecodeParallel(have, src, executor);
+      if (!status.empty()) {
+        return "n=" + std::to_string(n) + ", e=" + std::to_string(e) + ": " +
+               status;
+      } else if (have != want) {
+        return "n=" + std::to_string(n) + ", e=" + std::to_string(e) +
+               ": output differs";
+      }
+    }
+  }
+  return "";
+}
+
+// ---------------- DeflateIndex Tests
+
+std::string  //
+test_wuffs_aux_deflate_index_build_and_decode_range() {
+  std::vector<std::string> srcs;
+  std::string want;
+  std::string status = ReadTestStreams(srcs, want);
+  if (!status.empty()) {
+    return status;
+  }
+  for (size_t i = 0; i < srcs.size(); i++) {
+    std::string w = (i == 2) ? (want + want) : want;
+    wuffs_aux::sync_io::MemoryInput input(srcs[i].data(), srcs[i].size());
+    wuffs_aux::BuildDeflateIndexResult result =
+        wuffs_aux::BuildDeflateIndex(input, 8192);
+    if (!result.error_message.empty()) {
+      return "i=" + std::to_string(i) + ": " + result.error_message;
+    } else if (result.index.checkpoints.empty() ||
+               (result.index.checkpoints[0].decompressed_pos != 0)) {
+      return "i=" + std::to_string(i) + ": no checkpoint at the start";
+    } else if ((i != 1) && (result.index.checkpoints.size() < 4)) {
+      // The small-blocks stream has block boundaries every few KiB.
+      return "i=" + std::to_string(i) + ": too few checkpoints";
+    }
+    status = DoTestDecodeDeflateRanges(result.index, srcs[i], w);
+    if (!status.empty()) {
+      return "i=" + std::to_string(i) + ": " + status;
+    }
+  }
+  return "";
+}
+
+std::string  //
+test_wuffs_aux_deflate_index_build_errors() {
+  std::vector<std::string> srcs;
+  std::string want;
+  std::string status = ReadTestStreams(srcs, want);
+  if (!status.empty()) {
+    return status;
+  }
+
+  // Flip a bit in the gzip member's CRC-32 and, separately, the zlib
+  // stream's Adler-32, then truncate the gzip stream, then garble its magic.
+  std::string bad_crc = srcs[0];
+  bad_crc[bad_crc.size() - 6] ^= 0x01;
+  std::string bad_adler = srcs[1];
+  bad_adler[bad_adler.size() - 1] ^= 0x01;
+  std::string truncated = srcs[0].substr(0, srcs[0].size() - 3);
+  std::string garbled = srcs[0];
+  garbled[0] = 'X';
+
+  struct {
+    const std::string* src;
+    const char* want;
+  } tests[] = {
+      {&bad_crc, wuffs_aux::DeflateIndex_BadChecksum},
+      {&bad_adler, wuffs_aux::DeflateIndex_BadChecksum},
+      {&truncated, wuffs_aux::DeflateIndex_UnexpectedEndOfFile},
+      {&garbled, wuffs_aux::DeflateIndex_UnsupportedCompressionFormat},
+  };
+  for (const auto& t : tests) {
+    wuffs_aux::sync_io::MemoryInput input(t.src->data(), t.src->size());
+    wuffs_aux::BuildDeflateIndexResult result =
+        wuffs_aux::BuildDeflateIndex(input, 8192);
+    if (result.error_message != t.want) {
+      return "have \"" + result.error_message + "\", want \"" + t.want + "\"";
+    }
+  }
+  return "";
+}
+
+std::string  //
+test_wuffs_aux_deflate_index_serialize_and_parse() {
+  std::vector<std::string> srcs;
+  std::string want;
+  std::string status = ReadTestStreams(srcs, want);
+  if (!status.empty()) {
+    return status;
+  }
+  wuffs_aux::sync_io::MemoryInput input(srcs[0].data(), srcs[0].size());
+  wuffs_aux::BuildDeflateIndexResult result =
+      wuffs_aux::BuildDeflateIndex(input, 8192);
+  if (!result.error_message.empty()) {
+    return result.error_message;
+  }
+  std::string serialized;
+  result.index.Serialize(serialized);
+
+  wuffs_aux::DeflateIndex parsed;
+  std::string error_message = parsed.Parse(
+      reinterpret_cast<const uint8_t*>(serialized.data()), serialized.size());
+  if (!error_message.empty()) {
+    return "Parse: " + error_message;
+  }
+  std::string reserialized;
+  parsed.Serialize(reserialized);
+  if (reserialized != serialized) {
+    return "Serialize(Parse(x)) != x";
+  }
+  return DoTestDecodeDeflateRanges(parsed, srcs[0], want);
+}
+
+std::string  //
+test_wuffs_aux_deflate_index_parse_corrupt_index() {
+  std::vector<std::string> srcs;
+  std::string want;
+  std::string status = ReadTestStreams(srcs, want);
+  if (!status.empty()) {
+    return status;
+  }
+  wuffs_aux::sync_io::MemoryInput input(srcs[0].data(), srcs[0].size());
+  wuffs_aux::BuildDeflateIndexResult result =
+      wuffs_aux::BuildDeflateIndex(input, 8192);
+  if (!result.error_message.empty()) {
+    return result.error_message;
+  } else if (result.index.checkpoints.size() < 2) {
+    return "too few checkpoints";
+  }
+  std::string good;
+  result.index.Serialize(good);
+
+  std::vector<std::string> bads;
+  // Every strict prefix, and a trailing byte.
+  for (size_t n = 0; n < good.size(); n += (n < 64) ? 1 : 997) {
+    bads.push_back(good.substr(0, n));
+  }
+  bads.push_back(good + '\x00');
+  // A bad magic, version or fourcc.
+  for (size_t offset : {0, 8, 12}) {
+    bads.push_back(good);
+    bads.back()[offset] ^= 0x01;
+  }
+  // A checkpoint count that's too large.
+  bads.push_back(good);
+  bads.back()[16] = static_cast<char>(bads.back()[16] + 1);
+  // The first checkpoint's bits field is invalid (a count of 8 bits).
+  bads.push_back(good);
+  bads.back()[24 + 16 + 1] = 0x08;
+  // The second checkpoint's compressed_pos goes backwards.
+  {
+    wuffs_aux::DeflateIndex index = result.index;
+    index.checkpoints[1].compressed_pos = 0;
+    bads.push_back("");
+    index.Serialize(bads.back());
+  }
+
+  for (size_t i = 0; i < bads.size(); i++) {
+    wuffs_aux::DeflateIndex index = result.index;
+    std::string error_message = index.Parse(
+        reinterpret_cast<const uint8_t*>(bads[i].data()), bads[i].size());
+    if (error_message != wuffs_aux::DeflateIndex_BadIndex) {
+      return "i=" + std::to_string(i) + ": have \"" + error_message +
+             "\", want \"" + wuffs_aux::DeflateIndex_BadIndex + "\"";
+    } else if ((index.fourcc != 0) || !index.checkpoints.empty()) {
+      return "i=" + std::to_string(i) + ": index was not cleared";
+    }
+  }
+  return "";
+}
+
+// ---------------- DecodeDeflateParallel Tests
+
+std::string  //
+test_wuffs_aux_decode_deflate_parallel_small() {
+  std::vector<std::string> srcs;
+  std::string want;
+  std::string status = ReadTestStreams(srcs, want);
+  if (!status.empty()) {
+    return status;
+  }
+  for (size_t i = 0; i < srcs.size(); i++) {
+    status =
+        DoTestDecodeDeflateParallel(srcs[i], (i == 2) ? (want + want) : want);
+    if (!status.empty()) {
+      return "i=" + std::to_string(i) + ": " + status;
+    }
+  }
+  return "";
+}
+
+std::string  //
+test_wuffs_aux_decode_deflate_parallel_large() {
+  std::vector<std::string> srcs;
+  std::vector<std::string> wants;
+  std::string status = MakeLargeTestStreams(srcs, wants);
+  if (!status.empty()) {
+    return status;
+  }
+  for (size_t i = 0; i < srcs.size(); i++) {
+    status = DoTestDecodeDeflateParallel(srcs[i], wants[i]);
+    if (!status.empty()) {
+      return "i=" + std::to_string(i) + ": " + status;
+    }
+  }
+  return "";
+}
+
+std::string  //
+test_wuffs_aux_decode_deflate_parallel_speculation() {
+  std::vector<std::string> srcs;
+  std::vector<std::string> wants;
+  std::string status = MakeLargeTestStreams(srcs, wants);
+  if (!status.empty()) {
+    return status;
+  }
+  if (srcs[0].size() < 0x500000) {
+    return "the compressed text is too short to split into chunks";
+  }
+
+  // Each round has a RunAll call to decode its chunks and then another to
+  // resolve the confirmed ones. Two consecutive RunAll calls with more than
+  // one task means that a speculative chunk was confirmed.
+  ReverseExecutor executor(4);
+  std::string have;
+  status = DecodeParallel(have, srcs[0], &executor);
+  if (!status.empty()) {
+    return status;
+  } else if (have != wants[0]) {
+    return "output differs";
+  }
+  const std::vector<size_t>& sizes = executor.run_all_sizes;
+  for (size_t i = 1; i < sizes.size(); i++) {
+    if ((sizes[i - 1] > 1) && (sizes[i] > 1)) {
+      return "";
+    }
+  }
+  return "no speculative chunk was confirmed";
+}
+
+std::string  //
+test_wuffs_aux_decode_deflate_parallel_high_ratio() {
+  std::vector<std::string> srcs;
+  std::vector<std::string> wants;
+  std::string status = MakeLargeTestStreams(srcs, wants);
+  if (!status.empty()) {
+    return status;
+  }
+
+  // 128 MiB of zeros compresses to far less than one chunk, so each chunk
+  // must end early instead of buffering all of its decoded output. The text
+  // after the zeros can be split into speculative chunks.
+  std::string want(0x8000000, '\x00');
+  want += wants[0];
+  std::string src;
+  status = Encode(src, want, WUFFS_BASE__FOURCC__GZ);
+  if (!status.empty()) {
+    return status;
+  }
+  status = DoTestDecodeDeflateParallel(src, want);
+  if (!status.empty()) {
+    return status;
+  }
+
+  // Each write_func call passes one chunk's buffered output.
+  static constexpr size_t max_chunk_decoded_length = 0x2400000;
+  ThreadExecutor executor(4);
+  size_t have_max_len = 0;
+  status = wuffs_aux::DecodeDeflateParallel(
+      reinterpret_cast<const uint8_t*>(src.data()), src.size(),
+      [&](const uint8_t* ptr, size_t len) -> std::string {
+        (void)ptr;
+        have_max_len = std::max(have_max_len, len);
+        return "";
+      },
+      &executor);
+  if (!status.empty()) {
+    return status;
+  } else if (have_max_len > max_chunk_decoded_length) {
+    return "write_func: have " + std::to_string(have_max_len) +
+           " bytes, want at most " + std::to_string(max_chunk_decoded_length);
+  }
+  return "";
+}
+
+std::string  //
+test_wuffs_aux_decode_deflate_parallel_errors() {
+  std::vector<std::string> srcs;
+  std::vector<std::string> wants;
+  std::string status = MakeLargeTestStreams(srcs, wants);
+  if (!status.empty()) {
+    return status;
+  }
+  const std::string& gz = srcs[0];
+  const std::string& zlib = srcs[1];
+
+  std::string bad_crc = gz;
+  bad_crc[bad_crc.size() - 6] ^= 0x01;
+  std::string bad_adler = zlib;
+  bad_adler[bad_adler.size() - 1] ^= 0x01;
+  std::string bad_header = gz;
+  bad_header[3] = '\xFF';
+  std::string truncated_footer = gz.substr(0, gz.size() - 3);
+  std::string truncated_middle = gz.substr(0, (gz.size() * 3) / 5);
+  std::string garbled = gz;
+  garbled[0] = 'X';
+
+  struct {
+    const std::string* src;
+    const char* want;
+  } tests[] = {
+      {&bad_crc, wuffs_aux::DecodeDeflateParallel_BadChecksum},
+      {&bad_adler, wuffs_aux::DecodeDeflateParallel_BadChecksum},
+      {&bad_header, wuffs_aux::DecodeDeflateParallel_BadHeader},
+      {&truncated_footer, wuffs_aux::DecodeDeflateParallel_UnexpectedEndOfFile},
+      {&truncated_middle, wuffs_aux::DecodeDeflateParallel_UnexpectedEndOfFile},
+      {&garbled, wuffs_aux::DecodeDeflateParallel_UnsupportedCompressionFormat},
+  };
+  for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+    ThreadExecutor thread_executor(4);
+    ReverseExecutor reverse_executor(4);
+    wuffs_aux::Executor* executors[3] = {
+        nullptr,
+        &thread_executor,
+        &reverse_executor,
+    };
+    for (int e = 0; e < 3; e++) {
+      std::string have;
+      status = DecodeParallel(have, *tests[i].src, executors[e]);
+      if (status != tests[i].want) {
+        return "i=" + std::to_string(i) + ", e=" + std::to_string(e) +
+               ": have \"" + status + "\", want \"" + tests[i].want + "\"";
+      }
+    }
+  }
+
+  // A flipped bit in the middle of the DEFLATE data must give an error (but
+  // which one depends on the bit), the same as without an executor.
+  std::string corrupted = gz;
+  corrupted[gz.size() / 2] ^= 0x10;
+  std::string have;
+  std::string want_status = DecodeParallel(have, corrupted, nullptr);
+  if (want_status.empty()) {
+    return "corrupted: have no error, want one";
+  }
+  ThreadExecutor executor(4);
+  status = DecodeParallel(have, corrupted, &executor);
+  if (status != want_status) {
+    return "corrupted: have \"" + status + "\", want \"" + want_status +
+           "\"";
+  }
+
+  // An error from the write_func stops the decoding.
+  int num_writes = 0;
+  status = wuffs_aux::DecodeDeflateParallel(
+      reinterpret_cast<const uint8_t*>(gz.data()), gz.size(),
+      [&](const uint8_t* ptr, size_t len) -> std::string {
+        (void)ptr;
+        (void)len;
+        num_writes++;
+        return "write_func error";
+      },
+      &executor);
+  if (status != "write_func error") {
+    return "write_func: have \"" + status + "\"";
+  } else if (num_writes != 1) {
+    return "write_func: have " + std::to_string(num_writes) +
+           " calls, want 1";
+  }
+  return "";
+}
+
+std::string  //
+test_wuffs_aux_decode_deflate_parallel_bgzf() {
+  std::vector<std::string> srcs;
+  std::string want;
+  std::string status = ReadTestStreams(srcs, want);
+  if (!status.empty()) {
+    return status;
+  }
+  std::string bgzf;
+  status = read_file(bgzf, "test/data/pi.txt.bgzf");
+  if (!status.empty()) {
+    return status;
+  }
+
+  // BGZF members are decoded in batches, and other gzip members by the
+  // speculative decoder, so also mix the two.
+  struct {
+    std::string src;
+    std::string want;
+  } tests[] = {
+      {bgzf, want},
+      {bgzf + bgzf + bgzf, want + want + want},
+      {bgzf + srcs[0], want + want},
+      {srcs[0] + bgzf, want + want},
+      {bgzf + srcs[0] + bgzf, want + want + want},
+  };
+  for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+    status = DoTestDecodeDeflateParallel(tests[i].src, tests[i].want);
+    if (!status.empty()) {
+      return "i=" + std::to_string(i) + ": " + status;
+    }
+  }
+
+  // The BGZF stream has 8 members, decoded as 4 concurrent tasks.
+  ReverseExecutor executor(4);
+  std::string have;
+  status = DecodeParallel(have, bgzf, &executor);
+  if (!status.empty()) {
+    return status;
+  } else if ((executor.run_all_sizes.size() != 1) ||
+             (executor.run_all_sizes[0] != 4)) {
+    return "the BGZF members were not decoded concurrently";
+  }
+  return "";
+}
+
+std::string  //
+test_wuffs_aux_decode_deflate_parallel_bgzf_errors() {
+  std::string bgzf;
+  std::string status = read_file(bgzf, "test/data/pi.txt.bgzf");
+  if (!status.empty()) {
+    return status;
+  }
+
+  // Find the BGZF members' offsets. Each member's BSIZE field, at offset 16,
+  // is the member length minus 1.
+  std::vector<size_t> offsets;
+  for (size_t i = 0; (i + 18) <= bgzf.size();) {
+    offsets.push_back(i);
+    i += 1 + wuffs_base__peek_u16le__no_bounds_check(
+                 reinterpret_cast<const uint8_t*>(bgzf.data() + i + 16));
+  }
+  if (offsets.size() < 4) {
+    return "too few BGZF members";
+  }
+
+  // Corrupt the second member's CRC-32, its data or the third member's
+  // ISIZE. Separately, truncate the stream in the third member.
+  std::string bad_crc = bgzf;
+  bad_crc[offsets[2] - 8] ^= 0x01;
+  std::string bad_data = bgzf;
+  bad_data[(offsets[1] + offsets[2]) / 2] ^= 0x10;
+  std::string bad_isize = bgzf;
+  bad_isize[offsets[3] - 4] ^= 0x01;
+  std::string truncated = bgzf.substr(0, (offsets[2] + offsets[3]) / 2);
+
+  const std::string gzip_bad_checksum =
+      wuffs_base__make_status(wuffs_gzip__error__bad_checksum).message();
+  struct {
+    const std::string* src;
+    const char* want;
+  } tests[] = {
+      {&bad_crc, gzip_bad_checksum.c_str()},
+      {&bad_data, nullptr},
+      {&bad_isize, gzip_bad_checksum.c_str()},
+      {&truncated, wuffs_aux::DecodeDeflateParallel_UnexpectedEndOfFile},
+  };
+  for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+    std::string have;
+    std::string want_status = DecodeParallel(have, *tests[i].src, nullptr);
+    if (want_status.empty()) {
+      return "i=" + std::to_string(i) + ": have no error, want one";
+    } else if (tests[i].want && (want_status != tests[i].want)) {
+      return "i=" + std::to_string(i) + ": have \"" + want_status +
+             "\", want \"" + tests[i].want + "\"";
+    }
+    for (size_t n : {2, 4, 8}) {
+      ThreadExecutor thread_executor(n);
+      ReverseExecutor reverse_executor(n);
+      for (int e = 0; e < 2; e++) {
+        wuffs_aux::Executor* executor = &thread_executor;
+        if (e != 0) {
+          executor = &reverse_executor;
+        }
+        status = DecodeParallel(have, *tests[i].src, executor);
+        if (status != want_status) {
+          return "i=" + std::to_string(i) + ", n=" + std::to_string(n) +
+                 ", e=" + std::to_string(e) + ": have \"" + status +
+                 "\", want \"" + want_status + "\"";
+        }
+      }
+    }
+  }
+  return "";
+}
+
+// ----------------
+
+static const AuxTest g_tests[] = {
+    {"test_wuffs_aux_deflate_index_build_and_decode_range",
+     test_wuffs_aux_deflate_index_build_and_decode_range},
+    {"test_wuffs_aux_deflate_index_build_errors",
+     test_wuffs_aux_deflate_index_build_errors},
+    {"test_wuffs_aux_deflate_index_serialize_and_parse",
+     test_wuffs_aux_deflate_index_serialize_and_parse},
+    {"test_wuffs_aux_deflate_index_parse_corrupt_index",
+     test_wuffs_aux_deflate_index_parse_corrupt_index},
+    {"test_wuffs_aux_decode_deflate_parallel_small",
+     test_wuffs_aux_decode_deflate_parallel_small},
+    {"test_wuffs_aux_decode_deflate_parallel_large",
+     test_wuffs_aux_decode_deflate_parallel_large},
+    {"test_wuffs_aux_decode_deflate_parallel_speculation",
+     test_wuffs_aux_decode_deflate_parallel_speculation},
+    {"test_wuffs_aux_decode_deflate_parallel_high_ratio",
+     test_wuffs_aux_decode_deflate_parallel_high_ratio},
+    {"test_wuffs_aux_decode_deflate_parallel_errors",
+     test_wuffs_aux_decode_deflate_parallel_errors},
+    {"test_wuffs_aux_decode_deflate_parallel_bgzf",
+     test_wuffs_aux_decode_deflate_parallel_bgzf},
+    {"test_wuffs_aux_decode_deflate_parallel_bgzf_errors",
+     test_wuffs_aux_decode_deflate_parallel_bgzf_errors},
+};
+
+int  //
+main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  return aux_test_main("aux/deflate", g_tests,
+                       sizeof(g_tests) / sizeof(g_tests[0]));
+}
@@ -0,0 +1,465 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// https://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or https://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+// ----------------
+
+/*
+This test program is typically run indirectly, by the build-all.sh script. It
+tests wuffs_aux (C++) code, such as DecodeImage and ConvertPixelBuffer with an
+Executor, checking that using multiple workers gives the same pixels as not
+using any executor.
+
+To manually run this test:
+
+for CXX in clang++ g++; do
+  $CXX -std=c++11 -Wall -Werror -pthread image.cc && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+*/
+
+#define WUFFS_IMPLEMENTATION
+
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+#include "../testlib/auxtestlib.cc"
+
+// ---------------- Helpers
+
+// DecodePixels decodes the image file held in src, using the executor if it
+// is non-nullptr, setting dst to the (tightly packed) premultiplied BGRA
+// pixels. DecodeImage ignores PNG checksums by default, unless
+// verify_checksums is true.
+std::string  //
+DecodePixels(std::string& dst,
+             const std::string& src,
+             wuffs_aux::Executor* executor,
+             bool verify_checksums = false,
+             wuffs_aux::DecodeImageCallbacks* callbacks = nullptr) {
+  wuffs_aux::QuirkKeyValuePair quirks[1] = {
+      {WUFFS_BASE__QUIRK_IGNORE_CHECKSUM, 0},
+  };
+  wuffs_aux::DecodeImageCallbacks default_callbacks;
+  wuffs_aux::sync_io::MemoryInput input(src.data(), src.size());
+  wuffs_aux::DecodeImageResult result = wuffs_aux::DecodeImage(
+      callbacks ? *callbacks : default_callbacks, input,
+      verify_checksums ? wuffs_aux::DecodeImageArgQuirks(&quirks[0], 1)
+                       : wuffs_aux::DecodeImageArgQuirks::DefaultValue(),
+      wuffs_aux::DecodeImageArgFlags::DefaultValue(),
+      wuffs_aux::DecodeImageArgPixelBlend::DefaultValue(),
+      wuffs_aux::DecodeImageArgBackgroundColor::DefaultValue(),
+      wuffs_aux::DecodeImageArgMaxInclDimension::DefaultValue(),
+      wuffs_aux::DecodeImageArgMaxInclMetadataLength::DefaultValue(),
+      wuffs_aux::DecodeImageArgExecutor(executor));
+  if (!result.error_message.empty()) {
+    return result.error_message;
+  }
+  wuffs_base__table_u8 tab = result.pixbuf.plane(0);
+  dst.clear();
+  for (size_t y = 0; y < tab.height; y++) {
+    dst.append(reinterpret_cast<const char*>(tab.ptr + (y * tab.stride)),
+               tab.width);
+  }
+  return "";
+}
+
+// g_foreign_png_func_ptrs is a copy of Wuffs' PNG decoder's vtable. A
+// wuffs_png__decoder that uses it instead stands in for a third party image
+// decoder: it decodes PNGs and accepts Wuffs' PNG quirks but DecodeImage
+// cannot assume that it has wuffs_png__decoder's other methods.
+static const wuffs_base__image_decoder__func_ptrs g_foreign_png_func_ptrs =
+    wuffs_png__decoder__func_ptrs_for__wuffs_base__image_decoder;
+
+// SelectDecoderCallbacks counts its SelectDecoder calls. For PNG images, the
+// calls numbered from first_foreign onwards (counting from 1) return a foreign
+// (see g_foreign_png_func_ptrs) decoder instead of Wuffs' PNG decoder.
+class SelectDecoderCallbacks : public wuffs_aux::DecodeImageCallbacks {
+ public:
+  explicit SelectDecoderCallbacks(size_t first_foreign0)
+      : num_select_decoder_calls(0), m_first_foreign(first_foreign0) {}
+
+  wuffs_base__image_decoder::unique_ptr  //
+  SelectDecoder(uint32_t fourcc,
+                wuffs_base__slice_u8 prefix_data,
+                bool prefix_closed) override {
+    num_select_decoder_calls++;
+    wuffs_base__image_decoder::unique_ptr dec =
+        wuffs_aux::DecodeImageCallbacks::SelectDecoder(fourcc, prefix_data,
+                                                       prefix_closed);
+    if (dec && (fourcc == WUFFS_BASE__FOURCC__PNG) &&
+        (num_select_decoder_calls >= m_first_foreign)) {
+      dec->private_impl.first_vtable.function_pointers =
+          &g_foreign_png_func_ptrs;
+    }
+    return dec;
+  }
+
+  size_t num_select_decoder_calls;
+
+ private:
+  size_t m_first_foreign;
+};
+
+// DoTestDecodeImageExecutor checks that decoding with executors (of various
+// sizes) gives the same pixels as decoding without one. If want_run_all is
+// true then it also checks that the executors were used.
+std::string  //
+DoTestDecodeImageExecutor(const char* path, bool want_run_all) {
+  std::string src;
+  std::string status = read_file(src, path);
+  if (!status.empty()) {
+    return status;
+  }
+  std::string want;
+  status = DecodePixels(want, src, nullptr);
+  if (!status.empty()) {
+    return status;
+  }
+
+  static const size_t num_workers[] = {1, 2, 3, 8, 9, 100};
+  for (size_t n : num_workers) {
+    for (int e = 0; e < 2; e++) {
+      ThreadExecutor thread_executor(n);
+      ReverseExecutor reverse_executor(n);
+      wuffs_aux::Executor* executor = &thread_executor;
+      if (e != 0) {
+        executor = &reverse_executor;
+      }
+      std::string have;
+      status = DecodePixels(have, src, executor);
+      if (!status.empty()) {
+        return "n=" + std::to_string(n) + ", e=" + std::to_string(e) + ": " +
+               status;
+      } else if (have != want) {
+        return "n=" + std::to_string(n) + ", e=" + std::to_string(e) +
+               ": pixels differ from the single-threaded decode";
+      }
+      size_t num_run_all_calls = (e == 0) ? thread_executor.num_run_all_calls
+                                          : reverse_executor.num_run_all_calls;
+      if (want_run_all && (n > 1) && (num_run_all_calls == 0)) {
+        return "n=" + std::to_string(n) + ", e=" + std::to_string(e) +
+               ": the executor was not used";
+      }
+    }
+  }
+  return "";
+}
+
+// ---------------- Executor Tests
+
+std::string  //
+test_wuffs_aux_executor_default() {
+  wuffs_aux::Executor executor;
+  if (executor.NumWorkers() != 1) {
+    return "NumWorkers: have " + std::to_string(executor.NumWorkers()) +
+           ", want 1";
+  }
+  std::vector<size_t> order;
+  executor.RunAll(5, [&](size_t i) { order.push_back(i); });
+  if (order != std::vector<size_t>({0, 1, 2, 3, 4})) {
+    return "RunAll: tasks did not run exactly once, in order";
+  }
+  return "";
+}
+
+// ---------------- DecodeImage Tests
+
+std::string  //
+test_wuffs_aux_decode_image_jpeg_bands() {
+  // This image has 8 MCU rows and restart markers, so it can be decoded in
+  // bands. The executors have up to 100 workers, more than there are bands.
+  return DoTestDecodeImageExecutor(
+      "test/data/artificial-jpeg/bricks-color-restart-interval.jpeg", true);
+}
+
+std::string  //
+test_wuffs_aux_decode_image_jpeg_no_bands() {
+  // This image has no restart markers, so it is decoded sequentially.
+  return DoTestDecodeImageExecutor("test/data/bricks-color.jpeg", false);
+}
+
+std::string  //
+test_wuffs_aux_decode_image_png_pipelined() {
+  // This image is big enough to be decoded as a two-stage pipeline.
+  return DoTestDecodeImageExecutor("test/data/harvesters.png", true);
+}
+
+std::string  //
+test_wuffs_aux_decode_image_png_not_pipelined() {
+  // These images are too small or interlaced, so they are decoded without the
+  // pipeline.
+  std::string status =
+      DoTestDecodeImageExecutor("test/data/hibiscus.regular.png", false);
+  if (!status.empty()) {
+    return status;
+  }
+  return DoTestDecodeImageExecutor("test/data/hippopotamus.interlaced.png",
+                                   false);
+}
+
+std::string  //
+test_wuffs_aux_decode_image_png_pipelined_errors() {
+  std::string src;
+  std::string status = read_file(src, "test/data/harvesters.png");
+  if (!status.empty()) {
+    return status;
+  }
+
+  // Truncate the image (part way through its IDAT chunks) and, separately,
+  // flip a bit in its compressed pixel data, which breaks the checksums.
+  std::string truncated = src.substr(0, src.size() / 2);
+  std::string corrupted = src;
+  corrupted[src.size() / 2] ^= 0x01;
+
+  for (const std::string* s : {&truncated, &corrupted}) {
+    std::string want;
+    std::string want_status = DecodePixels(want, *s, nullptr, true);
+    if (want_status.empty()) {
+      return "single-threaded decode: have no error, want one";
+    }
+    ThreadExecutor executor(4);
+    std::string have;
+    std::string have_status = DecodePixels(have, *s, &executor, true);
+    if (have_status != want_status) {
+      return "have \"" + have_status + "\", want \"" + want_status + "\"";
+    } else if (executor.num_run_all_calls == 0) {
+      return "the executor was not used";
+    }
+  }
+  return "";
+}
+
+std::string  //
+test_wuffs_aux_decode_image_png_pipelined_select_decoder() {
+  std::string src;
+  std::string status = read_file(src, "test/data/harvesters.png");
+  if (!status.empty()) {
+    return status;
+  }
+  std::string want;
+  status = DecodePixels(want, src, nullptr);
+  if (!status.empty()) {
+    return status;
+  }
+
+  // The pipeline's two stage decoders come from callbacks.SelectDecoder. The
+  // pipeline is only used if all three decoders are Wuffs' PNG decoder.
+  // Otherwise, the image decoder that SelectDecoder first returned decodes the
+  // whole frame on its own.
+  static const struct {
+    size_t first_foreign;
+    bool want_pipelined;
+  } test_cases[] = {
+      {SIZE_MAX, true},
+      {1, false},
+      {2, false},
+      {3, false},
+  };
+  for (const auto& tc : test_cases) {
+    SelectDecoderCallbacks callbacks(tc.first_foreign);
+    ThreadExecutor executor(4);
+    std::string have;
+    status = DecodePixels(have, src, &executor, false, &callbacks);
+    std::string prefix =
+        "first_foreign=" + std::to_string(tc.first_foreign) + ": ";
+    if (!status.empty()) {
+      return prefix + status;
+    } else if (have != want) {
+      return prefix + "pixels differ from the single-threaded decode";
+    } else if ((executor.num_run_all_calls > 0) != tc.want_pipelined) {
+      return prefix + "num_run_all_calls: have " +
+             std::to_string(executor.num_run_all_calls);
+    } else if ((tc.first_foreign > 1) &&
+               (callbacks.num_select_decoder_calls != 3)) {
+      return prefix + "num_select_decoder_calls: have " +
+             std::to_string(callbacks.num_select_decoder_calls) + ", want 3";
+    }
+  }
+  return "";
+}
+
+// ---------------- ConvertPixelBuffer Tests
+
+// DoConvertPixelBuffer converts src to a newly allocated pixel buffer with
+// the given pixel format and dimensions, initially filled with fill, setting
+// dst to its (tightly packed) pixels.
+std::string  //
+DoConvertPixelBuffer(std::string& dst,
+                     wuffs_base__pixel_buffer& src,
+                     uint32_t dst_pixfmt_repr,
+                     uint32_t width,
+                     uint32_t height,
+                     uint8_t fill,
+                     wuffs_base__pixel_blend pixel_blend,
+                     wuffs_aux::Executor* executor) {
+  wuffs_base__pixel_config pixcfg;
+  pixcfg.set(dst_pixfmt_repr, WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width,
+             height);
+  std::vector<uint8_t> storage(static_cast<size_t>(pixcfg.pixbuf_len()),
+                               fill);
+  wuffs_base__pixel_buffer pixbuf;
+  wuffs_base__status status = pixbuf.set_from_slice(
+      &pixcfg, wuffs_base__make_slice_u8(storage.data(), storage.size()));
+  if (status.repr) {
+    return status.message();
+  }
+  std::string error_message =
+      wuffs_aux::ConvertPixelBuffer(pixbuf, src, pixel_blend, executor);
+  dst.assign(reinterpret_cast<const char*>(storage.data()), storage.size());
+  return error_message;
+}
+
+std::string  //
+test_wuffs_aux_convert_pixel_buffer() {
+  std::string src_bytes;
+  std::string status = read_file(src_bytes, "test/data/harvesters.png");
+  if (!status.empty()) {
+    return status;
+  }
+  wuffs_aux::DecodeImageCallbacks callbacks;
+  wuffs_aux::sync_io::MemoryInput input(src_bytes.data(), src_bytes.size());
+  wuffs_aux::DecodeImageResult decoded =
+      wuffs_aux::DecodeImage(callbacks, input);
+  if (!decoded.error_message.empty()) {
+    return decoded.error_message;
+  }
+  uint32_t width = decoded.pixbuf.pixcfg.width();
+  uint32_t height = decoded.pixbuf.pixcfg.height();
+
+  // The image is big enough to be split into several bands. Also convert to
+  // dst pixel buffers that are narrower or shorter than the src, or both.
+  static const uint32_t dst_pixfmt_reprs[] = {
+      WUFFS_BASE__PIXEL_FORMAT__BGR,
+      WUFFS_BASE__PIXEL_FORMAT__BGR_565,
+      WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+  };
+  static const wuffs_base__pixel_blend pixel_blends[] = {
+      WUFFS_BASE__PIXEL_BLEND__SRC,
+      WUFFS_BASE__PIXEL_BLEND__SRC_OVER,
+  };
+  const uint32_t dimensions[][2] = {
+      {width, height},
+      {width / 3, height},
+      {width, height - 1},
+      {width + 7, height + 5},
+  };
+  for (uint32_t dst_pixfmt_repr : dst_pixfmt_reprs) {
+    for (wuffs_base__pixel_blend pixel_blend : pixel_blends) {
+      for (const auto& wh : dimensions) {
+        std::string want;
+        status = DoConvertPixelBuffer(want, decoded.pixbuf, dst_pixfmt_repr,
+                                      wh[0], wh[1], 0x55, pixel_blend,
+                                      nullptr);
+        if (!status.empty()) {
+          return status;
+        }
+        for (size_t n : {2, 5, 64}) {
+          ThreadExecutor thread_executor(n);
+          ReverseExecutor reverse_executor(n);
+          for (int e = 0; e < 2; e++) {
+            wuffs_aux::Executor* executor = &thread_executor;
+            if (e != 0) {
+              executor = &reverse_executor;
+            }
+            std::string have;
+            status = DoConvertPixelBuffer(have, decoded.pixbuf,
+                                          dst_pixfmt_repr, wh[0], wh[1], 0x55,
+                                          pixel_blend, executor);
+            if (!status.empty()) {
+              return status;
+            } else if (have != want) {
+              return "pixfmt=" + std::to_string(dst_pixfmt_repr) +
+                     ", blend=" + std::to_string(pixel_blend) +
+                     ", width=" + std::to_string(wh[0]) +
+                     ", n=" + std::to_string(n) + ", e=" + std::to_string(e) +
+                     ": pixels differ from the single-threaded conversion";
+            }
+          }
+          if (thread_executor.num_run_all_calls == 0) {
+            return "n=" + std::to_string(n) + ": the executor was not used";
+          }
+        }
+      }
+    }
+  }
+  return "";
+}
+
+std::string  //
+test_wuffs_aux_convert_pixel_buffer_errors() {
+  wuffs_base__pixel_config pixcfg;
+  pixcfg.set(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+             WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, 1024, 1024);
+  std::vector<uint8_t> storage(static_cast<size_t>(pixcfg.pixbuf_len()));
+  wuffs_base__pixel_buffer src;
+  wuffs_base__status status = src.set_from_slice(
+      &pixcfg, wuffs_base__make_slice_u8(storage.data(), storage.size()));
+  if (status.repr) {
+    return status.message();
+  }
+
+  // The pixel swizzler can't convert to a palette-based pixel format.
+  ThreadExecutor executor(4);
+  std::string have;
+  std::string error_message = DoConvertPixelBuffer(
+      have, src, WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL, 1024, 1024,
+      0, WUFFS_BASE__PIXEL_BLEND__SRC, &executor);
+  std::string want = wuffs_base__make_status(
+                         wuffs_base__error__unsupported_pixel_swizzler_option)
+                         .message();
+  if (error_message != want) {
+    return "have \"" + error_message + "\", want \"" + want + "\"";
+  }
+
+  // Planar pixel formats aren't supported. set_from_slice rejects them too,
+  // so re-label the pixel buffer's pixel format directly.
+  wuffs_base__pixel_buffer dst = src;
+  dst.pixcfg.set(WUFFS_BASE__PIXEL_FORMAT__YCBCR,
+                 WUFFS_BASE__PIXEL_SUBSAMPLING__444, 1024, 1024);
+  error_message = wuffs_aux::ConvertPixelBuffer(
+      dst, src, WUFFS_BASE__PIXEL_BLEND__SRC, &executor);
+  if (error_message != wuffs_aux::ConvertPixelBuffer_UnsupportedPixelFormat) {
+    return "have \"" + error_message + "\", want \"" +
+           wuffs_aux::ConvertPixelBuffer_UnsupportedPixelFormat + "\"";
+  } else if (executor.num_run_all_calls != 0) {
+    return "the executor was used";
+  }
+  return "";
+}
+
+// ----------------
+
+static const AuxTest g_tests[] = {
+    {"test_wuffs_aux_executor_default", test_wuffs_aux_executor_default},
+    {"test_wuffs_aux_decode_image_jpeg_bands",
+     test_wuffs_aux_decode_image_jpeg_bands},
+    {"test_wuffs_aux_decode_image_jpeg_no_bands",
+     test_wuffs_aux_decode_image_jpeg_no_bands},
+    {"test_wuffs_aux_decode_image_png_pipelined",
+     test_wuffs_aux_decode_image_png_pipelined},
+    {"test_wuffs_aux_decode_image_png_not_pipelined",
+     test_wuffs_aux_decode_image_png_not_pipelined},
+    {"test_wuffs_aux_decode_image_png_pipelined_errors",
+     test_wuffs_aux_decode_image_png_pipelined_errors},
+    {"test_wuffs_aux_decode_image_png_pipelined_select_decoder",
+     test_wuffs_aux_decode_image_png_pipelined_select_decoder},
+    {"test_wuffs_aux_convert_pixel_buffer",
+     test_wuffs_aux_convert_pixel_buffer},
+    {"test_wuffs_aux_convert_pixel_buffer_errors",
+     test_wuffs_aux_convert_pixel_buffer_errors},
+};
+
+int  //
+main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  return aux_test_main("aux/image", g_tests,
+                       sizeof(g_tests) / sizeof(g_tests[0]));
+}
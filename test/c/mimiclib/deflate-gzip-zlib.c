@@ -166,6 +166,53 @@ mimic_zlib_decode_with_dictionary(wuffs_base__io_buffer* dst,
   return "libdeflate does not implement zlib dictionaries";
 }
 
+const char*  //
+mimic_deflate_encode(wuffs_base__io_buffer* dst,
+                     wuffs_base__io_buffer* src,
+                     int compression_level) {
+  struct libdeflate_compressor* enc =
+      libdeflate_alloc_compressor(compression_level);
+  if (!enc) {
+    return "libdeflate: alloc failed";
+  }
+  size_t n_dst = libdeflate_deflate_compress(
+      enc, wuffs_base__io_buffer__reader_pointer(src),
+      wuffs_base__io_buffer__reader_length(src),
+      wuffs_base__io_buffer__writer_pointer(dst),
+      wuffs_base__io_buffer__writer_length(dst));
+  libdeflate_free_compressor(enc);
+  if (n_dst == 0) {
+    return "libdeflate: insufficient space";
+  }
+  dst->meta.wi += n_dst;
+  src->meta.ri = src->meta.wi;
+  return NULL;
+}
+
+const char*  //
+mimic_deflate_encode_fast(wuffs_base__io_buffer* dst,
+                          wuffs_base__io_buffer* src,
+                          uint32_t wuffs_initialize_flags,
+                          uint64_t wlimit,
+                          uint64_t rlimit) {
+  if ((wlimit < UINT64_MAX) || (rlimit < UINT64_MAX)) {
+    return "unsupported I/O limit";
+  }
+  return mimic_deflate_encode(dst, src, 1);
+}
+
+const char*  //
+mimic_deflate_encode_default(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  if ((wlimit < UINT64_MAX) || (rlimit < UINT64_MAX)) {
+    return "unsupported I/O limit";
+  }
+  return mimic_deflate_encode(dst, src, 6);
+}
+
 // -------------------------------- WUFFS_MIMICLIB_USE_XXX_INSTEAD_OF_ZLIB
 #elif defined(WUFFS_MIMICLIB_USE_MINIZ_INSTEAD_OF_ZLIB)
 #include "/path/to/your/copy/of/github.com/richgel999/miniz/miniz_tinfl.c"
@@ -256,6 +303,24 @@ mimic_zlib_decode_with_dictionary(wuffs_base__io_buffer* dst,
   return "miniz does not implement zlib dictionaries";
 }
 
+const char*  //
+mimic_deflate_encode_fast(wuffs_base__io_buffer* dst,
+                          wuffs_base__io_buffer* src,
+                          uint32_t wuffs_initialize_flags,
+                          uint64_t wlimit,
+                          uint64_t rlimit) {
+  return "miniz_tinfl does not implement deflate encoding";
+}
+
+const char*  //
+mimic_deflate_encode_default(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return "miniz_tinfl does not implement deflate encoding";
+}
+
 // -------------------------------- WUFFS_MIMICLIB_USE_XXX_INSTEAD_OF_ZLIB
 #else
 #include "zlib.h"
@@ -461,5 +526,100 @@ mimic_zlib_decode_with_dictionary(wuffs_base__io_buffer* dst,
                                         UINT64_MAX, zlib_flavor_zlib);
 }
 
+const char*  //
+mimic_deflate_encode(wuffs_base__io_buffer* dst,
+                     wuffs_base__io_buffer* src,
+                     uint64_t wlimit,
+                     uint64_t rlimit,
+                     int compression_level) {
+  const char* ret = NULL;
+  if (dst->data.len > UINT_MAX) {
+    ret = "dst length is too large";
+    goto cleanup0;
+  }
+  if (src->data.len > UINT_MAX) {
+    ret = "src length is too large";
+    goto cleanup0;
+  }
+
+  // A negative window_bits means raw DEFLATE, without a gzip or zlib wrapper.
+  z_stream z = {0};
+  int di2_err = deflateInit2(&z, compression_level, Z_DEFLATED, -15, 8,
+                             Z_DEFAULT_STRATEGY);
+  if (di2_err != Z_OK) {
+    ret = "deflateInit2 failed";
+    goto cleanup0;
+  }
+
+  while (true) {
+    z.next_in = src->data.ptr + src->meta.ri;
+    z.avail_in = src->meta.wi - src->meta.ri;
+    int flush = Z_FINISH;
+    if (z.avail_in > rlimit) {
+      z.avail_in = rlimit;
+      flush = Z_NO_FLUSH;
+    }
+    uInt initial_avail_in = z.avail_in;
+
+    z.next_out = dst->data.ptr + dst->meta.wi;
+    z.avail_out = dst->data.len - dst->meta.wi;
+    if (z.avail_out > wlimit) {
+      z.avail_out = wlimit;
+    }
+    uInt initial_avail_out = z.avail_out;
+
+    int d_err = deflate(&z, flush);
+
+    if (initial_avail_in < z.avail_in) {
+      ret = "inconsistent avail_in";
+      goto cleanup1;
+    }
+    src->meta.ri += initial_avail_in - z.avail_in;
+
+    if (initial_avail_out < z.avail_out) {
+      ret = "inconsistent avail_out";
+      goto cleanup1;
+    }
+    dst->meta.wi += initial_avail_out - z.avail_out;
+
+    if (d_err == Z_STREAM_END) {
+      break;
+    } else if ((d_err != Z_OK) && (d_err != Z_BUF_ERROR)) {
+      ret = "deflate failed";
+      goto cleanup1;
+    } else if (dst->meta.wi == dst->data.len) {
+      ret = "deflate failed (dst is full)";
+      goto cleanup1;
+    }
+  }
+
+cleanup1:;
+  int de_err = deflateEnd(&z);
+  if ((de_err != Z_OK) && !ret) {
+    ret = "deflateEnd failed";
+  }
+
+cleanup0:;
+  return ret;
+}
+
+const char*  //
+mimic_deflate_encode_fast(wuffs_base__io_buffer* dst,
+                          wuffs_base__io_buffer* src,
+                          uint32_t wuffs_initialize_flags,
+                          uint64_t wlimit,
+                          uint64_t rlimit) {
+  return mimic_deflate_encode(dst, src, wlimit, rlimit, 1);
+}
+
+const char*  //
+mimic_deflate_encode_default(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return mimic_deflate_encode(dst, src, wlimit, rlimit, 6);
+}
+
 #endif
 // -------------------------------- WUFFS_MIMICLIB_USE_XXX_INSTEAD_OF_ZLIB
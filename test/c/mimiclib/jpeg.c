@@ -59,6 +59,24 @@ mimic_jpeg_decode(uint64_t* n_bytes_out,
     goto cleanup0;
   }
 
+  // Like Wuffs' QUIRK_DECODE_COEFFICIENTS, jpeg_read_coefficients stops after
+  // entropy decoding. Count the same n_bytes as for a full decode.
+  for (size_t i = 0; i < quirks_len; i++) {
+    if (quirks_ptr[i] == WUFFS_JPEG__QUIRK_DECODE_COEFFICIENTS) {
+      if (!jpeg_read_coefficients(&cinfo)) {
+        ret = "mimic_jpeg_decode: jpeg_read_coefficients failed";
+        goto cleanup0;
+      }
+      if (n_bytes_out) {
+        *n_bytes_out +=
+            ((uint64_t)cinfo.image_width) * ((uint64_t)cinfo.image_height) *
+            ((uint64_t)(wuffs_base__pixel_format__bits_per_pixel(&pixfmt) / 8));
+      }
+      jpeg_finish_decompress(&cinfo);
+      goto cleanup0;
+    }
+  }
+
   switch (pixfmt.repr) {
     case WUFFS_BASE__PIXEL_FORMAT__Y:
       cinfo.out_color_space = JCS_GRAYSCALE;
@@ -97,6 +97,52 @@ test_wuffs_bmp_decode_interface() {
       "test/data/hippopotamus.bmp", 0, SIZE_MAX, 36, 28, 0xFFF5F5F5);
 }
 
+const char*  //
+test_wuffs_bmp_decode_region_of_interest() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[4] = {
+      "test/data/bricks-color.bmp",        //
+      "test/data/bricks-dither.bmp",       //
+      "test/data/hibiscus.primitive.bmp",  //
+      "test/data/pjw-thumbnail.bmp",
+  };
+
+  const wuffs_base__rect_ie_u32 rois[5] = {
+      {0, 0, 1, 1},       //
+      {17, 9, 61, 50},    //
+      {0, 30, 1000, 40},  //
+      {3, 100, 4, 1000},  //
+      {5000, 5000, 5001, 5001},
+  };
+
+  for (int f = 0; f < 4; f++) {
+    for (int r = 0; r < 5; r++) {
+      wuffs_bmp__decoder want_dec;
+      CHECK_STATUS("initialize",
+                   wuffs_bmp__decoder__initialize(
+                       &want_dec, sizeof want_dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      wuffs_bmp__decoder have_dec;
+      CHECK_STATUS("initialize",
+                   wuffs_bmp__decoder__initialize(
+                       &have_dec, sizeof have_dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      const char* status =
+          do_test__wuffs_base__image_decoder_region_of_interest(
+              wuffs_bmp__decoder__upcast_as__wuffs_base__image_decoder(
+                  &want_dec),
+              wuffs_bmp__decoder__upcast_as__wuffs_base__image_decoder(
+                  &have_dec),
+              filenames[f], rois[r]);
+      if (status) {
+        RETURN_FAIL("f=%d, r=%d: %s", f, r, status);
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_bmp_decode_truncated_input() {
   CHECK_FOCUS(__func__);
@@ -237,6 +283,7 @@ proc g_tests[] = {
     test_wuffs_bmp_decode_frame_config,
     test_wuffs_bmp_decode_interface,
     test_wuffs_bmp_decode_io_redirect,
+    test_wuffs_bmp_decode_region_of_interest,
     test_wuffs_bmp_decode_truncated_input,
 
 #ifdef WUFFS_MIMIC
@@ -121,6 +121,10 @@ golden_test g_deflate_deflate_huffman_primlen_9_gt = {
         "huffman-primlen-9.deflate",
 };
 
+golden_test g_deflate_encode_pi_gt = {
+    .src_filename = "test/data/pi.txt",
+};
+
 golden_test g_deflate_midsummer_gt = {
     .want_filename = "test/data/midsummer.txt",
     .src_filename = "test/data/midsummer.txt.gz",
@@ -135,6 +139,11 @@ golden_test g_deflate_pi_gt = {
     .src_offset1 = 48335,
 };
 
+golden_test g_deflate_pi_small_blocks_gt = {
+    .want_filename = "test/data/pi.txt",
+    .src_filename = "test/data/pi.txt.small-blocks.deflate",
+};
+
 golden_test g_deflate_romeo_gt = {
     .want_filename = "test/data/romeo.txt",
     .src_filename = "test/data/romeo.txt.gz",
@@ -420,6 +429,114 @@ test_wuffs_deflate_decode_split_src() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_deflate_decode_checkpoints() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+
+  golden_test* gt = &g_deflate_pi_small_blocks_gt;
+  CHECK_STRING(read_file(&src, gt->src_filename));
+  CHECK_STRING(read_file(&want, gt->want_filename));
+
+  // Decode with a "$block boundary" suspension roughly every 12 KiB of
+  // output, recording a checkpoint at each one. The histories are stored in
+  // the work buffer, which the deflate decoder doesn't otherwise need.
+  const size_t max_checkpoints = 8;
+  struct {
+    size_t src_pos;
+    size_t dst_pos;
+    uint32_t bits;
+    uint8_t* history_ptr;
+    size_t history_len;
+  } checkpoints[8];
+  size_t num_checkpoints = 0;
+
+  wuffs_deflate__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  CHECK_STATUS("set_quirk",
+               wuffs_deflate__decoder__set_quirk(
+                   &dec, WUFFS_DEFLATE__QUIRK_YIELD_AT_BLOCK_BOUNDARIES,
+                   0x3000));
+  while (true) {
+    wuffs_base__status status = wuffs_deflate__decoder__transform_io(
+        &dec, &have, &src, g_work_slice_u8);
+    if (!status.repr) {
+      break;
+    } else if (status.repr != wuffs_deflate__suspension__block_boundary) {
+      RETURN_FAIL("transform_io: have \"%s\", want \"%s\"", status.repr,
+                  wuffs_deflate__suspension__block_boundary);
+    } else if (num_checkpoints >= max_checkpoints) {
+      continue;
+    }
+    uint8_t* history_ptr = g_work_array_u8 + (0x8000 * num_checkpoints);
+    checkpoints[num_checkpoints].src_pos = src.meta.ri;
+    checkpoints[num_checkpoints].dst_pos = have.meta.wi;
+    checkpoints[num_checkpoints].bits =
+        wuffs_deflate__decoder__checkpoint_bits(&dec);
+    checkpoints[num_checkpoints].history_ptr = history_ptr;
+    checkpoints[num_checkpoints].history_len =
+        wuffs_deflate__decoder__checkpoint_history(
+            &dec, wuffs_base__make_slice_u8(history_ptr, 0x8000));
+    num_checkpoints++;
+  }
+  CHECK_STRING(check_io_buffers_equal("", &have, &want));
+  if (num_checkpoints != max_checkpoints) {
+    RETURN_FAIL("num_checkpoints: have %zu, want %zu", num_checkpoints,
+                max_checkpoints);
+  }
+
+  // Resume decoding, with a fresh decoder, from each checkpoint.
+  for (size_t c = 0; c < num_checkpoints; c++) {
+    size_t dst_pos = checkpoints[c].dst_pos;
+    size_t history_len = checkpoints[c].history_len;
+    size_t want_history_len = (dst_pos < 0x8000) ? dst_pos : 0x8000;
+    if (history_len != want_history_len) {
+      RETURN_FAIL("c=%zu: history_len: have %zu, want %zu", c, history_len,
+                  want_history_len);
+    } else if (memcmp(checkpoints[c].history_ptr,
+                      g_want_array_u8 + dst_pos - history_len, history_len)) {
+      RETURN_FAIL("c=%zu: history: have and want bytes differ", c);
+    }
+
+    CHECK_STATUS("initialize",
+                 wuffs_deflate__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STATUS("set_checkpoint_bits",
+                 wuffs_deflate__decoder__set_checkpoint_bits(
+                     &dec, checkpoints[c].bits));
+    wuffs_deflate__decoder__add_history(
+        &dec,
+        wuffs_base__make_slice_u8(checkpoints[c].history_ptr, history_len));
+
+    have.meta.ri = 0;
+    have.meta.wi = 0;
+    src.meta.ri = checkpoints[c].src_pos;
+    CHECK_STATUS("transform_io", wuffs_deflate__decoder__transform_io(
+                                     &dec, &have, &src, g_work_slice_u8));
+    if (have.meta.wi != (want.meta.wi - dst_pos)) {
+      RETURN_FAIL("c=%zu: dst length: have %zu, want %zu", c, have.meta.wi,
+                  want.meta.wi - dst_pos);
+    } else if (memcmp(g_have_array_u8, g_want_array_u8 + dst_pos,
+                      have.meta.wi)) {
+      RETURN_FAIL("c=%zu: have and want bytes differ", c);
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 do_test_wuffs_deflate_history(int i,
                               golden_test* gt,
@@ -728,6 +845,205 @@ test_wuffs_deflate_table_redirect() {
   return NULL;
 }
 
+// ---------------- Deflate Encoder Tests
+
+const char*  //
+wuffs_deflate_encode(wuffs_base__io_buffer* dst,
+                     wuffs_base__io_buffer* src,
+                     uint32_t wuffs_initialize_flags,
+                     uint64_t wlimit,
+                     uint64_t rlimit,
+                     uint64_t quality) {
+  wuffs_deflate__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION, wuffs_initialize_flags));
+  CHECK_STATUS("set_quirk",
+               wuffs_deflate__encoder__set_quirk(
+                   &enc, WUFFS_BASE__QUIRK_QUALITY, quality));
+
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+
+    wuffs_base__status status = wuffs_deflate__encoder__transform_io(
+        &enc, &limited_dst, &limited_src, g_work_slice_u8);
+
+    dst->meta.wi += limited_dst.meta.wi;
+    src->meta.ri += limited_src.meta.ri;
+
+    if (((wlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_write)) ||
+        ((rlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_read))) {
+      continue;
+    }
+    return status.repr;
+  }
+}
+
+const char*  //
+wuffs_deflate_encode_fast(wuffs_base__io_buffer* dst,
+                          wuffs_base__io_buffer* src,
+                          uint32_t wuffs_initialize_flags,
+                          uint64_t wlimit,
+                          uint64_t rlimit) {
+  return wuffs_deflate_encode(dst, src, wuffs_initialize_flags, wlimit, rlimit,
+                              WUFFS_BASE__QUIRK_QUALITY__VALUE__LOWER_QUALITY);
+}
+
+const char*  //
+wuffs_deflate_encode_default(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return wuffs_deflate_encode(dst, src, wuffs_initialize_flags, wlimit, rlimit,
+                              0);
+}
+
+const char*  //
+wuffs_deflate_encode_high(wuffs_base__io_buffer* dst,
+                          wuffs_base__io_buffer* src,
+                          uint32_t wuffs_initialize_flags,
+                          uint64_t wlimit,
+                          uint64_t rlimit) {
+  return wuffs_deflate_encode(dst, src, wuffs_initialize_flags, wlimit, rlimit,
+                              WUFFS_BASE__QUIRK_QUALITY__VALUE__HIGHER_QUALITY);
+}
+
+// do_test_wuffs_deflate_encode encodes src_filename with codec_func, checks
+// that the encoding is want_encoded_len bytes long and that decoding it gives
+// back the original. Passing a zero want_encoded_len skips the length check,
+// e.g. for mimic libraries.
+const char*  //
+do_test_wuffs_deflate_encode(const char* (*codec_func)(wuffs_base__io_buffer*,
+                                                       wuffs_base__io_buffer*,
+                                                       uint32_t,
+                                                       uint64_t,
+                                                       uint64_t),
+                             const char* src_filename,
+                             uint64_t wlimit,
+                             uint64_t rlimit,
+                             size_t want_encoded_len) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+
+  CHECK_STRING(read_file(&src, src_filename));
+  CHECK_STRING((*codec_func)(&have, &src, WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                             wlimit, rlimit));
+  if (src.meta.ri != src.meta.wi) {
+    RETURN_FAIL("src ri: have %zu, want %zu", src.meta.ri, src.meta.wi);
+  }
+  if (want_encoded_len && (have.meta.wi != want_encoded_len)) {
+    RETURN_FAIL("encoded length: have %zu, want %zu", have.meta.wi,
+                want_encoded_len);
+  }
+
+  have.meta.closed = true;
+  CHECK_STRING(wuffs_deflate_decode(&want, &have,
+                                    WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                    UINT64_MAX, UINT64_MAX));
+  src.meta.ri = 0;
+  return check_io_buffers_equal("round trip ", &want, &src);
+}
+
+const char*  //
+test_wuffs_deflate_encode_empty() {
+  CHECK_FOCUS(__func__);
+  // The smallest valid DEFLATE stream is a final fixed-Huffman block holding
+  // only the end-of-block symbol.
+  return do_test_wuffs_deflate_encode(wuffs_deflate_encode_default,
+                                      "test/data/0.bytes", UINT64_MAX,
+                                      UINT64_MAX, 2);
+}
+
+const char*  //
+test_wuffs_deflate_encode_interface() {
+  CHECK_FOCUS(__func__);
+  wuffs_deflate__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  return do_test__wuffs_base__io_transformer(
+      wuffs_deflate__encoder__upcast_as__wuffs_base__io_transformer(&enc),
+      "test/data/romeo.txt", 0, SIZE_MAX, 530, 0x00);
+}
+
+const char*  //
+test_wuffs_deflate_encode_midsummer_default() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_deflate_encode(wuffs_deflate_encode_default,
+                                      "test/data/midsummer.txt", UINT64_MAX,
+                                      UINT64_MAX, 5142);
+}
+
+const char*  //
+test_wuffs_deflate_encode_pi_default() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_deflate_encode(wuffs_deflate_encode_default,
+                                      "test/data/pi.txt", UINT64_MAX,
+                                      UINT64_MAX, 48195);
+}
+
+const char*  //
+test_wuffs_deflate_encode_pi_fast() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_deflate_encode(wuffs_deflate_encode_fast,
+                                      "test/data/pi.txt", UINT64_MAX,
+                                      UINT64_MAX, 49913);
+}
+
+const char*  //
+test_wuffs_deflate_encode_pi_high() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_deflate_encode(wuffs_deflate_encode_high,
+                                      "test/data/pi.txt", UINT64_MAX,
+                                      UINT64_MAX, 48195);
+}
+
+const char*  //
+test_wuffs_deflate_encode_pi_many_small_writes_reads() {
+  CHECK_FOCUS(__func__);
+  // The encoding should not depend on how the I/O is split.
+  return do_test_wuffs_deflate_encode(wuffs_deflate_encode_default,
+                                      "test/data/pi.txt", 59, 61, 48195);
+}
+
+const char*  //
+test_wuffs_deflate_encode_harvesters_fast() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_deflate_encode(wuffs_deflate_encode_fast,
+                                      "test/data/harvesters.bmp", UINT64_MAX,
+                                      UINT64_MAX, 2638083);
+}
+
+const char*  //
+test_wuffs_deflate_encode_harvesters_default() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_deflate_encode(wuffs_deflate_encode_default,
+                                      "test/data/harvesters.bmp", UINT64_MAX,
+                                      UINT64_MAX, 2631373);
+}
+
+const char*  //
+test_wuffs_deflate_encode_incompressible() {
+  CHECK_FOCUS(__func__);
+  // JPEG data is already compressed. There is little left to gain but the
+  // encoding should still be no longer than the input.
+  return do_test_wuffs_deflate_encode(wuffs_deflate_encode_default,
+                                      "test/data/harvesters.jpeg", UINT64_MAX,
+                                      UINT64_MAX, 402058);
+}
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -819,6 +1135,14 @@ test_mimic_deflate_decode_romeo_fixed() {
                             UINT64_MAX, UINT64_MAX);
 }
 
+const char*  //
+test_mimic_deflate_encode_pi_default() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_deflate_encode(mimic_deflate_encode_default,
+                                      "test/data/pi.txt", UINT64_MAX,
+                                      UINT64_MAX, 0);
+}
+
 #endif  // WUFFS_MIMIC
 
 // ---------------- Deflate Benches
@@ -875,6 +1199,24 @@ bench_wuffs_deflate_decode_100k_many_big_reads() {
       &g_deflate_pi_gt, UINT64_MAX, 4096, 30);
 }
 
+const char*  //
+bench_wuffs_deflate_encode_100k_fast() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_encode_fast,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &g_deflate_encode_pi_gt, UINT64_MAX, UINT64_MAX, 3);
+}
+
+const char*  //
+bench_wuffs_deflate_encode_100k_default() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_encode_default,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &g_deflate_encode_pi_gt, UINT64_MAX, UINT64_MAX, 3);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -908,6 +1250,22 @@ bench_mimic_deflate_decode_100k_many_big_reads() {
                              &g_deflate_pi_gt, UINT64_MAX, 4096, 30);
 }
 
+const char*  //
+bench_mimic_deflate_encode_100k_fast() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_deflate_encode_fast, 0, tcounter_src,
+                             &g_deflate_encode_pi_gt, UINT64_MAX, UINT64_MAX,
+                             3);
+}
+
+const char*  //
+bench_mimic_deflate_encode_100k_default() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_deflate_encode_default, 0, tcounter_src,
+                             &g_deflate_encode_pi_gt, UINT64_MAX, UINT64_MAX,
+                             3);
+}
+
 #endif  // WUFFS_MIMIC
 
 // ---------------- Manifest
@@ -915,6 +1273,7 @@ bench_mimic_deflate_decode_100k_many_big_reads() {
 proc g_tests[] = {
 
     test_wuffs_deflate_decode_256_bytes,
+    test_wuffs_deflate_decode_checkpoints,
     test_wuffs_deflate_decode_deflate_backref_crosses_blocks,
     test_wuffs_deflate_decode_deflate_degenerate_huffman,
     test_wuffs_deflate_decode_deflate_distance_32768,
@@ -930,6 +1289,16 @@ proc g_tests[] = {
     test_wuffs_deflate_decode_romeo_fixed,
     test_wuffs_deflate_decode_split_src,
     test_wuffs_deflate_decode_truncated_input,
+    test_wuffs_deflate_encode_empty,
+    test_wuffs_deflate_encode_harvesters_default,
+    test_wuffs_deflate_encode_harvesters_fast,
+    test_wuffs_deflate_encode_incompressible,
+    test_wuffs_deflate_encode_interface,
+    test_wuffs_deflate_encode_midsummer_default,
+    test_wuffs_deflate_encode_pi_default,
+    test_wuffs_deflate_encode_pi_fast,
+    test_wuffs_deflate_encode_pi_high,
+    test_wuffs_deflate_encode_pi_many_small_writes_reads,
     test_wuffs_deflate_history_full,
     test_wuffs_deflate_history_partial,
     test_wuffs_deflate_table_redirect,
@@ -949,6 +1318,7 @@ proc g_tests[] = {
 #endif
     test_mimic_deflate_decode_romeo,
     test_mimic_deflate_decode_romeo_fixed,
+    test_mimic_deflate_encode_pi_default,
 
 #endif  // WUFFS_MIMIC
 
@@ -963,6 +1333,8 @@ proc g_benches[] = {
     bench_wuffs_deflate_decode_10k_part_init,
     bench_wuffs_deflate_decode_100k_just_one_read,
     bench_wuffs_deflate_decode_100k_many_big_reads,
+    bench_wuffs_deflate_encode_100k_fast,
+    bench_wuffs_deflate_encode_100k_default,
 
 #ifdef WUFFS_MIMIC
 
@@ -972,6 +1344,8 @@ proc g_benches[] = {
 #ifndef WUFFS_MIMICLIB_DEFLATE_DOES_NOT_SUPPORT_STREAMING
     bench_mimic_deflate_decode_100k_many_big_reads,
 #endif
+    bench_mimic_deflate_encode_100k_fast,
+    bench_mimic_deflate_encode_100k_default,
 
 #endif  // WUFFS_MIMIC
 
@@ -123,15 +123,20 @@ test_wuffs_gzip_decode_truncated_input() {
 }
 
 const char*  //
-wuffs_gzip_decode(wuffs_base__io_buffer* dst,
-                  wuffs_base__io_buffer* src,
-                  uint32_t wuffs_initialize_flags,
-                  uint64_t wlimit,
-                  uint64_t rlimit) {
+do_wuffs_gzip_decode(wuffs_base__io_buffer* dst,
+                     wuffs_base__io_buffer* src,
+                     uint32_t wuffs_initialize_flags,
+                     uint64_t wlimit,
+                     uint64_t rlimit,
+                     bool ignore_checksum) {
   wuffs_gzip__decoder dec;
   CHECK_STATUS("initialize",
                wuffs_gzip__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
                                                wuffs_initialize_flags));
+  CHECK_STATUS("set_quirk",
+               wuffs_gzip__decoder__set_quirk(&dec,
+                                              WUFFS_BASE__QUIRK_IGNORE_CHECKSUM,
+                                              (uint64_t)ignore_checksum));
 
   while (true) {
     wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
@@ -153,6 +158,26 @@ wuffs_gzip_decode(wuffs_base__io_buffer* dst,
   }
 }
 
+const char*  //
+wuffs_gzip_decode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  uint32_t wuffs_initialize_flags,
+                  uint64_t wlimit,
+                  uint64_t rlimit) {
+  return do_wuffs_gzip_decode(dst, src, wuffs_initialize_flags, wlimit, rlimit,
+                              false);
+}
+
+const char*  //
+wuffs_gzip_decode_ignore_checksum(wuffs_base__io_buffer* dst,
+                                  wuffs_base__io_buffer* src,
+                                  uint32_t wuffs_initialize_flags,
+                                  uint64_t wlimit,
+                                  uint64_t rlimit) {
+  return do_wuffs_gzip_decode(dst, src, wuffs_initialize_flags, wlimit, rlimit,
+                              true);
+}
+
 const char*  //
 do_test_wuffs_gzip_checksum(bool ignore_checksum, uint32_t bad_checksum) {
   wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
@@ -315,6 +340,142 @@ test_wuffs_gzip_decode_pi() {
                             UINT64_MAX);
 }
 
+const char*  //
+test_wuffs_gzip_scan_members() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&want, "test/data/pi.txt"));
+  CHECK_STRING(read_file(&src, "test/data/pi.txt.bgzf"));
+
+  wuffs_gzip__decoder scanner;
+  CHECK_STATUS("initialize",
+               wuffs_gzip__decoder__initialize(
+                   &scanner, sizeof scanner, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+  // Scan each member and then decode it independently.
+  int num_members = 0;
+  while (src.meta.ri < src.meta.wi) {
+    size_t member_start = src.meta.ri;
+    CHECK_STATUS("scan_member",
+                 wuffs_gzip__decoder__scan_member(&scanner, &src));
+    uint64_t member_length = wuffs_gzip__decoder__member_length(&scanner);
+    if (member_length != (src.meta.ri - member_start)) {
+      RETURN_FAIL("member #%d: member_length: have %" PRIu64 ", want %zu",
+                  num_members, member_length, src.meta.ri - member_start);
+    }
+
+    wuffs_gzip__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_gzip__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__io_buffer member = wuffs_base__ptr_u8__reader(
+        src.data.ptr + member_start, (size_t)member_length, true);
+    size_t have_start = have.meta.wi;
+    CHECK_STATUS("transform_io", wuffs_gzip__decoder__transform_io(
+                                     &dec, &have, &member, g_work_slice_u8));
+    uint32_t decoded_length =
+        wuffs_gzip__decoder__member_decoded_length(&scanner);
+    if (decoded_length != (have.meta.wi - have_start)) {
+      RETURN_FAIL("member #%d: member_decoded_length: have %" PRIu32
+                  ", want %zu",
+                  num_members, decoded_length, have.meta.wi - have_start);
+    }
+    num_members++;
+  }
+
+  // pi.txt is 100003 bytes long, in 16 KiB pieces, plus the empty
+  // end-of-file member.
+  if (num_members != 8) {
+    RETURN_FAIL("num_members: have %d, want 8", num_members);
+  }
+  CHECK_STRING(check_io_buffers_equal("", &have, &want));
+
+  // A plain gzip file does not record its member length.
+  src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/pi.txt.gz"));
+  CHECK_STATUS("initialize",
+               wuffs_gzip__decoder__initialize(
+                   &scanner, sizeof scanner, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__status status =
+      wuffs_gzip__decoder__scan_member(&scanner, &src);
+  if (status.repr != wuffs_gzip__error__missing_member_length) {
+    RETURN_FAIL("pi.txt.gz: have \"%s\", want \"%s\"", status.repr,
+                wuffs_gzip__error__missing_member_length);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_gzip_encode_round_trip() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, g_gzip_pi_gt.want_filename));
+
+  wuffs_gzip__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_gzip__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  CHECK_STATUS("set_quirk",
+               wuffs_gzip__encoder__set_quirk(
+                   &enc, WUFFS_BASE__QUIRK_QUALITY,
+                   WUFFS_BASE__QUIRK_QUALITY__VALUE__LOWER_QUALITY));
+
+  // Use small I/O limits, so that the encoder has to suspend and resume while
+  // writing the gzip header and trailer.
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(have, 5);
+    wuffs_base__io_buffer limited_src = make_limited_reader(src, 7);
+    wuffs_base__status status = wuffs_gzip__encoder__transform_io(
+        &enc, &limited_dst, &limited_src, g_work_slice_u8);
+    have.meta.wi += limited_dst.meta.wi;
+    src.meta.ri += limited_src.meta.ri;
+    if ((status.repr == wuffs_base__suspension__short_write) ||
+        (status.repr == wuffs_base__suspension__short_read)) {
+      continue;
+    }
+    CHECK_STATUS("transform_io", status);
+    break;
+  }
+
+  // The XFL byte is 4 for the fastest compression level.
+  if ((have.meta.wi < 18) || (have.data.ptr[0] != 0x1F) ||
+      (have.data.ptr[1] != 0x8B) || (have.data.ptr[8] != 0x04)) {
+    RETURN_FAIL("invalid gzip header");
+  }
+
+  // Decoding verifies the CRC-32 checksum and the ISIZE in the trailer.
+  have.meta.closed = true;
+  CHECK_STRING(wuffs_gzip_decode(&want, &have,
+                                 WUFFS_INITIALIZE__DEFAULT_OPTIONS, UINT64_MAX,
+                                 UINT64_MAX));
+  src.meta.ri = 0;
+  return check_io_buffers_equal("", &want, &src);
+}
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -353,6 +514,27 @@ bench_wuffs_gzip_decode_100k() {
       tcounter_dst, &g_gzip_pi_gt, UINT64_MAX, UINT64_MAX, 30);
 }
 
+// The "ignore_checksum" benches measure how much of the time above is spent
+// checksumming the decoded output.
+
+const char*  //
+bench_wuffs_gzip_decode_10k_ignore_checksum() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_gzip_decode_ignore_checksum,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_dst,
+      &g_gzip_midsummer_gt, UINT64_MAX, UINT64_MAX, 300);
+}
+
+const char*  //
+bench_wuffs_gzip_decode_100k_ignore_checksum() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_gzip_decode_ignore_checksum,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_dst,
+      &g_gzip_pi_gt, UINT64_MAX, UINT64_MAX, 30);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -389,6 +571,8 @@ proc g_tests[] = {
     test_wuffs_gzip_decode_midsummer,
     test_wuffs_gzip_decode_pi,
     test_wuffs_gzip_decode_truncated_input,
+    test_wuffs_gzip_encode_round_trip,
+    test_wuffs_gzip_scan_members,
 
 #ifdef WUFFS_MIMIC
 
@@ -403,7 +587,9 @@ proc g_tests[] = {
 proc g_benches[] = {
 
     bench_wuffs_gzip_decode_10k,
+    bench_wuffs_gzip_decode_10k_ignore_checksum,
     bench_wuffs_gzip_decode_100k,
+    bench_wuffs_gzip_decode_100k_ignore_checksum,
 
 #ifdef WUFFS_MIMIC
 
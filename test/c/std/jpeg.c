@@ -82,6 +82,508 @@ wuffs_jpeg_decode(uint64_t* n_bytes_out,
       n_bytes_out, dst, pixfmt, quirks_ptr, quirks_len, src);
 }
 
+// do_wuffs_jpeg_decode_with_options is like wuffs_jpeg_decode but it passes
+// opts to decode_frame. It still counts the full-size image's pixels, so that
+// its benchmark numbers are comparable to wuffs_jpeg_decode's.
+const char*  //
+do_wuffs_jpeg_decode_with_options(uint64_t* n_bytes_out,
+                                  wuffs_base__io_buffer* dst,
+                                  uint32_t wuffs_initialize_flags,
+                                  wuffs_base__pixel_format pixfmt,
+                                  wuffs_base__io_buffer* src,
+                                  wuffs_base__decode_frame_options* opts) {
+  wuffs_jpeg__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_jpeg__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
+                                               wuffs_initialize_flags));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_jpeg__decoder__decode_image_config(&dec, &ic, src));
+  uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+  wuffs_base__pixel_config__set(&ic.pixcfg, pixfmt.repr,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width,
+                                height);
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &ic.pixcfg, g_pixel_slice_u8));
+
+  CHECK_STATUS("decode_frame", wuffs_jpeg__decoder__decode_frame(
+                                   &dec, &pb, src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                                   g_work_slice_u8, opts));
+  if (n_bytes_out) {
+    *n_bytes_out += ((uint64_t)width) * ((uint64_t)height) *
+                    (wuffs_base__pixel_format__bits_per_pixel(&pixfmt) / 8);
+  }
+  return NULL;
+}
+
+const char*  //
+wuffs_jpeg_decode_scaled_by_8(uint64_t* n_bytes_out,
+                              wuffs_base__io_buffer* dst,
+                              uint32_t wuffs_initialize_flags,
+                              wuffs_base__pixel_format pixfmt,
+                              uint32_t* quirks_ptr,
+                              size_t quirks_len,
+                              wuffs_base__io_buffer* src) {
+  wuffs_base__decode_frame_options opts =
+      wuffs_base__null_decode_frame_options();
+  wuffs_base__decode_frame_options__set_scale_denominator(&opts, 8);
+  return do_wuffs_jpeg_decode_with_options(n_bytes_out, dst,
+                                           wuffs_initialize_flags, pixfmt, src,
+                                           &opts);
+}
+
+// wuffs_jpeg_decode_top_left_tile only decodes the top-left 256×256 pixels,
+// like a tile server would.
+const char*  //
+wuffs_jpeg_decode_top_left_tile(uint64_t* n_bytes_out,
+                                wuffs_base__io_buffer* dst,
+                                uint32_t wuffs_initialize_flags,
+                                wuffs_base__pixel_format pixfmt,
+                                uint32_t* quirks_ptr,
+                                size_t quirks_len,
+                                wuffs_base__io_buffer* src) {
+  wuffs_base__decode_frame_options opts =
+      wuffs_base__null_decode_frame_options();
+  wuffs_base__decode_frame_options__set_region_of_interest(
+      &opts, wuffs_base__make_rect_ie_u32(0, 0, 256, 256));
+  return do_wuffs_jpeg_decode_with_options(n_bytes_out, dst,
+                                           wuffs_initialize_flags, pixfmt, src,
+                                           &opts);
+}
+
+// wuffs_jpeg_decode_lower_quality is like wuffs_jpeg_decode but it sets the
+// QUIRK_QUALITY quirk to LOWER_QUALITY, so that chroma upsampling uses box
+// filters instead of triangle filters.
+const char*  //
+wuffs_jpeg_decode_lower_quality(uint64_t* n_bytes_out,
+                                wuffs_base__io_buffer* dst,
+                                uint32_t wuffs_initialize_flags,
+                                wuffs_base__pixel_format pixfmt,
+                                uint32_t* quirks_ptr,
+                                size_t quirks_len,
+                                wuffs_base__io_buffer* src) {
+  wuffs_jpeg__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_jpeg__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
+                                               wuffs_initialize_flags));
+  CHECK_STATUS("set_quirk",
+               wuffs_jpeg__decoder__set_quirk(
+                   &dec, WUFFS_BASE__QUIRK_QUALITY,
+                   WUFFS_BASE__QUIRK_QUALITY__VALUE__LOWER_QUALITY));
+  return do_run__wuffs_base__image_decoder(
+      wuffs_jpeg__decoder__upcast_as__wuffs_base__image_decoder(&dec),
+      n_bytes_out, dst, pixfmt, quirks_ptr, quirks_len, src);
+}
+
+const char*  //
+do_test_wuffs_jpeg_decode_band(wuffs_base__rect_ie_u32* dirty_rect,
+                               uint64_t* workbuf_len,
+                               bool* splittable,
+                               wuffs_base__slice_u8 dst,
+                               wuffs_base__io_buffer* src,
+                               int mode,
+                               uint32_t band_index,
+                               uint32_t band_count) {
+  wuffs_jpeg__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_jpeg__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  if (mode > 0) {
+    CHECK_STATUS("set_quirk",
+                 wuffs_jpeg__decoder__set_quirk(
+                     &dec, WUFFS_BASE__QUIRK_QUALITY,
+                     WUFFS_BASE__QUIRK_QUALITY__VALUE__LOWER_QUALITY));
+  }
+  CHECK_STATUS("set_quirk",
+               wuffs_jpeg__decoder__set_quirk(
+                   &dec, WUFFS_JPEG__QUIRK_DECODE_BAND,
+                   (((uint64_t)band_count) << 32) | band_index));
+
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  src->meta.ri = 0;
+  CHECK_STATUS("decode_image_config",
+               wuffs_jpeg__decoder__decode_image_config(&dec, &ic, src));
+  wuffs_base__pixel_config__set(
+      &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+      wuffs_base__pixel_config__width(&ic.pixcfg),
+      wuffs_base__pixel_config__height(&ic.pixcfg));
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(&pb, &ic.pixcfg, dst));
+
+  // Fill the work buffer with non-zero junk. Each band's decoder should only
+  // rely on the parts of it that the decoder itself initializes.
+  wuffs_base__slice_u8 workbuf = g_work_slice_u8;
+  workbuf.len = (mode > 1)
+                    ? wuffs_jpeg__decoder__workbuf_len(&dec).min_incl
+                    : wuffs_jpeg__decoder__workbuf_len(&dec).max_incl;
+  if (workbuf.len > g_work_slice_u8.len) {
+    RETURN_FAIL("workbuf_len is too large");
+  }
+  memset(workbuf.ptr, 0xAB, workbuf.len);
+  *workbuf_len = workbuf.len;
+
+  // The first band's decoder suspends (before decoding anything) if the other
+  // bands aren't empty.
+  *splittable = false;
+  wuffs_base__status status = wuffs_jpeg__decoder__decode_frame(
+      &dec, &pb, src, WUFFS_BASE__PIXEL_BLEND__SRC, workbuf, NULL);
+  if (status.repr == wuffs_jpeg__suspension__splittable_into_bands) {
+    *splittable = true;
+    status = wuffs_jpeg__decoder__decode_frame(
+        &dec, &pb, src, WUFFS_BASE__PIXEL_BLEND__SRC, workbuf, NULL);
+  }
+  CHECK_STATUS("decode_frame", status);
+  *dirty_rect = wuffs_jpeg__decoder__frame_dirty_rect(&dec);
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_band() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[3] = {
+      "test/data/artificial-jpeg/bricks-color-restart-interval.jpeg",
+      "test/data/bricks-color.jpeg",
+      "test/data/peacock.progressive.jpeg",
+  };
+  // The images are 120 pixels high. The first file has 16-pixel-high MCUs,
+  // so 8 MCU rows, fewer than the last band count.
+  const uint32_t band_counts[4] = {2, 3, 8, 11};
+  const uint32_t height_in_mcus = 8;
+
+  wuffs_jpeg__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_jpeg__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__status status = wuffs_jpeg__decoder__set_quirk(
+      &dec, WUFFS_JPEG__QUIRK_DECODE_BAND, (((uint64_t)3) << 32) | 3);
+  if (status.repr != wuffs_base__error__bad_argument) {
+    RETURN_FAIL("set_quirk: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__error__bad_argument);
+  }
+
+  for (int f = 0; f < 3; f++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[f]));
+
+    // Mode 0 is the default quality. Mode 1 is lower quality. Mode 2 is lower
+    // quality with the shortest work buffer (swizzling each MCU immediately):
+    // none for sequential JPEGs and only the coefficients for progressive.
+    for (int mode = 0; mode < 3; mode++) {
+      wuffs_base__rect_ie_u32 dirty_rect;
+      uint64_t whole_workbuf_len = 0;
+      uint64_t workbuf_len = 0;
+      bool splittable = false;
+      memset(g_want_array_u8, 0, 160 * 120 * 4);
+      CHECK_STRING(do_test_wuffs_jpeg_decode_band(
+          &dirty_rect, &whole_workbuf_len, &splittable,
+          wuffs_base__make_slice_u8(g_want_array_u8, 160 * 120 * 4), &src,
+          mode, 0, 1));
+      uint32_t height = dirty_rect.max_excl_y;
+
+      // Modes 1 and 2 should produce the same pixels.
+      if (mode == 2) {
+        memset(g_have_array_u8, 0, 160 * 120 * 4);
+        CHECK_STRING(do_test_wuffs_jpeg_decode_band(
+            &dirty_rect, &workbuf_len, &splittable,
+            wuffs_base__make_slice_u8(g_have_array_u8, 160 * 120 * 4), &src,
+            1, 0, 1));
+        if (memcmp(g_have_array_u8, g_want_array_u8, 160 * 120 * 4)) {
+          RETURN_FAIL("f=%d: pixels differ between modes 1 and 2", f);
+        }
+      }
+
+      for (int c = 0; c < 4; c++) {
+        memset(g_have_array_u8, 0, 160 * 120 * 4);
+        uint32_t y = 0;
+        uint32_t num_non_empty_bands = 0;
+        for (uint32_t i = 0; i < band_counts[c]; i++) {
+          CHECK_STRING(do_test_wuffs_jpeg_decode_band(
+              &dirty_rect, &workbuf_len, &splittable,
+              wuffs_base__make_slice_u8(g_have_array_u8, 160 * 120 * 4), &src,
+              mode, i, band_counts[c]));
+
+          // Only the first band's decoder reports whether the image can be
+          // split. The other bands' decoders need only part of the whole
+          // image's work buffer.
+          if (splittable != ((f == 0) && (i == 0))) {
+            RETURN_FAIL("f=%d, mode=%d, c=%d, i=%" PRIu32
+                        ": splittable: have %d, want %d",
+                        f, mode, c, i, (int)splittable, (int)!splittable);
+          } else if ((i == 0) ? (workbuf_len != whole_workbuf_len)
+                              : (whole_workbuf_len &&
+                                 (workbuf_len >= whole_workbuf_len))) {
+            RETURN_FAIL("f=%d, mode=%d, c=%d, i=%" PRIu32
+                        ": workbuf_len: have %" PRIu64 ", whole %" PRIu64,
+                        f, mode, c, i, workbuf_len, whole_workbuf_len);
+          }
+
+          if (dirty_rect.min_incl_y >= dirty_rect.max_excl_y) {
+            continue;
+          } else if (dirty_rect.min_incl_y != y) {
+            RETURN_FAIL("f=%d, mode=%d, c=%d, i=%" PRIu32
+                        ": min_incl_y: have %" PRIu32 ", want %" PRIu32,
+                        f, mode, c, i, dirty_rect.min_incl_y, y);
+          }
+          y = dirty_rect.max_excl_y;
+          num_non_empty_bands++;
+        }
+        if (y != height) {
+          RETURN_FAIL("f=%d, mode=%d, c=%d: max_excl_y: have %" PRIu32
+                      ", want %" PRIu32,
+                      f, mode, c, y, height);
+        }
+
+        // Only the first file has restart markers, so only it can be split,
+        // into at most one band per MCU row.
+        uint32_t want_non_empty_bands =
+            (f != 0) ? 1
+                     : ((band_counts[c] < height_in_mcus) ? band_counts[c]
+                                                           : height_in_mcus);
+        if (num_non_empty_bands != want_non_empty_bands) {
+          RETURN_FAIL("f=%d, mode=%d, c=%d: num_non_empty_bands: have %" PRIu32
+                      ", want %" PRIu32,
+                      f, mode, c, num_non_empty_bands, want_non_empty_bands);
+        } else if (memcmp(g_have_array_u8, g_want_array_u8, 160 * 120 * 4)) {
+          RETURN_FAIL("f=%d, mode=%d, c=%d: pixels differ", f, mode, c);
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
+// g_cos_pi_over_16[k] is cos(k * π / 16), for k in [0 ..= 8].
+static const double g_cos_pi_over_16[9] = {
+    1.000000000000000, 0.980785280403230, 0.923879532511287,
+    0.831469612302545, 0.707106781186548, 0.555570233019602,
+    0.382683432365090, 0.195090322016128, 0.000000000000000,
+};
+
+// cos_pi_over_16 returns cos(k * π / 16), for any non-negative k.
+double  //
+cos_pi_over_16(int k) {
+  k &= 31;
+  if (k <= 8) {
+    return +g_cos_pi_over_16[k];
+  } else if (k <= 16) {
+    return -g_cos_pi_over_16[16 - k];
+  } else if (k <= 24) {
+    return -g_cos_pi_over_16[k - 16];
+  }
+  return +g_cos_pi_over_16[32 - k];
+}
+
+// do_test_wuffs_jpeg_decode_coefficients decodes src with the
+// QUIRK_DECODE_COEFFICIENTS quirk, leaving the coefficients in g_work_slice_u8.
+const char*  //
+do_test_wuffs_jpeg_decode_coefficients(wuffs_jpeg__decoder* dec,
+                                       wuffs_base__io_buffer* src) {
+  CHECK_STATUS("initialize",
+               wuffs_jpeg__decoder__initialize(
+                   dec, sizeof *dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  CHECK_STATUS("set_quirk",
+               wuffs_jpeg__decoder__set_quirk(
+                   dec, WUFFS_JPEG__QUIRK_DECODE_COEFFICIENTS, 1));
+  src->meta.ri = 0;
+  CHECK_STATUS("decode_image_config",
+               wuffs_jpeg__decoder__decode_image_config(dec, NULL, src));
+
+  wuffs_base__range_ii_u64 workbuf_len = wuffs_jpeg__decoder__workbuf_len(dec);
+  if ((workbuf_len.min_incl == 0) ||
+      (workbuf_len.min_incl > g_work_slice_u8.len)) {
+    RETURN_FAIL("workbuf_len: have %" PRIu64 ", want positive and small",
+                workbuf_len.min_incl);
+  }
+  wuffs_base__slice_u8 workbuf = g_work_slice_u8;
+  workbuf.len = workbuf_len.min_incl;
+  memset(workbuf.ptr, 0xAB, workbuf.len);
+
+  // The dst pixel buffer is ignored.
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("decode_frame", wuffs_jpeg__decoder__decode_frame(
+                                   dec, &pb, src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                                   workbuf, NULL));
+  wuffs_base__rect_ie_u32 dirty_rect =
+      wuffs_jpeg__decoder__frame_dirty_rect(dec);
+  if (!wuffs_base__rect_ie_u32__is_empty(&dirty_rect)) {
+    RETURN_FAIL("frame_dirty_rect: have non-empty, want empty");
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_coefficients() {
+  CHECK_FOCUS(__func__);
+
+  // Setting the quirk after decode_image_config is an error.
+  {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, "test/data/bricks-gray.jpeg"));
+    wuffs_jpeg__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_jpeg__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STATUS("decode_image_config",
+                 wuffs_jpeg__decoder__decode_image_config(&dec, NULL, &src));
+    wuffs_base__status status = wuffs_jpeg__decoder__set_quirk(
+        &dec, WUFFS_JPEG__QUIRK_DECODE_COEFFICIENTS, 1);
+    if (status.repr != wuffs_base__error__bad_call_sequence) {
+      RETURN_FAIL("set_quirk: have \"%s\", want \"%s\"", status.repr,
+                  wuffs_base__error__bad_call_sequence);
+    }
+  }
+
+  // For a grayscale JPEG, the dequantized coefficients' IDCT (computed here
+  // with floating point math) should match a regular decode's pixels (computed
+  // with integer math), give or take rounding errors.
+  {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, "test/data/bricks-gray.jpeg"));
+    wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+        .data = g_have_slice_u8,
+    });
+    CHECK_STRING(wuffs_jpeg_decode(
+        NULL, &have, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+        wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__Y), NULL, 0,
+        &src));
+    const uint32_t width = 160;
+    const uint32_t height = 120;
+    if (have.meta.wi != (width * height)) {
+      RETURN_FAIL("Y decode: have %zu bytes, want %" PRIu32, have.meta.wi,
+                  width * height);
+    }
+
+    wuffs_jpeg__decoder dec;
+    CHECK_STRING(do_test_wuffs_jpeg_decode_coefficients(&dec, &src));
+    if (wuffs_jpeg__decoder__coefficient_plane_range(&dec, 1).max_excl != 0) {
+      RETURN_FAIL("coefficient_plane_range(1): have non-empty, want empty");
+    }
+    wuffs_base__range_ie_u64 range =
+        wuffs_jpeg__decoder__coefficient_plane_range(&dec, 0);
+    uint32_t bw =
+        wuffs_jpeg__decoder__coefficient_plane_width_in_blocks(&dec, 0);
+    uint32_t bh =
+        wuffs_jpeg__decoder__coefficient_plane_height_in_blocks(&dec, 0);
+    if ((bw != 20) || (bh != 15) ||
+        ((range.max_excl - range.min_incl) != (128u * bw * bh))) {
+      RETURN_FAIL("plane: have %" PRIu32 "×%" PRIu32 " blocks, %" PRIu64
+                  " bytes",
+                  bw, bh, range.max_excl - range.min_incl);
+    }
+    uint16_t quants[64];
+    for (uint32_t i = 0; i < 64; i++) {
+      quants[i] = wuffs_jpeg__decoder__quantization_table_value(&dec, 0, i);
+      if (quants[i] == 0) {
+        RETURN_FAIL("quantization_table_value(0, %" PRIu32 "): have zero", i);
+      }
+    }
+
+    for (uint32_t by = 0; by < bh; by++) {
+      for (uint32_t bx = 0; bx < bw; bx++) {
+        const uint8_t* p = g_work_slice_u8.ptr + range.min_incl +
+                           (128u * ((by * bw) + bx));
+        double coeffs[64];
+        for (int i = 0; i < 64; i++) {
+          uint16_t u;
+          memcpy(&u, p + (2 * i), 2);
+          coeffs[i] = ((double)((int16_t)u)) * quants[i];
+        }
+        for (int y = 0; y < 8; y++) {
+          for (int x = 0; x < 8; x++) {
+            double sum = 0;
+            for (int v = 0; v < 8; v++) {
+              for (int u = 0; u < 8; u++) {
+                double cu = u ? 1.0 : g_cos_pi_over_16[4];
+                double cv = v ? 1.0 : g_cos_pi_over_16[4];
+                sum += cu * cv * coeffs[(8 * v) + u] *
+                       cos_pi_over_16(((2 * x) + 1) * u) *
+                       cos_pi_over_16(((2 * y) + 1) * v);
+              }
+            }
+            double want = (sum / 4) + 128;
+            want = (want < 0) ? 0 : (want > 255) ? 255 : want;
+            uint32_t px = (8 * bx) + x;
+            uint32_t py = (8 * by) + y;
+            double got = have.data.ptr[(py * width) + px];
+            if (((got - want) > 2) || ((want - got) > 2)) {
+              RETURN_FAIL("pixel (%" PRIu32 ", %" PRIu32
+                          "): have %.0f, want %.2f",
+                          px, py, got, want);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // Sequential and progressive encodings (by cjpeg, of the same source
+  // image) have the same coefficients.
+  {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, "test/data/peacock.default.jpeg"));
+    wuffs_jpeg__decoder dec;
+    CHECK_STRING(do_test_wuffs_jpeg_decode_coefficients(&dec, &src));
+    size_t n = wuffs_jpeg__decoder__workbuf_len(&dec).min_incl;
+    if (n > sizeof(g_want_array_u8)) {
+      RETURN_FAIL("sequential: workbuf_len is too large");
+    }
+    memcpy(g_want_array_u8, g_work_slice_u8.ptr, n);
+    uint16_t want_quants[3][64];
+    for (uint32_t c = 0; c < 3; c++) {
+      for (uint32_t i = 0; i < 64; i++) {
+        want_quants[c][i] =
+            wuffs_jpeg__decoder__quantization_table_value(&dec, c, i);
+      }
+    }
+
+    src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, "test/data/peacock.progressive.jpeg"));
+    CHECK_STRING(do_test_wuffs_jpeg_decode_coefficients(&dec, &src));
+    if (n != wuffs_jpeg__decoder__workbuf_len(&dec).min_incl) {
+      RETURN_FAIL("progressive: workbuf_len: have %" PRIu64 ", want %zu",
+                  wuffs_jpeg__decoder__workbuf_len(&dec).min_incl, n);
+    }
+    for (uint32_t c = 0; c < 3; c++) {
+      wuffs_base__range_ie_u64 range =
+          wuffs_jpeg__decoder__coefficient_plane_range(&dec, c);
+      if ((range.min_incl > range.max_excl) || (range.max_excl > n)) {
+        RETURN_FAIL("c=%" PRIu32 ": bad range", c);
+      } else if (memcmp(g_work_slice_u8.ptr + range.min_incl,
+                        g_want_array_u8 + range.min_incl,
+                        range.max_excl - range.min_incl)) {
+        RETURN_FAIL("c=%" PRIu32 ": coefficients differ", c);
+      }
+      for (uint32_t i = 0; i < 64; i++) {
+        if (want_quants[c][i] !=
+            wuffs_jpeg__decoder__quantization_table_value(&dec, c, i)) {
+          RETURN_FAIL("c=%" PRIu32 ": quantization tables differ", c);
+        }
+      }
+    }
+  }
+
+  return NULL;
+}
+
 const char*  //
 test_wuffs_jpeg_decode_interface() {
   CHECK_FOCUS(__func__);
@@ -137,6 +639,550 @@ test_wuffs_jpeg_decode_lower_quality() {
   return NULL;
 }
 
+const char*  //
+do_test_wuffs_jpeg_decode_region_of_interest(
+    wuffs_base__rect_ie_u32* dirty_rect,
+    wuffs_base__pixel_buffer* pb,
+    wuffs_base__io_buffer* src,
+    int mode,
+    uint32_t scale_denominator,
+    wuffs_base__rect_ie_u32 roi) {
+  wuffs_jpeg__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_jpeg__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  if (mode > 0) {
+    CHECK_STATUS("set_quirk",
+                 wuffs_jpeg__decoder__set_quirk(
+                     &dec, WUFFS_BASE__QUIRK_QUALITY,
+                     WUFFS_BASE__QUIRK_QUALITY__VALUE__LOWER_QUALITY));
+  }
+  src->meta.ri = 0;
+  CHECK_STATUS("decode_image_config",
+               wuffs_jpeg__decoder__decode_image_config(&dec, NULL, src));
+
+  // Fill the work buffer with non-zero junk, as in
+  // do_test_wuffs_jpeg_decode_band.
+  wuffs_base__slice_u8 workbuf = g_work_slice_u8;
+  workbuf.len = (mode > 1)
+                    ? wuffs_jpeg__decoder__workbuf_len(&dec).min_incl
+                    : wuffs_jpeg__decoder__workbuf_len(&dec).max_incl;
+  if (workbuf.len > g_work_slice_u8.len) {
+    RETURN_FAIL("workbuf_len is too large");
+  }
+  memset(workbuf.ptr, 0xAB, workbuf.len);
+
+  wuffs_base__decode_frame_options opts =
+      wuffs_base__null_decode_frame_options();
+  wuffs_base__decode_frame_options__set_scale_denominator(&opts,
+                                                          scale_denominator);
+  wuffs_base__decode_frame_options__set_region_of_interest(&opts, roi);
+  CHECK_STATUS("decode_frame", wuffs_jpeg__decoder__decode_frame(
+                                   &dec, pb, src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                                   workbuf, &opts));
+  *dirty_rect = wuffs_jpeg__decoder__frame_dirty_rect(&dec);
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_region_of_interest() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[6] = {
+      "test/data/artificial-jpeg/bricks-color-restart-interval.jpeg",
+      "test/data/bricks-color.jpeg",
+      "test/data/bricks-gray.jpeg",
+      "test/data/mona-lisa.21x32.q90.jpeg",
+      "test/data/peacock.progressive.jpeg",
+      "test/data/peacock.s-weird.jpeg",
+  };
+
+  // The last two ROIs are empty: one means the whole frame and the other is
+  // outside of every test file's frame.
+  const wuffs_base__rect_ie_u32 rois[7] = {
+      {0, 0, 1, 1},          //
+      {17, 9, 61, 50},       //
+      {32, 48, 64, 80},      //
+      {33, 40, 1000, 1000},  //
+      {150, 110, 160, 120},  //
+      {0, 0, 0, 0},          //
+      {5000, 5000, 5001, 5001},
+  };
+
+  for (int f = 0; f < 6; f++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[f]));
+
+    wuffs_jpeg__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_jpeg__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_jpeg__decoder__decode_image_config(&dec, &ic, &src));
+    uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+    uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+        WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+    size_t n = ((size_t)width) * ((size_t)height) * 4;
+    if ((n > sizeof(g_want_array_u8)) || (n > sizeof(g_have_array_u8))) {
+      RETURN_FAIL("f=%d: image is too large", f);
+    }
+
+    // Mode 0 is the default quality. Mode 1 is lower quality. Mode 2 is lower
+    // quality with the shortest work buffer (see test_wuffs_jpeg_decode_band).
+    for (int mode = 0; mode < 3; mode++) {
+      for (uint32_t d = 1; d <= ((mode < 2) ? 2 : 1); d++) {
+        wuffs_base__rect_ie_u32 dirty_rect;
+        wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+        CHECK_STATUS("set_from_slice",
+                     wuffs_base__pixel_buffer__set_from_slice(
+                         &want_pb, &ic.pixcfg,
+                         wuffs_base__make_slice_u8(g_want_array_u8, n)));
+        CHECK_STRING(do_test_wuffs_jpeg_decode_region_of_interest(
+            &dirty_rect, &want_pb, &src, mode, d,
+            wuffs_base__empty_rect_ie_u32()));
+        wuffs_base__rect_ie_u32 frame = dirty_rect;
+
+        for (int r = 0; r < 7; r++) {
+          memset(g_have_array_u8, 0, n);
+          wuffs_base__pixel_buffer have_pb = ((wuffs_base__pixel_buffer){});
+          CHECK_STATUS("set_from_slice",
+                       wuffs_base__pixel_buffer__set_from_slice(
+                           &have_pb, &ic.pixcfg,
+                           wuffs_base__make_slice_u8(g_have_array_u8, n)));
+          CHECK_STRING(do_test_wuffs_jpeg_decode_region_of_interest(
+              &dirty_rect, &have_pb, &src, mode, d, rois[r]));
+
+          wuffs_base__rect_ie_u32 want_rect =
+              wuffs_base__rect_ie_u32__is_empty(&rois[r])
+                  ? frame
+                  : wuffs_base__rect_ie_u32__intersect(&frame, rois[r]);
+          if (wuffs_base__rect_ie_u32__is_empty(&want_rect)) {
+            if (!wuffs_base__rect_ie_u32__is_empty(&dirty_rect)) {
+              RETURN_FAIL("f=%d, mode=%d, d=%" PRIu32
+                          ", r=%d: dirty_rect: have non-empty, want empty",
+                          f, mode, d, r);
+            }
+          } else if (!wuffs_base__rect_ie_u32__contains_rect(&dirty_rect,
+                                                             want_rect) ||
+                     !wuffs_base__rect_ie_u32__contains_rect(&frame,
+                                                             dirty_rect)) {
+            RETURN_FAIL("f=%d, mode=%d, d=%" PRIu32 ", r=%d: dirty_rect: have (%" PRIu32
+                        ", %" PRIu32 ")-(%" PRIu32 ", %" PRIu32 ")",
+                        f, mode, d, r, dirty_rect.min_incl_x,
+                        dirty_rect.min_incl_y, dirty_rect.max_excl_x,
+                        dirty_rect.max_excl_y);
+          }
+
+          // Pixels within the ROI should match the whole-frame decode. Pixels
+          // outside of the dirty_rect should be untouched. Pixels in between
+          // could be either.
+          for (uint32_t y = 0; y < height; y++) {
+            for (uint32_t x = 0; x < width; x++) {
+              size_t i = 4 * ((((size_t)y) * width) + x);
+              if (wuffs_base__rect_ie_u32__contains(&want_rect, x, y)) {
+                if (memcmp(g_have_array_u8 + i, g_want_array_u8 + i, 4)) {
+                  RETURN_FAIL("f=%d, mode=%d, d=%" PRIu32 ", r=%d: pixel (%" PRIu32
+                              ", %" PRIu32 ") differs",
+                              f, mode, d, r, x, y);
+                }
+              } else if (!wuffs_base__rect_ie_u32__contains(&dirty_rect, x,
+                                                            y)) {
+                const uint8_t* have = g_have_array_u8 + i;
+                if (have[0] | have[1] | have[2] | have[3]) {
+                  RETURN_FAIL("f=%d, mode=%d, d=%" PRIu32 ", r=%d: pixel (%" PRIu32
+                              ", %" PRIu32
+                              ") is outside of the dirty_rect but was "
+                              "modified",
+                              f, mode, d, r, x, y);
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
+// set_ycbcr_planes lays out the three planes of a YCbCr pixel buffer in
+// memory, per the pixcfg's pixel subsampling. It sets *n to the total number
+// of bytes used.
+const char*  //
+set_ycbcr_planes(wuffs_base__pixel_buffer* pb,
+                 size_t* n,
+                 const wuffs_base__pixel_config* pixcfg,
+                 uint8_t* memory,
+                 size_t memory_len) {
+  *n = 0;
+  wuffs_base__pixel_subsampling pixsub =
+      wuffs_base__pixel_config__pixel_subsampling(pixcfg);
+  uint32_t width = wuffs_base__pixel_config__width(pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(pixcfg);
+  wuffs_base__table_u8 planes[3];
+  for (uint32_t p = 0; p < 3; p++) {
+    uint32_t dx = wuffs_base__pixel_subsampling__denominator_x(&pixsub, p);
+    uint32_t dy = wuffs_base__pixel_subsampling__denominator_y(&pixsub, p);
+    size_t pw = (width + dx - 1) / dx;
+    size_t ph = (height + dy - 1) / dy;
+    if ((pw * ph) > memory_len) {
+      RETURN_FAIL("p=%" PRIu32 ": image is too large", p);
+    }
+    planes[p] = wuffs_base__make_table_u8(memory, pw, ph, pw);
+    memset(memory, 0, pw * ph);
+    memory += pw * ph;
+    memory_len -= pw * ph;
+    *n += pw * ph;
+  }
+  CHECK_STATUS("set_planar", wuffs_base__pixel_buffer__set_planar(
+                                 pb, pixcfg, &planes[0], 3));
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_planar() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[5] = {
+      "test/data/peacock.s1x1-444.jpeg",  //
+      "test/data/peacock.s2x1-422.jpeg",  //
+      "test/data/peacock.s2x2-420.jpeg",  //
+      "test/data/peacock.s1x3.jpeg",      //
+      "test/data/peacock.s-weird.jpeg",
+  };
+  const uint32_t want_pixsubs[5] = {
+      WUFFS_BASE__PIXEL_SUBSAMPLING__444,  //
+      WUFFS_BASE__PIXEL_SUBSAMPLING__422,  //
+      WUFFS_BASE__PIXEL_SUBSAMPLING__420,  //
+      0x020200,                            //
+      0x110100,
+  };
+
+  for (int f = 0; f < 5; f++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[f]));
+
+    wuffs_jpeg__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_jpeg__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_jpeg__decoder__decode_image_config(&dec, &ic, &src));
+    uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+    uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+    wuffs_base__pixel_subsampling pixsub =
+        wuffs_base__pixel_config__pixel_subsampling(&ic.pixcfg);
+    if (pixsub.repr != want_pixsubs[f]) {
+      RETURN_FAIL("f=%d: pixsub: have 0x%06" PRIX32 ", want 0x%06" PRIX32, f,
+                  pixsub.repr, want_pixsubs[f]);
+    }
+
+    // Decode to planar YCbCr with each of the three modes (see
+    // test_wuffs_jpeg_decode_region_of_interest). Without upsampling, they
+    // should all produce the same samples.
+    wuffs_base__pixel_config ycbcr_pixcfg = ic.pixcfg;
+    wuffs_base__pixel_config__set(&ycbcr_pixcfg,
+                                  WUFFS_BASE__PIXEL_FORMAT__YCBCR, pixsub.repr,
+                                  width, height);
+    const size_t half = sizeof(g_want_array_u8) / 2;
+    size_t planes_len = 0;
+    for (int mode = 0; mode < 3; mode++) {
+      uint8_t* memory = (mode == 0) ? g_want_array_u8 : g_have_array_u8;
+      wuffs_base__rect_ie_u32 dirty_rect;
+      wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+      CHECK_STRING(
+          set_ycbcr_planes(&pb, &planes_len, &ycbcr_pixcfg, memory, half));
+      CHECK_STRING(do_test_wuffs_jpeg_decode_region_of_interest(
+          &dirty_rect, &pb, &src, mode, 1, wuffs_base__empty_rect_ie_u32()));
+      if ((dirty_rect.max_excl_x != width) ||
+          (dirty_rect.max_excl_y != height)) {
+        RETURN_FAIL("f=%d, mode=%d: dirty_rect: have (%" PRIu32 ", %" PRIu32
+                    "), want (%" PRIu32 ", %" PRIu32 ")",
+                    f, mode, dirty_rect.max_excl_x, dirty_rect.max_excl_y,
+                    width, height);
+      }
+      if ((mode > 0) && memcmp(g_have_array_u8, g_want_array_u8, planes_len)) {
+        RETURN_FAIL("f=%d, mode=%d: planes differ from mode=0", f, mode);
+      }
+    }
+
+    // The lower quality (box filter) upsampling replicates each chroma sample
+    // over its macropixel, so each BGRA pixel should be the color conversion
+    // of its (Y, Cb, Cr) samples.
+    wuffs_base__pixel_config bgra_pixcfg = ic.pixcfg;
+    wuffs_base__pixel_config__set(
+        &bgra_pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+        WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+    size_t n = ((size_t)width) * ((size_t)height) * 4;
+    if (n > sizeof(g_have_array_u8)) {
+      RETURN_FAIL("f=%d: image is too large", f);
+    }
+    wuffs_base__rect_ie_u32 dirty_rect;
+    wuffs_base__pixel_buffer bgra_pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice",
+                 wuffs_base__pixel_buffer__set_from_slice(
+                     &bgra_pb, &bgra_pixcfg,
+                     wuffs_base__make_slice_u8(g_have_array_u8, n)));
+    CHECK_STRING(do_test_wuffs_jpeg_decode_region_of_interest(
+        &dirty_rect, &bgra_pb, &src, 1, 1, wuffs_base__empty_rect_ie_u32()));
+
+    wuffs_base__pixel_buffer ycbcr_pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STRING(set_ycbcr_planes(&ycbcr_pb, &planes_len, &ycbcr_pixcfg,
+                                  g_want_array_u8, half));
+    CHECK_STRING(do_test_wuffs_jpeg_decode_region_of_interest(
+        &dirty_rect, &ycbcr_pb, &src, 1, 1, wuffs_base__empty_rect_ie_u32()));
+    wuffs_base__table_u8 planes[3];
+    for (uint32_t p = 0; p < 3; p++) {
+      planes[p] = wuffs_base__pixel_buffer__plane(&ycbcr_pb, p);
+    }
+    for (uint32_t y = 0; y < height; y++) {
+      for (uint32_t x = 0; x < width; x++) {
+        uint8_t samples[3];
+        for (uint32_t p = 0; p < 3; p++) {
+          uint32_t i =
+              x / wuffs_base__pixel_subsampling__denominator_x(&pixsub, p);
+          uint32_t j =
+              y / wuffs_base__pixel_subsampling__denominator_y(&pixsub, p);
+          samples[p] = planes[p].ptr[(j * planes[p].stride) + i];
+        }
+        uint32_t want = wuffs_base__color_ycc__as__color_u32(
+            samples[0], samples[1], samples[2]);
+        uint32_t have = wuffs_base__peek_u32le__no_bounds_check(
+            g_have_array_u8 + (4 * ((((size_t)y) * width) + x)));
+        if (have != want) {
+          RETURN_FAIL("f=%d: pixel (%" PRIu32 ", %" PRIu32
+                      "): have 0x%08" PRIX32 ", want 0x%08" PRIX32,
+                      f, x, y, have, want);
+        }
+      }
+    }
+
+    // A pixel subsampling that doesn't match the JPEG's is rejected.
+    wuffs_base__pixel_config__set(
+        &ycbcr_pixcfg, WUFFS_BASE__PIXEL_FORMAT__YCBCR,
+        (pixsub.repr == WUFFS_BASE__PIXEL_SUBSAMPLING__444)
+            ? WUFFS_BASE__PIXEL_SUBSAMPLING__420
+            : WUFFS_BASE__PIXEL_SUBSAMPLING__444,
+        width, height);
+    CHECK_STRING(set_ycbcr_planes(&ycbcr_pb, &planes_len, &ycbcr_pixcfg,
+                                  g_want_array_u8, half));
+    const char* have_err = do_test_wuffs_jpeg_decode_region_of_interest(
+        &dirty_rect, &ycbcr_pb, &src, 0, 1, wuffs_base__empty_rect_ie_u32());
+    const char* want_err = wuffs_base__error__unsupported_pixel_swizzler_option;
+    if (!have_err || !strstr(have_err, want_err)) {
+      RETURN_FAIL("f=%d: mismatched pixsub: have \"%s\", want \"%s\"", f,
+                  have_err ? have_err : "", want_err);
+    }
+  }
+
+  // Grayscale JPEGs don't decode to planar YCbCr.
+  {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, "test/data/bricks-gray.jpeg"));
+    wuffs_jpeg__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_jpeg__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_jpeg__decoder__decode_image_config(&dec, &ic, &src));
+    if (ic.pixcfg.private_impl.pixsub.repr != 0) {
+      RETURN_FAIL("gray: pixsub: have 0x%06" PRIX32 ", want 0",
+                  ic.pixcfg.private_impl.pixsub.repr);
+    }
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__YCBCR,
+        WUFFS_BASE__PIXEL_SUBSAMPLING__444,
+        wuffs_base__pixel_config__width(&ic.pixcfg),
+        wuffs_base__pixel_config__height(&ic.pixcfg));
+    wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+    size_t planes_len = 0;
+    CHECK_STRING(set_ycbcr_planes(&pb, &planes_len, &ic.pixcfg,
+                                  g_have_array_u8, sizeof(g_have_array_u8)));
+    wuffs_base__status have = wuffs_jpeg__decoder__decode_frame(
+        &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, g_work_slice_u8, NULL);
+    if (have.repr != wuffs_base__error__unsupported_pixel_swizzler_option) {
+      RETURN_FAIL("gray: decode_frame: have \"%s\", want \"%s\"", have.repr,
+                  wuffs_base__error__unsupported_pixel_swizzler_option);
+    }
+  }
+
+  return NULL;
+}
+
+const char*  //
+do_test_wuffs_jpeg_decode_scaled(wuffs_base__rect_ie_u32* dirty_rect,
+                                 wuffs_base__pixel_buffer* pb,
+                                 wuffs_base__io_buffer* src,
+                                 uint32_t scale_denominator) {
+  wuffs_jpeg__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_jpeg__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  src->meta.ri = 0;
+  CHECK_STATUS("decode_image_config",
+               wuffs_jpeg__decoder__decode_image_config(&dec, NULL, src));
+
+  wuffs_base__slice_u8 workbuf = g_work_slice_u8;
+  workbuf.len = wuffs_jpeg__decoder__workbuf_len(&dec).max_incl;
+  if (workbuf.len > g_work_slice_u8.len) {
+    RETURN_FAIL("workbuf_len is too large");
+  }
+
+  wuffs_base__decode_frame_options opts =
+      wuffs_base__null_decode_frame_options();
+  wuffs_base__decode_frame_options__set_scale_denominator(&opts,
+                                                          scale_denominator);
+  CHECK_STATUS("decode_frame", wuffs_jpeg__decoder__decode_frame(
+                                   &dec, pb, src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                                   workbuf, &opts));
+  *dirty_rect = wuffs_jpeg__decoder__frame_dirty_rect(&dec);
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_scaled() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[5] = {
+      "test/data/bricks-color.jpeg",
+      "test/data/bricks-gray.jpeg",
+      "test/data/mona-lisa.21x32.q90.jpeg",
+      "test/data/peacock.progressive.jpeg",
+      "test/data/peacock.s-weird.jpeg",
+  };
+
+  // Denominators that aren't 1, 2, 4 or 8 round down to one that is.
+  const uint32_t scale_denominators[6] = {0, 2, 3, 4, 8, 100};
+  const uint32_t want_shifts[6] = {0, 1, 1, 2, 3, 3};
+
+  for (int f = 0; f < 5; f++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[f]));
+
+    wuffs_jpeg__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_jpeg__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_jpeg__decoder__decode_image_config(&dec, &ic, &src));
+    uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+    uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+        WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+    size_t n = ((size_t)width) * ((size_t)height) * 4;
+    if ((n > sizeof(g_want_array_u8)) || (n > sizeof(g_have_array_u8))) {
+      RETURN_FAIL("f=%d: image is too large", f);
+    }
+
+    wuffs_base__rect_ie_u32 dirty_rect;
+    wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice",
+                 wuffs_base__pixel_buffer__set_from_slice(
+                     &want_pb, &ic.pixcfg,
+                     wuffs_base__make_slice_u8(g_want_array_u8, n)));
+    CHECK_STRING(
+        do_test_wuffs_jpeg_decode_scaled(&dirty_rect, &want_pb, &src, 1));
+
+    for (int d = 0; d < 6; d++) {
+      memset(g_have_array_u8, 0, n);
+      wuffs_base__pixel_buffer have_pb = ((wuffs_base__pixel_buffer){});
+      CHECK_STATUS("set_from_slice",
+                   wuffs_base__pixel_buffer__set_from_slice(
+                       &have_pb, &ic.pixcfg,
+                       wuffs_base__make_slice_u8(g_have_array_u8, n)));
+      CHECK_STRING(do_test_wuffs_jpeg_decode_scaled(
+          &dirty_rect, &have_pb, &src, scale_denominators[d]));
+
+      uint32_t shift = want_shifts[d];
+      uint32_t scale = ((uint32_t)1) << shift;
+      uint32_t want_w = (width + scale - 1) >> shift;
+      uint32_t want_h = (height + scale - 1) >> shift;
+      if ((dirty_rect.min_incl_x != 0) || (dirty_rect.min_incl_y != 0) ||
+          (dirty_rect.max_excl_x != want_w) ||
+          (dirty_rect.max_excl_y != want_h)) {
+        RETURN_FAIL("f=%d, d=%d: dirty_rect: have (%" PRIu32 ", %" PRIu32
+                    ")-(%" PRIu32 ", %" PRIu32 "), want (0, 0)-(%" PRIu32
+                    ", %" PRIu32 ")",
+                    f, d, dirty_rect.min_incl_x, dirty_rect.min_incl_y,
+                    dirty_rect.max_excl_x, dirty_rect.max_excl_y, want_w,
+                    want_h);
+      }
+
+      if (shift == 0) {
+        if (memcmp(g_have_array_u8, g_want_array_u8, n)) {
+          RETURN_FAIL("f=%d, d=%d: pixels differ", f, d);
+        }
+        continue;
+      }
+
+      // Compare each scaled pixel with the average of the corresponding
+      // (scale × scale) full-size pixels. For grayscale, the two are almost
+      // identical. For color, they differ more (as chroma upsampling and
+      // clamping happen at a different scale) but should still be close, on
+      // average. Pixels outside of the dirty_rect should be
+      // untouched.
+      uint64_t total_diff = 0;
+      for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+          const uint8_t* have = g_have_array_u8 + (4 * ((y * width) + x));
+          if ((x >= want_w) || (y >= want_h)) {
+            if (have[0] | have[1] | have[2] | have[3]) {
+              RETURN_FAIL("f=%d, d=%d: pixel (%" PRIu32 ", %" PRIu32
+                          ") is outside of the dirty_rect but was modified",
+                          f, d, x, y);
+            }
+            continue;
+          }
+          for (uint32_t c = 0; c < 3; c++) {
+            uint32_t sum = 0;
+            uint32_t count = 0;
+            uint32_t y1 = ((y + 1) << shift) < height ? ((y + 1) << shift)
+                                                      : height;
+            uint32_t x1 = ((x + 1) << shift) < width ? ((x + 1) << shift)
+                                                     : width;
+            for (uint32_t yy = y << shift; yy < y1; yy++) {
+              for (uint32_t xx = x << shift; xx < x1; xx++) {
+                sum += g_want_array_u8[(4 * ((yy * width) + xx)) + c];
+                count++;
+              }
+            }
+            int32_t diff = ((int32_t)have[c]) - ((int32_t)(sum / count));
+            total_diff += (uint64_t)((diff >= 0) ? diff : -diff);
+          }
+        }
+      }
+      uint64_t mean_diff = total_diff / (3 * ((uint64_t)want_w) * want_h);
+      if (mean_diff > 12) {
+        RETURN_FAIL("f=%d, d=%d: mean absolute difference: have %" PRIu64
+                    ", want <= 12",
+                    f, d, mean_diff);
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_jpeg_decode_truncated_input() {
   CHECK_FOCUS(__func__);
@@ -165,6 +1211,113 @@ test_wuffs_jpeg_decode_truncated_input() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_jpeg_decode_yield_after_each_scan() {
+  CHECK_FOCUS(__func__);
+
+  // Use the second halves of the src and work buffers, as the first halves
+  // are used by do_test_wuffs_jpeg_decode_region_of_interest.
+  const size_t src_half = g_src_slice_u8.len / 2;
+  const size_t work_half = g_work_slice_u8.len / 2;
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = wuffs_base__make_slice_u8(g_src_slice_u8.ptr + src_half,
+                                        src_half),
+  });
+  CHECK_STRING(read_file(&src, "test/data/peacock.progressive.jpeg"));
+
+  wuffs_base__pixel_config pixcfg = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_config__set(&pixcfg,
+                                WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, 100, 75);
+  const size_t n = 100 * 75 * 4;
+
+  // Mode 0 is the default quality. Mode 2 is lower quality with the shortest
+  // work buffer (see test_wuffs_jpeg_decode_band).
+  for (int mode = 0; mode <= 2; mode += 2) {
+    wuffs_jpeg__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_jpeg__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    if (mode > 0) {
+      CHECK_STATUS("set_quirk",
+                   wuffs_jpeg__decoder__set_quirk(
+                       &dec, WUFFS_BASE__QUIRK_QUALITY,
+                       WUFFS_BASE__QUIRK_QUALITY__VALUE__LOWER_QUALITY));
+    }
+    CHECK_STATUS("set_quirk",
+                 wuffs_jpeg__decoder__set_quirk(
+                     &dec, WUFFS_JPEG__QUIRK_YIELD_AFTER_EACH_SCAN, 1));
+    src.meta.ri = 0;
+    CHECK_STATUS("decode_image_config",
+                 wuffs_jpeg__decoder__decode_image_config(&dec, NULL, &src));
+
+    wuffs_base__slice_u8 workbuf =
+        wuffs_base__make_slice_u8(g_work_slice_u8.ptr + work_half, 0);
+    wuffs_base__range_ii_u64 workbuf_len =
+        wuffs_jpeg__decoder__workbuf_len(&dec);
+    workbuf.len = (mode > 0) ? workbuf_len.min_incl : workbuf_len.max_incl;
+    if (workbuf.len > work_half) {
+      RETURN_FAIL("mode=%d: workbuf_len is too large", mode);
+    }
+
+    memset(g_have_array_u8, 0, n);
+    wuffs_base__pixel_buffer have_pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice",
+                 wuffs_base__pixel_buffer__set_from_slice(
+                     &have_pb, &pixcfg,
+                     wuffs_base__make_slice_u8(g_have_array_u8, n)));
+
+    // Each "$scan complete" preview should match decoding a file truncated
+    // after that scan.
+    int num_scans = 0;
+    while (true) {
+      wuffs_base__status status = wuffs_jpeg__decoder__decode_frame(
+          &dec, &have_pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, workbuf, NULL);
+      if (status.repr == NULL) {
+        break;
+      } else if (status.repr != wuffs_jpeg__suspension__scan_complete) {
+        RETURN_FAIL("mode=%d: decode_frame: \"%s\"", mode, status.repr);
+      } else if (num_scans >= 10) {
+        RETURN_FAIL("mode=%d: too many scans", mode);
+      }
+
+      wuffs_base__rect_ie_u32 dirty_rect =
+          wuffs_jpeg__decoder__frame_dirty_rect(&dec);
+      if ((dirty_rect.min_incl_x != 0) || (dirty_rect.min_incl_y != 0) ||
+          (dirty_rect.max_excl_x != 100) || (dirty_rect.max_excl_y != 75)) {
+        RETURN_FAIL("mode=%d, scan=%d: bad dirty_rect", mode, num_scans);
+      }
+
+      char filename[64];
+      snprintf(filename, sizeof filename,
+               "test/data/peacock.progressive.scan%03d.jpeg", num_scans);
+      wuffs_base__io_buffer want_src = ((wuffs_base__io_buffer){
+          .data = wuffs_base__make_slice_u8(g_src_slice_u8.ptr, src_half),
+      });
+      CHECK_STRING(read_file(&want_src, filename));
+      memset(g_want_array_u8, 0, n);
+      wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+      CHECK_STATUS("set_from_slice",
+                   wuffs_base__pixel_buffer__set_from_slice(
+                       &want_pb, &pixcfg,
+                       wuffs_base__make_slice_u8(g_want_array_u8, n)));
+      CHECK_STRING(do_test_wuffs_jpeg_decode_region_of_interest(
+          &dirty_rect, &want_pb, &want_src, mode, 1,
+          wuffs_base__empty_rect_ie_u32()));
+      if (memcmp(g_have_array_u8, g_want_array_u8, n)) {
+        RETURN_FAIL("mode=%d, scan=%d: pixels differ", mode, num_scans);
+      }
+      num_scans++;
+    }
+
+    if (num_scans != 10) {
+      RETURN_FAIL("mode=%d: num_scans: have %d, want 10", mode, num_scans);
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 do_test_wuffs_jpeg_decode_dht(wuffs_base__io_buffer* src,
                               const uint32_t arg_bits,
@@ -612,7 +1765,7 @@ test_wuffs_jpeg_decode_idct() {
       0x4C, 0x4C, 0x52, 0x4F, 0x4D, 0x40, 0x3A, 0x35,  //
   };
 
-  for (int f = 0; f < 2; f++) {
+  for (int f = 0; f < 3; f++) {
     wuffs_jpeg__decoder dec;
     CHECK_STATUS("initialize", wuffs_jpeg__decoder__initialize(
                                    &dec, sizeof dec, WUFFS_VERSION,
@@ -633,9 +1786,14 @@ test_wuffs_jpeg_decode_idct() {
       func_name = "choosy_default";
       func = &wuffs_jpeg__decoder__decode_idct__choosy_default;
 #if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
-    } else if (wuffs_base__cpu_arch__have_x86_avx2()) {
+    } else if ((f == 1) && wuffs_base__cpu_arch__have_x86_avx2()) {
       func_name = "x86_avx2";
       func = &wuffs_jpeg__decoder__decode_idct_x86_avx2;
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON_A64)
+    } else if ((f == 2) && wuffs_base__cpu_arch__have_arm_neon()) {
+      func_name = "arm_neon";
+      func = &wuffs_jpeg__decoder__decode_idct_arm_neon;
 #endif
     }
 
@@ -886,6 +2044,28 @@ bench_wuffs_jpeg_decode_19k_8bpp() {
       "test/data/bricks-gray.jpeg", 0, SIZE_MAX, 100);
 }
 
+const char*  //
+bench_wuffs_jpeg_decode_30k_24bpp_coefficients_progressive() {
+  CHECK_FOCUS(__func__);
+  uint32_t quirks[] = {WUFFS_JPEG__QUIRK_DECODE_COEFFICIENTS};
+  return do_bench_image_decode(
+      &wuffs_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      quirks, 1, "test/data/peacock.progressive.jpeg", 0, SIZE_MAX, 50);
+}
+
+const char*  //
+bench_wuffs_jpeg_decode_30k_24bpp_coefficients_sequential() {
+  CHECK_FOCUS(__func__);
+  uint32_t quirks[] = {WUFFS_JPEG__QUIRK_DECODE_COEFFICIENTS};
+  return do_bench_image_decode(
+      &wuffs_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      quirks, 1, "test/data/peacock.default.jpeg", 0, SIZE_MAX, 50);
+}
+
 const char*  //
 bench_wuffs_jpeg_decode_30k_24bpp_progressive() {
   CHECK_FOCUS(__func__);
@@ -906,6 +2086,66 @@ bench_wuffs_jpeg_decode_30k_24bpp_sequential() {
       NULL, 0, "test/data/peacock.default.jpeg", 0, SIZE_MAX, 50);
 }
 
+const char*  //
+bench_wuffs_jpeg_decode_30k_24bpp_subsampling_1x3() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/peacock.s1x3.jpeg", 0, SIZE_MAX, 50);
+}
+
+const char*  //
+bench_wuffs_jpeg_decode_30k_24bpp_subsampling_420() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/peacock.s2x2-420.jpeg", 0, SIZE_MAX, 50);
+}
+
+const char*  //
+bench_wuffs_jpeg_decode_30k_24bpp_subsampling_420_lower_quality() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_jpeg_decode_lower_quality,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/peacock.s2x2-420.jpeg", 0, SIZE_MAX, 50);
+}
+
+const char*  //
+bench_wuffs_jpeg_decode_30k_24bpp_subsampling_422() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/peacock.s2x1-422.jpeg", 0, SIZE_MAX, 50);
+}
+
+const char*  //
+bench_wuffs_jpeg_decode_30k_24bpp_subsampling_444() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/peacock.s1x1-444.jpeg", 0, SIZE_MAX, 50);
+}
+
+const char*  //
+bench_wuffs_jpeg_decode_30k_24bpp_subsampling_weird() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/peacock.s-weird.jpeg", 0, SIZE_MAX, 50);
+}
+
 const char*  //
 bench_wuffs_jpeg_decode_77k_24bpp() {
   CHECK_FOCUS(__func__);
@@ -926,6 +2166,27 @@ bench_wuffs_jpeg_decode_552k_24bpp_420() {
       NULL, 0, "test/data/hibiscus.regular.jpeg", 0, SIZE_MAX, 5);
 }
 
+const char*  //
+bench_wuffs_jpeg_decode_552k_24bpp_420_coefficients() {
+  CHECK_FOCUS(__func__);
+  uint32_t quirks[] = {WUFFS_JPEG__QUIRK_DECODE_COEFFICIENTS};
+  return do_bench_image_decode(
+      &wuffs_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      quirks, 1, "test/data/hibiscus.regular.jpeg", 0, SIZE_MAX, 5);
+}
+
+const char*  //
+bench_wuffs_jpeg_decode_552k_24bpp_420_scaled_by_8() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_jpeg_decode_scaled_by_8,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/hibiscus.regular.jpeg", 0, SIZE_MAX, 5);
+}
+
 const char*  //
 bench_wuffs_jpeg_decode_552k_24bpp_444() {
   CHECK_FOCUS(__func__);
@@ -946,6 +2207,16 @@ bench_wuffs_jpeg_decode_4002k_24bpp() {
       NULL, 0, "test/data/harvesters.jpeg", 0, SIZE_MAX, 1);
 }
 
+const char*  //
+bench_wuffs_jpeg_decode_4002k_24bpp_top_left_tile() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_jpeg_decode_top_left_tile,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/harvesters.jpeg", 0, SIZE_MAX, 1);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -960,6 +2231,28 @@ bench_mimic_jpeg_decode_19k_8bpp() {
       "test/data/bricks-gray.jpeg", 0, SIZE_MAX, 100);
 }
 
+const char*  //
+bench_mimic_jpeg_decode_30k_24bpp_coefficients_progressive() {
+  CHECK_FOCUS(__func__);
+  uint32_t quirks[] = {WUFFS_JPEG__QUIRK_DECODE_COEFFICIENTS};
+  return do_bench_image_decode(
+      &mimic_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      quirks, 1, "test/data/peacock.progressive.jpeg", 0, SIZE_MAX, 50);
+}
+
+const char*  //
+bench_mimic_jpeg_decode_30k_24bpp_coefficients_sequential() {
+  CHECK_FOCUS(__func__);
+  uint32_t quirks[] = {WUFFS_JPEG__QUIRK_DECODE_COEFFICIENTS};
+  return do_bench_image_decode(
+      &mimic_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      quirks, 1, "test/data/peacock.default.jpeg", 0, SIZE_MAX, 50);
+}
+
 const char*  //
 bench_mimic_jpeg_decode_30k_24bpp_progressive() {
   CHECK_FOCUS(__func__);
@@ -980,6 +2273,56 @@ bench_mimic_jpeg_decode_30k_24bpp_sequential() {
       NULL, 0, "test/data/peacock.default.jpeg", 0, SIZE_MAX, 50);
 }
 
+const char*  //
+bench_mimic_jpeg_decode_30k_24bpp_subsampling_1x3() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &mimic_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/peacock.s1x3.jpeg", 0, SIZE_MAX, 50);
+}
+
+const char*  //
+bench_mimic_jpeg_decode_30k_24bpp_subsampling_420() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &mimic_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/peacock.s2x2-420.jpeg", 0, SIZE_MAX, 50);
+}
+
+const char*  //
+bench_mimic_jpeg_decode_30k_24bpp_subsampling_422() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &mimic_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/peacock.s2x1-422.jpeg", 0, SIZE_MAX, 50);
+}
+
+const char*  //
+bench_mimic_jpeg_decode_30k_24bpp_subsampling_444() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &mimic_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/peacock.s1x1-444.jpeg", 0, SIZE_MAX, 50);
+}
+
+const char*  //
+bench_mimic_jpeg_decode_30k_24bpp_subsampling_weird() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &mimic_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/peacock.s-weird.jpeg", 0, SIZE_MAX, 50);
+}
+
 const char*  //
 bench_mimic_jpeg_decode_77k_24bpp() {
   CHECK_FOCUS(__func__);
@@ -1000,6 +2343,17 @@ bench_mimic_jpeg_decode_552k_24bpp_420() {
       NULL, 0, "test/data/hibiscus.regular.jpeg", 0, SIZE_MAX, 5);
 }
 
+const char*  //
+bench_mimic_jpeg_decode_552k_24bpp_420_coefficients() {
+  CHECK_FOCUS(__func__);
+  uint32_t quirks[] = {WUFFS_JPEG__QUIRK_DECODE_COEFFICIENTS};
+  return do_bench_image_decode(
+      &mimic_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      quirks, 1, "test/data/hibiscus.regular.jpeg", 0, SIZE_MAX, 5);
+}
+
 const char*  //
 bench_mimic_jpeg_decode_552k_24bpp_444() {
   CHECK_FOCUS(__func__);
@@ -1026,13 +2380,19 @@ bench_mimic_jpeg_decode_4002k_24bpp() {
 
 proc g_tests[] = {
 
+    test_wuffs_jpeg_decode_band,
+    test_wuffs_jpeg_decode_coefficients,
     test_wuffs_jpeg_decode_dht_easy,
     test_wuffs_jpeg_decode_dht_hard,
     test_wuffs_jpeg_decode_idct,
     test_wuffs_jpeg_decode_mcu,
     test_wuffs_jpeg_decode_interface,
     test_wuffs_jpeg_decode_lower_quality,
+    test_wuffs_jpeg_decode_planar,
+    test_wuffs_jpeg_decode_region_of_interest,
+    test_wuffs_jpeg_decode_scaled,
     test_wuffs_jpeg_decode_truncated_input,
+    test_wuffs_jpeg_decode_yield_after_each_scan,
 
 #ifdef WUFFS_MIMIC
 
@@ -1050,20 +2410,39 @@ proc g_tests[] = {
 proc g_benches[] = {
 
     bench_wuffs_jpeg_decode_19k_8bpp,
+    bench_wuffs_jpeg_decode_30k_24bpp_coefficients_progressive,
+    bench_wuffs_jpeg_decode_30k_24bpp_coefficients_sequential,
     bench_wuffs_jpeg_decode_30k_24bpp_progressive,
     bench_wuffs_jpeg_decode_30k_24bpp_sequential,
+    bench_wuffs_jpeg_decode_30k_24bpp_subsampling_1x3,
+    bench_wuffs_jpeg_decode_30k_24bpp_subsampling_420,
+    bench_wuffs_jpeg_decode_30k_24bpp_subsampling_420_lower_quality,
+    bench_wuffs_jpeg_decode_30k_24bpp_subsampling_422,
+    bench_wuffs_jpeg_decode_30k_24bpp_subsampling_444,
+    bench_wuffs_jpeg_decode_30k_24bpp_subsampling_weird,
     bench_wuffs_jpeg_decode_77k_24bpp,
     bench_wuffs_jpeg_decode_552k_24bpp_420,
+    bench_wuffs_jpeg_decode_552k_24bpp_420_coefficients,
+    bench_wuffs_jpeg_decode_552k_24bpp_420_scaled_by_8,
     bench_wuffs_jpeg_decode_552k_24bpp_444,
     bench_wuffs_jpeg_decode_4002k_24bpp,
+    bench_wuffs_jpeg_decode_4002k_24bpp_top_left_tile,
 
 #ifdef WUFFS_MIMIC
 
     bench_mimic_jpeg_decode_19k_8bpp,
+    bench_mimic_jpeg_decode_30k_24bpp_coefficients_progressive,
+    bench_mimic_jpeg_decode_30k_24bpp_coefficients_sequential,
     bench_mimic_jpeg_decode_30k_24bpp_progressive,
     bench_mimic_jpeg_decode_30k_24bpp_sequential,
+    bench_mimic_jpeg_decode_30k_24bpp_subsampling_1x3,
+    bench_mimic_jpeg_decode_30k_24bpp_subsampling_420,
+    bench_mimic_jpeg_decode_30k_24bpp_subsampling_422,
+    bench_mimic_jpeg_decode_30k_24bpp_subsampling_444,
+    bench_mimic_jpeg_decode_30k_24bpp_subsampling_weird,
     bench_mimic_jpeg_decode_77k_24bpp,
     bench_mimic_jpeg_decode_552k_24bpp_420,
+    bench_mimic_jpeg_decode_552k_24bpp_420_coefficients,
     bench_mimic_jpeg_decode_552k_24bpp_444,
     bench_mimic_jpeg_decode_4002k_24bpp,
 
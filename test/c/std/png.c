@@ -90,6 +90,97 @@ wuffs_png_decode(uint64_t* n_bytes_out,
       n_bytes_out, dst, pixfmt, quirks_ptr, quirks_len, src);
 }
 
+// wuffs_png_decode_top_left_tile is like wuffs_png_decode but it only decodes
+// the top-left 256×256 pixels, like a tile server would. It still counts the
+// full-size image's pixels, so that its benchmark numbers are comparable to
+// wuffs_png_decode's.
+const char*  //
+wuffs_png_decode_top_left_tile(uint64_t* n_bytes_out,
+                               wuffs_base__io_buffer* dst,
+                               uint32_t wuffs_initialize_flags,
+                               wuffs_base__pixel_format pixfmt,
+                               uint32_t* quirks_ptr,
+                               size_t quirks_len,
+                               wuffs_base__io_buffer* src) {
+  wuffs_png__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
+                                              wuffs_initialize_flags));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_png__decoder__decode_image_config(&dec, &ic, src));
+  uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+  wuffs_base__pixel_config__set(&ic.pixcfg, pixfmt.repr,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width,
+                                height);
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &ic.pixcfg, g_pixel_slice_u8));
+
+  wuffs_base__decode_frame_options opts =
+      wuffs_base__null_decode_frame_options();
+  wuffs_base__decode_frame_options__set_region_of_interest(
+      &opts, wuffs_base__make_rect_ie_u32(0, 0, 256, 256));
+  CHECK_STATUS("decode_frame", wuffs_png__decoder__decode_frame(
+                                   &dec, &pb, src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                                   g_work_slice_u8, &opts));
+  if (n_bytes_out) {
+    *n_bytes_out += ((uint64_t)width) * ((uint64_t)height) *
+                    (wuffs_base__pixel_format__bits_per_pixel(&pixfmt) / 8);
+  }
+  return NULL;
+}
+
+// wuffs_png_decode_stream_rows is like wuffs_png_decode but it uses
+// QUIRK_STREAM_ROWS with a 1-row pixel buffer and the minimum work buffer,
+// like a low-memory image scaler would.
+const char*  //
+wuffs_png_decode_stream_rows(uint64_t* n_bytes_out,
+                             wuffs_base__io_buffer* dst,
+                             uint32_t wuffs_initialize_flags,
+                             wuffs_base__pixel_format pixfmt,
+                             uint32_t* quirks_ptr,
+                             size_t quirks_len,
+                             wuffs_base__io_buffer* src) {
+  wuffs_png__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
+                                              wuffs_initialize_flags));
+  CHECK_STATUS("set_quirk",
+               wuffs_png__decoder__set_quirk(
+                   &dec, WUFFS_PNG__QUIRK_STREAM_ROWS, 1));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_png__decoder__decode_image_config(&dec, &ic, src));
+  uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+  wuffs_base__pixel_config__set(&ic.pixcfg, pixfmt.repr,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, 1);
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &ic.pixcfg, g_pixel_slice_u8));
+
+  uint64_t workbuf_len = wuffs_png__decoder__workbuf_len(&dec).min_incl;
+  if (workbuf_len > g_work_slice_u8.len) {
+    return "workbuf_len is too large";
+  }
+  while (true) {
+    wuffs_base__status status = wuffs_png__decoder__decode_frame(
+        &dec, &pb, src, WUFFS_BASE__PIXEL_BLEND__SRC,
+        wuffs_base__make_slice_u8(g_work_slice_u8.ptr, workbuf_len), NULL);
+    if (status.repr != wuffs_png__suspension__streamed_rows_available) {
+      CHECK_STATUS("decode_frame", status);
+      break;
+    }
+  }
+  if (n_bytes_out) {
+    *n_bytes_out += ((uint64_t)width) * ((uint64_t)height) *
+                    (wuffs_base__pixel_format__bits_per_pixel(&pixfmt) / 8);
+  }
+  return NULL;
+}
+
 const char*  //
 do_test_xxxxx_png_decode_bad_crc32_checksum_critical(
     const char* (*decode_func)(uint64_t* n_bytes_out,
@@ -148,6 +239,8 @@ do_wuffs_png_swizzle(uint32_t width,
   dec.private_impl.f_frame_rect_y0 = 0;
   dec.private_impl.f_frame_rect_x1 = width;
   dec.private_impl.f_frame_rect_y1 = height;
+  dec.private_impl.f_roi_y0 = 0;
+  dec.private_impl.f_roi_y1 = height;
   dec.private_impl.f_width = width;
   dec.private_impl.f_height = height;
   dec.private_impl.f_pass_bytes_per_row = width;
@@ -171,7 +264,9 @@ do_wuffs_png_swizzle(uint32_t width,
   CHECK_STATUS("set_from_slice",
                wuffs_base__pixel_buffer__set_from_slice(&pb, &pc, dst));
   CHECK_STATUS("filter_and_swizzle",
-               wuffs_png__decoder__filter_and_swizzle(&dec, &pb, workbuf));
+               wuffs_png__decoder__filter_and_swizzle(
+                   &dec, &pb, workbuf, wuffs_base__empty_slice_u8(), 0,
+                   height));
   return NULL;
 }
 
@@ -190,6 +285,189 @@ test_wuffs_png_decode_interface() {
       "test/data/bricks-gray.png", 0, SIZE_MAX, 160, 120, 0xFF060606);
 }
 
+const char*  //
+do_test_wuffs_png_decode_stream_rows(const char** final_status,
+                                     uint32_t* num_rows,
+                                     wuffs_base__range_ii_u64* workbuf_range,
+                                     wuffs_base__pixel_config* want_pixcfg,
+                                     uint32_t ring_height,
+                                     size_t workbuf_len,
+                                     wuffs_base__io_buffer* src) {
+  wuffs_png__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  CHECK_STATUS("set_quirk",
+               wuffs_png__decoder__set_quirk(
+                   &dec, WUFFS_PNG__QUIRK_STREAM_ROWS, 1));
+  src->meta.ri = 0;
+  CHECK_STATUS("decode_image_config",
+               wuffs_png__decoder__decode_image_config(&dec, NULL, src));
+
+  uint32_t width = wuffs_base__pixel_config__width(want_pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(want_pixcfg);
+  uint64_t bytes_per_row = ((uint64_t)width) * 4;
+  *workbuf_range = wuffs_png__decoder__workbuf_len(&dec);
+  if (workbuf_len < workbuf_range->min_incl) {
+    workbuf_len = workbuf_range->min_incl;
+  }
+  if (workbuf_len > g_work_slice_u8.len) {
+    RETURN_FAIL("workbuf_len: have %zu, min_incl %" PRIu64, workbuf_len,
+                workbuf_range->min_incl);
+  }
+
+  wuffs_base__pixel_config pc = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_config__set(&pc, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width,
+                                ring_height);
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &pb, &pc,
+                   wuffs_base__make_slice_u8(g_have_array_u8,
+                                             bytes_per_row * ring_height)));
+
+  // Check each reported row against the (non-streamed) want pixels.
+  *num_rows = 0;
+  uint32_t y = 0;
+  while (true) {
+    wuffs_base__status status = wuffs_png__decoder__decode_frame(
+        &dec, &pb, src, WUFFS_BASE__PIXEL_BLEND__SRC,
+        wuffs_base__make_slice_u8(g_work_slice_u8.ptr, workbuf_len), NULL);
+    if ((status.repr != NULL) &&
+        (status.repr != wuffs_png__suspension__streamed_rows_available)) {
+      *final_status = status.repr;
+      break;
+    }
+    wuffs_base__range_ie_u32 rows = wuffs_png__decoder__streamed_rows(&dec);
+    if ((rows.min_incl != y) || (rows.max_excl < rows.min_incl) ||
+        ((rows.max_excl - rows.min_incl) > ring_height) ||
+        (rows.max_excl > height)) {
+      RETURN_FAIL("streamed_rows: have [%" PRIu32 ", %" PRIu32
+                  "), ring_height %" PRIu32,
+                  rows.min_incl, rows.max_excl, ring_height);
+    }
+    for (; y < rows.max_excl; y++) {
+      if (memcmp(g_have_array_u8 + (bytes_per_row * (y % ring_height)),
+                 g_want_array_u8 + (bytes_per_row * y), bytes_per_row)) {
+        RETURN_FAIL("row %" PRIu32 " differs", y);
+      }
+    }
+    *num_rows = y;
+    if (status.repr == NULL) {
+      *final_status = NULL;
+      break;
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_png_decode_stream_rows() {
+  CHECK_FOCUS(__func__);
+
+  // The files cover the filter_and_swizzle_default and _tricky
+  // implementations, multiple IDAT chunks, interlacing (which can't be
+  // streamed), APNG and truncated input.
+  const char* filenames[6] = {
+      "test/data/bricks-color.png",                   //
+      "test/data/hibiscus.primitive.png",             //
+      "test/data/hippopotamus.interlaced.png",        //
+      "test/data/hippopotamus.regular.truncated.png",  //
+      "test/data/muybridge.apng",                     //
+      "test/data/pjw-thumbnail.png",
+  };
+
+  for (int f = 0; f < 6; f++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[f]));
+
+    wuffs_png__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_png__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_png__decoder__decode_image_config(&dec, &ic, &src));
+    uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+    uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+        WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+    size_t n = ((size_t)width) * ((size_t)height) * 4;
+    if ((n > sizeof(g_want_array_u8)) || (n > sizeof(g_have_array_u8))) {
+      RETURN_FAIL("f=%d: image is too large", f);
+    }
+
+    memset(g_want_array_u8, 0, n);
+    wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice",
+                 wuffs_base__pixel_buffer__set_from_slice(
+                     &want_pb, &ic.pixcfg,
+                     wuffs_base__make_slice_u8(g_want_array_u8, n)));
+    wuffs_base__status want_status = wuffs_png__decoder__decode_frame(
+        &dec, &want_pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, g_work_slice_u8,
+        NULL);
+    if (!strstr(filenames[f], ".interlaced.") &&
+        !strstr(filenames[f], ".truncated.")) {
+      CHECK_STATUS("decode_frame", want_status);
+    }
+
+    // Stream with a 1-row pixel buffer and the minimum work buffer, then with
+    // a 3-row pixel buffer and a work buffer holding 7 rows (so that the two
+    // work buffer halves hold 3 rows each) and finally with a whole-frame
+    // pixel buffer and a whole-frame work buffer.
+    const struct {
+      uint32_t ring_height;
+      size_t workbuf_len;
+    } configs[3] = {
+        {1, 0},
+        {3, 7 * (1 + (((size_t)width) * 4))},
+        {height, n + height},
+    };
+    for (int c = 0; c < 3; c++) {
+      const char* have_final_status = NULL;
+      uint32_t have_num_rows = 0;
+      wuffs_base__range_ii_u64 have_workbuf_range =
+          ((wuffs_base__range_ii_u64){});
+      size_t workbuf_len = configs[c].workbuf_len;
+      // Some of the files have fewer than 4 bytes per pixel, so the 7-row
+      // and whole-frame lengths are just generous. A zero length (or any
+      // length below workbuf_len's min_incl) means that min_incl.
+      if (workbuf_len > g_work_slice_u8.len) {
+        workbuf_len = g_work_slice_u8.len;
+      }
+      CHECK_STRING(do_test_wuffs_png_decode_stream_rows(
+          &have_final_status, &have_num_rows, &have_workbuf_range, &ic.pixcfg,
+          configs[c].ring_height, workbuf_len, &src));
+
+      if (strstr(filenames[f], ".interlaced.")) {
+        if (have_final_status !=
+            wuffs_png__error__unsupported_interlaced_row_streaming) {
+          RETURN_FAIL("f=%d, c=%d: final status: have \"%s\"", f, c,
+                      have_final_status);
+        }
+      } else if (have_final_status != want_status.repr) {
+        RETURN_FAIL("f=%d, c=%d: final status: have \"%s\", want \"%s\"", f,
+                    c, have_final_status, want_status.repr);
+      } else if (have_workbuf_range.min_incl >= have_workbuf_range.max_incl) {
+        RETURN_FAIL("f=%d, c=%d: workbuf_len: min_incl %" PRIu64
+                    " >= max_incl %" PRIu64,
+                    f, c, have_workbuf_range.min_incl,
+                    have_workbuf_range.max_incl);
+      } else if ((have_final_status == NULL) && (have_num_rows != height)) {
+        RETURN_FAIL("f=%d, c=%d: num_rows: have %" PRIu32 ", want %" PRIu32, f,
+                    c, have_num_rows, height);
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_png_decode_truncated_input() {
   CHECK_FOCUS(__func__);
@@ -238,6 +516,152 @@ test_wuffs_png_decode_bad_crc32_checksum_critical() {
       &wuffs_png_decode);
 }
 
+const char*  //
+do_test_wuffs_png_decode_defer_filter_and_swizzle(uint32_t* num_suspensions,
+                                                  const char** final_status,
+                                                  wuffs_base__pixel_buffer* pb,
+                                                  wuffs_base__io_buffer* src,
+                                                  bool defer) {
+  // Decode the first frame. When deferring, the filter_and_swizzle_rows calls
+  // are made on a second decoder, dec[1], so that they still work after dec[0]
+  // has failed (e.g. on truncated input). Before dec[0] starts, dec[1] runs
+  // decode_frame up to its first "$filtered rows available" suspension.
+  wuffs_png__decoder dec[2];
+  for (int i = defer ? 1 : 0; i >= 0; i--) {
+    CHECK_STATUS("initialize",
+                 wuffs_png__decoder__initialize(
+                     &dec[i], sizeof dec[i], WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STATUS("set_quirk", wuffs_png__decoder__set_quirk(
+                                  &dec[i],
+                                  WUFFS_PNG__QUIRK_DEFER_FILTER_AND_SWIZZLE,
+                                  defer));
+    src->meta.ri = 0;
+    CHECK_STATUS("decode_image_config",
+                 wuffs_png__decoder__decode_image_config(&dec[i], NULL, src));
+    CHECK_STATUS("decode_frame_config",
+                 wuffs_png__decoder__decode_frame_config(&dec[i], NULL, src));
+    if (i == 1) {
+      wuffs_base__status status = wuffs_png__decoder__decode_frame(
+          &dec[1], pb, src, WUFFS_BASE__PIXEL_BLEND__SRC, g_work_slice_u8,
+          NULL);
+      // Interlaced frames ignore the quirk, so decode_frame runs to
+      // completion.
+      if ((status.repr != NULL) &&
+          (status.repr != wuffs_png__suspension__filtered_rows_available)) {
+        RETURN_FAIL("decode_frame (dec[1]): \"%s\"", status.repr);
+      }
+    }
+  }
+
+  *num_suspensions = 0;
+  uint32_t y = 0;
+  while (true) {
+    wuffs_base__status status = wuffs_png__decoder__decode_frame(
+        &dec[0], pb, src, WUFFS_BASE__PIXEL_BLEND__SRC, g_work_slice_u8, NULL);
+    if (status.repr == wuffs_png__suspension__filtered_rows_available) {
+      (*num_suspensions)++;
+    }
+    uint32_t n = wuffs_png__decoder__num_deferred_rows(&dec[0]);
+    if (!defer && (n != 0)) {
+      RETURN_FAIL("num_deferred_rows: have %" PRIu32 ", want 0", n);
+    } else if (n < y) {
+      RETURN_FAIL("num_deferred_rows: have %" PRIu32 ", want >= %" PRIu32, n,
+                  y);
+    } else if (n > y) {
+      CHECK_STATUS("filter_and_swizzle_rows",
+                   wuffs_png__decoder__filter_and_swizzle_rows(
+                       &dec[1], pb, g_work_slice_u8, y, n));
+      y = n;
+    }
+    if (status.repr != wuffs_png__suspension__filtered_rows_available) {
+      *final_status = status.repr;
+      break;
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_png_decode_defer_filter_and_swizzle() {
+  CHECK_FOCUS(__func__);
+
+  // The files cover the filter_and_swizzle_default and _tricky
+  // implementations, multiple IDAT chunks, more than 64 KiB of filtered
+  // rows, interlacing (which ignores the quirk), APNG and truncated input.
+  const char* filenames[6] = {
+      "test/data/bricks-color.png",                   //
+      "test/data/hibiscus.primitive.png",             //
+      "test/data/hippopotamus.interlaced.png",        //
+      "test/data/hippopotamus.regular.truncated.png",  //
+      "test/data/muybridge.apng",                     //
+      "test/data/pjw-thumbnail.png",
+  };
+  const uint32_t want_min_num_suspensions[6] = {1, 9, 0, 1, 1, 1};
+
+  for (int f = 0; f < 6; f++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[f]));
+
+    wuffs_png__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_png__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_png__decoder__decode_image_config(&dec, &ic, &src));
+    uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+    uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+        WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+    size_t n = ((size_t)width) * ((size_t)height) * 4;
+    if ((n > sizeof(g_want_array_u8)) || (n > sizeof(g_have_array_u8))) {
+      RETURN_FAIL("f=%d: image is too large", f);
+    }
+
+    uint32_t want_num_suspensions = 0;
+    const char* want_final_status = NULL;
+    memset(g_want_array_u8, 0, n);
+    wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice",
+                 wuffs_base__pixel_buffer__set_from_slice(
+                     &want_pb, &ic.pixcfg,
+                     wuffs_base__make_slice_u8(g_want_array_u8, n)));
+    CHECK_STRING(do_test_wuffs_png_decode_defer_filter_and_swizzle(
+        &want_num_suspensions, &want_final_status, &want_pb, &src, false));
+
+    uint32_t have_num_suspensions = 0;
+    const char* have_final_status = NULL;
+    memset(g_have_array_u8, 0, n);
+    wuffs_base__pixel_buffer have_pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice",
+                 wuffs_base__pixel_buffer__set_from_slice(
+                     &have_pb, &ic.pixcfg,
+                     wuffs_base__make_slice_u8(g_have_array_u8, n)));
+    CHECK_STRING(do_test_wuffs_png_decode_defer_filter_and_swizzle(
+        &have_num_suspensions, &have_final_status, &have_pb, &src, true));
+
+    if (want_num_suspensions != 0) {
+      RETURN_FAIL("f=%d: num_suspensions (without the quirk): have %" PRIu32
+                  ", want 0",
+                  f, want_num_suspensions);
+    } else if (have_num_suspensions < want_min_num_suspensions[f]) {
+      RETURN_FAIL("f=%d: num_suspensions: have %" PRIu32 ", want >= %" PRIu32,
+                  f, have_num_suspensions, want_min_num_suspensions[f]);
+    } else if (have_final_status != want_final_status) {
+      RETURN_FAIL("f=%d: final status: have \"%s\", want \"%s\"", f,
+                  have_final_status, want_final_status);
+    } else if (memcmp(g_have_array_u8, g_want_array_u8, n)) {
+      RETURN_FAIL("f=%d: pixels differ", f);
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_png_decode_filters_golden() {
   CHECK_FOCUS(__func__);
@@ -914,6 +1338,163 @@ test_wuffs_png_decode_metadata_kvp() {
   return NULL;
 }
 
+const char*  //
+do_test_wuffs_png_decode_region_of_interest(uint32_t* num_frames,
+                                            uint64_t* final_rpos,
+                                            wuffs_base__pixel_buffer* pb,
+                                            wuffs_base__io_buffer* src,
+                                            wuffs_base__rect_ie_u32 roi) {
+  wuffs_png__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  src->meta.ri = 0;
+  CHECK_STATUS("decode_image_config",
+               wuffs_png__decoder__decode_image_config(&dec, NULL, src));
+
+  wuffs_base__decode_frame_options opts =
+      wuffs_base__null_decode_frame_options();
+  wuffs_base__decode_frame_options__set_region_of_interest(&opts, roi);
+
+  for (*num_frames = 0;; (*num_frames)++) {
+    wuffs_base__frame_config fc = ((wuffs_base__frame_config){});
+    wuffs_base__status status =
+        wuffs_png__decoder__decode_frame_config(&dec, &fc, src);
+    if (status.repr == wuffs_base__note__end_of_data) {
+      break;
+    } else if (!wuffs_base__status__is_ok(&status)) {
+      RETURN_FAIL("decode_frame_config #%" PRIu32 ": %s", *num_frames,
+                  status.repr);
+    }
+    CHECK_STATUS("decode_frame",
+                 wuffs_png__decoder__decode_frame(
+                     &dec, pb, src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                     g_work_slice_u8, &opts));
+
+    // The dirty_rect should be within the frame and cover the ROI's rows.
+    wuffs_base__rect_ie_u32 frame = wuffs_base__frame_config__bounds(&fc);
+    wuffs_base__rect_ie_u32 dirty_rect =
+        wuffs_png__decoder__frame_dirty_rect(&dec);
+    wuffs_base__rect_ie_u32 want_rect = frame;
+    if (!wuffs_base__rect_ie_u32__is_empty(&roi)) {
+      want_rect.min_incl_y = wuffs_base__u32__max(frame.min_incl_y,  //
+                                                  roi.min_incl_y);
+      want_rect.max_excl_y = wuffs_base__u32__min(frame.max_excl_y,  //
+                                                  roi.max_excl_y);
+    }
+    if (!wuffs_base__rect_ie_u32__contains_rect(&frame, dirty_rect) ||
+        ((want_rect.min_incl_y < want_rect.max_excl_y) &&
+         !wuffs_base__rect_ie_u32__contains_rect(&dirty_rect, want_rect))) {
+      RETURN_FAIL("frame #%" PRIu32 ": dirty_rect: have (%" PRIu32 ", %" PRIu32
+                  ")-(%" PRIu32 ", %" PRIu32 ")",
+                  *num_frames, dirty_rect.min_incl_x, dirty_rect.min_incl_y,
+                  dirty_rect.max_excl_x, dirty_rect.max_excl_y);
+    }
+  }
+
+  *final_rpos = wuffs_base__io_buffer__reader_position(src);
+  return NULL;
+}
+
+const char*  //
+test_wuffs_png_decode_region_of_interest() {
+  CHECK_FOCUS(__func__);
+
+  // The files cover the filter_and_swizzle_default and _tricky
+  // implementations, multiple IDAT chunks, interlacing and APNG fdAT chunks.
+  const char* filenames[5] = {
+      "test/data/bricks-color.png",             //
+      "test/data/bricks-gray.png",              //
+      "test/data/hippopotamus.interlaced.png",  //
+      "test/data/muybridge.apng",               //
+      "test/data/pjw-thumbnail.png",
+  };
+
+  const wuffs_base__rect_ie_u32 rois[5] = {
+      {0, 0, 1, 1},       //
+      {17, 9, 61, 50},    //
+      {0, 30, 1000, 40},  //
+      {3, 100, 4, 1000},  //
+      {5000, 5000, 5001, 5001},
+  };
+
+  for (int f = 0; f < 5; f++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[f]));
+
+    wuffs_png__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_png__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_png__decoder__decode_image_config(&dec, &ic, &src));
+    uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+    uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+        WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+    size_t n = ((size_t)width) * ((size_t)height) * 4;
+    if ((n > sizeof(g_want_array_u8)) || (n > sizeof(g_have_array_u8))) {
+      RETURN_FAIL("f=%d: image is too large", f);
+    }
+
+    for (int r = 0; r < 5; r++) {
+      // Decode every frame twice, first without and then with a region of
+      // interest. Both runs should see the same number of frames and consume
+      // the same number of bytes, even if the second run stops inflating
+      // each frame early.
+      uint32_t want_num_frames = 0;
+      uint64_t want_rpos = 0;
+      memset(g_want_array_u8, 0, n);
+      wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+      CHECK_STATUS("set_from_slice",
+                   wuffs_base__pixel_buffer__set_from_slice(
+                       &want_pb, &ic.pixcfg,
+                       wuffs_base__make_slice_u8(g_want_array_u8, n)));
+      CHECK_STRING(do_test_wuffs_png_decode_region_of_interest(
+          &want_num_frames, &want_rpos, &want_pb, &src,
+          wuffs_base__empty_rect_ie_u32()));
+
+      uint32_t have_num_frames = 0;
+      uint64_t have_rpos = 0;
+      memset(g_have_array_u8, 0, n);
+      wuffs_base__pixel_buffer have_pb = ((wuffs_base__pixel_buffer){});
+      CHECK_STATUS("set_from_slice",
+                   wuffs_base__pixel_buffer__set_from_slice(
+                       &have_pb, &ic.pixcfg,
+                       wuffs_base__make_slice_u8(g_have_array_u8, n)));
+      CHECK_STRING(do_test_wuffs_png_decode_region_of_interest(
+          &have_num_frames, &have_rpos, &have_pb, &src, rois[r]));
+
+      if (have_num_frames != want_num_frames) {
+        RETURN_FAIL("f=%d, r=%d: num_frames: have %" PRIu32 ", want %" PRIu32,
+                    f, r, have_num_frames, want_num_frames);
+      } else if (have_rpos != want_rpos) {
+        RETURN_FAIL("f=%d, r=%d: final reader_position: have %" PRIu64
+                    ", want %" PRIu64,
+                    f, r, have_rpos, want_rpos);
+      }
+
+      // Every frame (and hence the final composition) should match, within
+      // the ROI's rows. Like the dirty_rect, whole rows are decoded.
+      uint32_t y0 = wuffs_base__u32__min(rois[r].min_incl_y, height);
+      uint32_t y1 = wuffs_base__u32__min(rois[r].max_excl_y, height);
+      for (uint32_t y = y0; y < y1; y++) {
+        size_t i = 4 * ((size_t)y) * ((size_t)width);
+        if (memcmp(g_have_array_u8 + i, g_want_array_u8 + i, 4 * width)) {
+          RETURN_FAIL("f=%d, r=%d: row %" PRIu32 " differs", f, r, y);
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_png_decode_restart_frame() {
   CHECK_FOCUS(__func__);
@@ -1117,6 +1698,26 @@ bench_wuffs_png_decode_image_4002k_24bpp() {
       NULL, 0, "test/data/harvesters.png", 0, SIZE_MAX, 1);
 }
 
+const char*  //
+bench_wuffs_png_decode_image_4002k_24bpp_top_left_tile() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_png_decode_top_left_tile,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/harvesters.png", 0, SIZE_MAX, 1);
+}
+
+const char*  //
+bench_wuffs_png_decode_image_4002k_24bpp_stream_rows() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_png_decode_stream_rows,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/harvesters.png", 0, SIZE_MAX, 1);
+}
+
 const char*  //
 do_bench_wuffs_png_decode_filter(uint8_t filter,
                                  uint8_t filter_distance,
@@ -1151,6 +1752,8 @@ do_bench_wuffs_png_decode_filter(uint8_t filter,
   dec.private_impl.f_frame_rect_y0 = 0;
   dec.private_impl.f_frame_rect_x1 = width;
   dec.private_impl.f_frame_rect_y1 = height;
+  dec.private_impl.f_roi_y0 = 0;
+  dec.private_impl.f_roi_y1 = height;
   dec.private_impl.f_width = width;
   dec.private_impl.f_height = height;
   dec.private_impl.f_pass_bytes_per_row = bytes_per_row;
@@ -1181,7 +1784,8 @@ do_bench_wuffs_png_decode_filter(uint8_t filter,
     CHECK_STATUS(
         "filter_and_swizzle",
         wuffs_png__decoder__filter_and_swizzle(
-            &dec, &pb, wuffs_base__make_slice_u8(workbuf.data.ptr, n)));
+            &dec, &pb, wuffs_base__make_slice_u8(workbuf.data.ptr, n),
+            wuffs_base__empty_slice_u8(), 0, height));
     n_bytes += n;
   }
   bench_finish(iters, n_bytes);
@@ -1200,6 +1804,18 @@ bench_wuffs_png_decode_filt_1_dist_4() {
   return do_bench_wuffs_png_decode_filter(1, 4, 200);
 }
 
+const char*  //
+bench_wuffs_png_decode_filt_1_dist_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(1, 6, 200);
+}
+
+const char*  //
+bench_wuffs_png_decode_filt_1_dist_8() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(1, 8, 200);
+}
+
 const char*  //
 bench_wuffs_png_decode_filt_2_dist_3() {
   CHECK_FOCUS(__func__);
@@ -1224,6 +1840,18 @@ bench_wuffs_png_decode_filt_3_dist_4() {
   return do_bench_wuffs_png_decode_filter(3, 4, 100);
 }
 
+const char*  //
+bench_wuffs_png_decode_filt_3_dist_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(3, 6, 100);
+}
+
+const char*  //
+bench_wuffs_png_decode_filt_3_dist_8() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(3, 8, 100);
+}
+
 const char*  //
 bench_wuffs_png_decode_filt_4_dist_3() {
   CHECK_FOCUS(__func__);
@@ -1236,6 +1864,18 @@ bench_wuffs_png_decode_filt_4_dist_4() {
   return do_bench_wuffs_png_decode_filter(4, 4, 20);
 }
 
+const char*  //
+bench_wuffs_png_decode_filt_4_dist_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(4, 6, 20);
+}
+
+const char*  //
+bench_wuffs_png_decode_filt_4_dist_8() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(4, 8, 20);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -1302,6 +1942,7 @@ bench_mimic_png_decode_image_4002k_24bpp() {
 proc g_tests[] = {
 
     test_wuffs_png_decode_bad_crc32_checksum_critical,
+    test_wuffs_png_decode_defer_filter_and_swizzle,
     test_wuffs_png_decode_filters_golden,
     test_wuffs_png_decode_filters_round_trip,
     test_wuffs_png_decode_frame_config,
@@ -1311,7 +1952,9 @@ proc g_tests[] = {
     test_wuffs_png_decode_metadata_iccp,
     test_wuffs_png_decode_metadata_kvp,
     test_wuffs_png_decode_multiple_idats,
+    test_wuffs_png_decode_region_of_interest,
     test_wuffs_png_decode_restart_frame,
+    test_wuffs_png_decode_stream_rows,
     test_wuffs_png_decode_truncated_input,
 
 #ifdef WUFFS_MIMIC
@@ -1335,18 +1978,26 @@ proc g_benches[] = {
 
     bench_wuffs_png_decode_filt_1_dist_3,
     bench_wuffs_png_decode_filt_1_dist_4,
+    bench_wuffs_png_decode_filt_1_dist_6,
+    bench_wuffs_png_decode_filt_1_dist_8,
     bench_wuffs_png_decode_filt_2_dist_3,
     bench_wuffs_png_decode_filt_2_dist_4,
     bench_wuffs_png_decode_filt_3_dist_3,
     bench_wuffs_png_decode_filt_3_dist_4,
+    bench_wuffs_png_decode_filt_3_dist_6,
+    bench_wuffs_png_decode_filt_3_dist_8,
     bench_wuffs_png_decode_filt_4_dist_3,
     bench_wuffs_png_decode_filt_4_dist_4,
+    bench_wuffs_png_decode_filt_4_dist_6,
+    bench_wuffs_png_decode_filt_4_dist_8,
     bench_wuffs_png_decode_image_19k_8bpp,
     bench_wuffs_png_decode_image_40k_24bpp,
     bench_wuffs_png_decode_image_77k_8bpp,
     bench_wuffs_png_decode_image_552k_32bpp_ignore_checksum,
     bench_wuffs_png_decode_image_552k_32bpp_verify_checksum,
     bench_wuffs_png_decode_image_4002k_24bpp,
+    bench_wuffs_png_decode_image_4002k_24bpp_top_left_tile,
+    bench_wuffs_png_decode_image_4002k_24bpp_stream_rows,
 
 #ifdef WUFFS_MIMIC
 
@@ -95,6 +95,51 @@ test_wuffs_targa_decode_interface() {
       "test/data/bricks-color.tga", 0, SIZE_MAX, 160, 120, 0xFF022460);
 }
 
+const char*  //
+test_wuffs_targa_decode_region_of_interest() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[3] = {
+      "test/data/bricks-color.tga",     //
+      "test/data/bricks-gray.tga",      //
+      "test/data/bricks-nodither.tga",
+  };
+
+  const wuffs_base__rect_ie_u32 rois[5] = {
+      {0, 0, 1, 1},       //
+      {17, 9, 61, 50},    //
+      {0, 30, 1000, 40},  //
+      {3, 100, 4, 1000},  //
+      {5000, 5000, 5001, 5001},
+  };
+
+  for (int f = 0; f < 3; f++) {
+    for (int r = 0; r < 5; r++) {
+      wuffs_targa__decoder want_dec;
+      CHECK_STATUS("initialize",
+                   wuffs_targa__decoder__initialize(
+                       &want_dec, sizeof want_dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      wuffs_targa__decoder have_dec;
+      CHECK_STATUS("initialize",
+                   wuffs_targa__decoder__initialize(
+                       &have_dec, sizeof have_dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      const char* status =
+          do_test__wuffs_base__image_decoder_region_of_interest(
+              wuffs_targa__decoder__upcast_as__wuffs_base__image_decoder(
+                  &want_dec),
+              wuffs_targa__decoder__upcast_as__wuffs_base__image_decoder(
+                  &have_dec),
+              filenames[f], rois[r]);
+      if (status) {
+        RETURN_FAIL("f=%d, r=%d: %s", f, r, status);
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_targa_decode_truncated_input() {
   CHECK_FOCUS(__func__);
@@ -167,6 +212,7 @@ bench_wuffs_targa_decode_77k_24bpp() {
 proc g_tests[] = {
 
     test_wuffs_targa_decode_interface,
+    test_wuffs_targa_decode_region_of_interest,
     test_wuffs_targa_decode_truncated_input,
 
 #ifdef WUFFS_MIMIC
@@ -25,6 +25,10 @@ done
 
 Each edition should print "PASS", amongst other information, and exit(0).
 
+The decoded pixel checksums do not depend on whether the SIMD code paths are
+used. Add "-DWUFFS_CONFIG__AVOID_CPU_ARCH" to the C compiler flags to check
+the portable code paths against the same checksums.
+
 Add the "wuffs mimic cflags" (everything after the colon below) to the C
 compiler flags (after the .c file) to run the mimic tests.
 
@@ -52,6 +56,7 @@ the first "./a.out" with "./a.out -bench". Combine these changes with the
 // code simply isn't compiled.
 #define WUFFS_CONFIG__MODULES
 #define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__CRC32
 #define WUFFS_CONFIG__MODULE__VP8
 
 // If building this program in an environment that doesn't easily accommodate
@@ -65,7 +70,414 @@ the first "./a.out" with "./a.out -bench". Combine these changes with the
 
 // ---------------- VP8 Tests
 
-// No VP8 tests.
+// read_vp8_chunk reads a simple format (not extended format) lossy WebP file
+// and then narrows dst to that file's "VP8 " chunk payload, which is a raw VP8
+// key frame.
+const char*  //
+read_vp8_chunk(wuffs_base__io_buffer* dst, const char* filename) {
+  CHECK_STRING(read_file(dst, filename));
+  const uint8_t* p = dst->data.ptr + dst->meta.ri;
+  if (((dst->meta.wi - dst->meta.ri) < 20) ||  //
+      (memcmp(p + 0, "RIFF", 4) != 0) ||       //
+      (memcmp(p + 8, "WEBPVP8 ", 8) != 0)) {
+    RETURN_FAIL("read_vp8_chunk(\"%s\"): not a simple lossy WebP file",
+                filename);
+  }
+  size_t n = wuffs_base__peek_u32le__no_bounds_check(p + 16);
+  if (n > (dst->meta.wi - dst->meta.ri - 20)) {
+    RETURN_FAIL("read_vp8_chunk(\"%s\"): chunk is too long", filename);
+  }
+  dst->meta.ri += 20;
+  dst->meta.wi = dst->meta.ri + n;
+  return NULL;
+}
+
+// do_test_wuffs_vp8_decode decodes src to BGRA_NONPREMUL pixels, giving the
+// decoder at most rlimit bytes of src per call (and resuming after each
+// "$short read"), and sets *have_checksum to the CRC-32 of those pixels. The
+// work buffer is exactly workbuf_len().min_incl bytes long. A non-zero
+// frame_length is passed to set_frame_length.
+const char*  //
+do_test_wuffs_vp8_decode(wuffs_vp8__decoder* dec,
+                         uint32_t* have_checksum,
+                         wuffs_base__io_buffer* src,
+                         uint64_t rlimit,
+                         uint64_t frame_length) {
+  CHECK_STATUS("initialize",
+               wuffs_vp8__decoder__initialize(
+                   dec, sizeof *dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  if (frame_length > 0) {
+    wuffs_vp8__decoder__set_frame_length(dec, frame_length);
+  }
+
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  wuffs_base__slice_u8 workbuf = wuffs_base__empty_slice_u8();
+  for (int phase = 0; phase < 2;) {
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+    wuffs_base__status status =
+        (phase == 0)
+            ? wuffs_vp8__decoder__decode_image_config(dec, &ic, &limited_src)
+            : wuffs_vp8__decoder__decode_frame(
+                  dec, &pb, &limited_src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                  workbuf, NULL);
+    src->meta.ri += limited_src.meta.ri;
+
+    if (wuffs_base__status__is_ok(&status)) {
+      if (phase == 0) {
+        uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+        uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+        wuffs_base__pixel_config__set(
+            &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+            WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+        CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                           &pb, &ic.pixcfg, g_pixel_slice_u8));
+        wuffs_base__range_ii_u64 workbuf_len =
+            wuffs_vp8__decoder__workbuf_len(dec);
+        if (workbuf_len.min_incl != workbuf_len.max_incl) {
+          RETURN_FAIL("workbuf_len: min_incl (%" PRIu64
+                      ") != max_incl (%" PRIu64 ")",
+                      workbuf_len.min_incl, workbuf_len.max_incl);
+        } else if (workbuf_len.min_incl > g_work_slice_u8.len) {
+          RETURN_FAIL("workbuf_len: %" PRIu64 " is too large",
+                      workbuf_len.min_incl);
+        }
+        workbuf = wuffs_base__make_slice_u8(g_work_slice_u8.ptr,
+                                            (size_t)workbuf_len.min_incl);
+      }
+      phase++;
+    } else if ((status.repr != wuffs_base__suspension__short_read) ||
+               (limited_src.meta.ri == 0)) {
+      RETURN_FAIL("%s: \"%s\"",
+                  (phase == 0) ? "decode_image_config" : "decode_frame",
+                  status.repr);
+    }
+  }
+
+  wuffs_base__table_u8 tab = wuffs_base__pixel_buffer__plane(&pb, 0);
+  wuffs_crc32__ieee_hasher hasher;
+  CHECK_STATUS("initialize hasher",
+               wuffs_crc32__ieee_hasher__initialize(
+                   &hasher, sizeof hasher, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+  uint32_t checksum = 0;
+  for (size_t y = 0; y < tab.height; y++) {
+    checksum = wuffs_crc32__ieee_hasher__update_u32(
+        &hasher, wuffs_base__make_slice_u8(tab.ptr + (y * tab.stride),
+                                           tab.width));
+  }
+  *have_checksum = checksum;
+  return NULL;
+}
+
+// --------
+
+// g_vp8_golden_checksums are the CRC-32 checksums of the BGRA_NONPREMUL
+// pixels decoded from test/data lossy WebP files. libwebp's WebPDecodeBGRA
+// produces the same pixels.
+const struct {
+  const char* filename;
+  uint32_t checksum;
+} g_vp8_golden_checksums[] = {
+    {"test/data/bricks-color.lossy.webp", 0x66CF1857},
+    {"test/data/bricks-color.partitions-4.lossy.webp", 0xB8C06B15},
+    {"test/data/bricks-gray.lossy.webp", 0x17223BCB},
+    {"test/data/harvesters.lossy.webp", 0x983166D1},
+    {"test/data/hat.lossy.webp", 0x06D38B86},
+    {"test/data/hibiscus.primitive.lossy.webp", 0x65080502},
+    {"test/data/hibiscus.regular.lossy.webp", 0x8C6D0550},
+    {"test/data/hippopotamus.lossy.webp", 0x8E5C4546},
+    {"test/data/hippopotamus.partitions-8.lossy.webp", 0xF6706DB0},
+    {"test/data/pjw-thumbnail.lossy.webp", 0xFA5EDA78},
+};
+
+const char*  //
+test_wuffs_vp8_decode_convert_row() {
+  CHECK_FOCUS(__func__);
+
+  // An odd width exercises the SIMD code paths' tails.
+  const size_t width = 53;
+  uint8_t src_y[53];
+  uint8_t src_u[53];
+  uint8_t src_v[53];
+  uint32_t x = 0x12345678;
+  for (size_t i = 0; i < width; i++) {
+    x = (x * 1664525) + 1013904223;
+    src_y[i] = (uint8_t)(x >> 24);
+    src_u[i] = (uint8_t)(x >> 16);
+    src_v[i] = (uint8_t)(x >> 8);
+  }
+  // Also cover the limited range's clipping extremes.
+  src_y[0] = 0x00;
+  src_u[0] = 0x00;
+  src_v[0] = 0x00;
+  src_y[1] = 0xFF;
+  src_u[1] = 0xFF;
+  src_v[1] = 0xFF;
+
+  uint8_t want_array[4 * 53] = {0};
+
+  for (int f = 0; f < 2; f++) {
+    wuffs_vp8__decoder dec;
+    CHECK_STATUS("initialize", wuffs_vp8__decoder__initialize(
+                                   &dec, sizeof dec, WUFFS_VERSION,
+                                   WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+
+    const char* func_name = NULL;
+    wuffs_base__empty_struct (*func)(
+        wuffs_vp8__decoder * self, wuffs_base__slice_u8 a_dst,
+        wuffs_base__slice_u8 a_src_y, wuffs_base__slice_u8 a_src_u,
+        wuffs_base__slice_u8 a_src_v) = NULL;
+
+    if (f == 0) {
+      func_name = "choosy_default";
+      func = &wuffs_vp8__decoder__convert_row__choosy_default;
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V2)
+    } else if ((f == 1) && wuffs_base__cpu_arch__have_x86_sse42()) {
+      func_name = "x86_sse42";
+      func = &wuffs_vp8__decoder__convert_row_x86_sse42;
+#endif
+    }
+
+    if (!func) {
+      continue;
+    }
+    uint8_t dst_array[4 * 53] = {0};
+    (*func)(&dec, wuffs_base__make_slice_u8(&dst_array[0], 4 * width),
+            wuffs_base__make_slice_u8(&src_y[0], width),
+            wuffs_base__make_slice_u8(&src_u[0], width),
+            wuffs_base__make_slice_u8(&src_v[0], width));
+
+    if (f == 0) {
+      memcpy(want_array, dst_array, sizeof(want_array));
+      continue;
+    }
+
+    wuffs_base__io_buffer have =
+        wuffs_base__ptr_u8__reader(&dst_array[0], 4 * width, true);
+    wuffs_base__io_buffer want =
+        wuffs_base__ptr_u8__reader(&want_array[0], 4 * width, true);
+
+    char prefix[256];
+    snprintf(prefix, 256, "f=%d (%s): ", f, func_name);
+    CHECK_STRING(check_io_buffers_equal(prefix, &have, &want));
+  }
+
+  return NULL;
+}
+
+const char*  //
+test_wuffs_vp8_decode_golden_checksums() {
+  CHECK_FOCUS(__func__);
+
+  for (size_t i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(g_vp8_golden_checksums);
+       i++) {
+    const char* filename = g_vp8_golden_checksums[i].filename;
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_vp8_chunk(&src, filename));
+
+    wuffs_vp8__decoder dec;
+    uint32_t have = 0;
+    CHECK_STRING(do_test_wuffs_vp8_decode(&dec, &have, &src, UINT64_MAX, 0));
+    uint32_t want = g_vp8_golden_checksums[i].checksum;
+    if (have != want) {
+      RETURN_FAIL("%s: have 0x%08" PRIX32 ", want 0x%08" PRIX32, filename,
+                  have, want);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_vp8_decode_interface() {
+  CHECK_FOCUS(__func__);
+
+  // The "VP8 " chunk payload starts 20 bytes into the file and is 3828 bytes
+  // long.
+  wuffs_vp8__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_vp8__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  return do_test__wuffs_base__image_decoder(
+      wuffs_vp8__decoder__upcast_as__wuffs_base__image_decoder(&dec),
+      "test/data/bricks-color.lossy.webp", 20, 20 + 3828, 160, 120,
+      0xFF032665);
+}
+
+const char*  //
+test_wuffs_vp8_decode_multiple_partitions() {
+  CHECK_FOCUS(__func__);
+
+  const struct {
+    const char* filename;
+    uint32_t want_num_partitions;
+    uint32_t want_checksum;
+  } test_cases[] = {
+      {
+          .filename = "test/data/bricks-color.partitions-4.lossy.webp",
+          .want_num_partitions = 4,
+          .want_checksum = 0xB8C06B15,
+      },
+      {
+          // The image is only 2 macroblock rows high, so most of its 8
+          // partitions are empty.
+          .filename = "test/data/hippopotamus.partitions-8.lossy.webp",
+          .want_num_partitions = 8,
+          .want_checksum = 0xF6706DB0,
+      },
+  };
+
+  // The work buffer is only workbuf_len().min_incl bytes long, which must
+  // have room for all but the last token partition, whether or not the
+  // decoder knows the frame length (f == 1 or f == 0).
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    const char* filename = test_cases[tc].filename;
+    uint64_t workbuf_lens[2] = {0};
+    for (int f = 0; f < 2; f++) {
+      wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+          .data = g_src_slice_u8,
+      });
+      CHECK_STRING(read_vp8_chunk(&src, filename));
+      uint64_t frame_length = f ? (src.meta.wi - src.meta.ri) : 0;
+
+      wuffs_vp8__decoder dec;
+      uint32_t have_checksum = 0;
+      CHECK_STRING(do_test_wuffs_vp8_decode(&dec, &have_checksum, &src,
+                                            UINT64_MAX, frame_length));
+      workbuf_lens[f] = wuffs_vp8__decoder__workbuf_len(&dec).min_incl;
+
+      uint32_t have_num_partitions =
+          1u + dec.private_impl.f_num_partitions_minus_one;
+      if (have_num_partitions != test_cases[tc].want_num_partitions) {
+        RETURN_FAIL("%s, f=%d: num_partitions: have %" PRIu32
+                    ", want %" PRIu32,
+                    filename, f, have_num_partitions,
+                    test_cases[tc].want_num_partitions);
+      }
+      if (have_checksum != test_cases[tc].want_checksum) {
+        RETURN_FAIL("%s, f=%d: checksum: have 0x%08" PRIX32
+                    ", want 0x%08" PRIX32,
+                    filename, f, have_checksum, test_cases[tc].want_checksum);
+      }
+    }
+    if (workbuf_lens[1] > workbuf_lens[0]) {
+      RETURN_FAIL("%s: workbuf_len: have %" PRIu64 " with the frame length, "
+                  "more than %" PRIu64 " without",
+                  filename, workbuf_lens[1], workbuf_lens[0]);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_vp8_decode_short_reads() {
+  CHECK_FOCUS(__func__);
+
+  // Feeding the decoder a few bytes at a time makes it suspend (and resume)
+  // in the middle of the first partition, the partition sizes, the other
+  // partitions (if any) and the streamed last partition.
+  const uint64_t rlimits[] = {1, 7, 4096};
+  for (size_t i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(g_vp8_golden_checksums);
+       i++) {
+    const char* filename = g_vp8_golden_checksums[i].filename;
+    if (strstr(filename, "harvesters")) {
+      continue;
+    }
+    for (size_t r = 0; r < WUFFS_TESTLIB_ARRAY_SIZE(rlimits); r++) {
+      wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+          .data = g_src_slice_u8,
+      });
+      CHECK_STRING(read_vp8_chunk(&src, filename));
+
+      wuffs_vp8__decoder dec;
+      uint32_t have = 0;
+      CHECK_STRING(
+          do_test_wuffs_vp8_decode(&dec, &have, &src, rlimits[r], 0));
+      uint32_t want = g_vp8_golden_checksums[i].checksum;
+      if (have != want) {
+        RETURN_FAIL("%s, rlimit=%" PRIu64 ": have 0x%08" PRIX32
+                    ", want 0x%08" PRIX32,
+                    filename, rlimits[r], have, want);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_vp8_decode_truncated_input() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src =
+      wuffs_base__ptr_u8__reader(g_src_array_u8, 0, false);
+  wuffs_vp8__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_vp8__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+  wuffs_base__status status =
+      wuffs_vp8__decoder__decode_image_config(&dec, NULL, &src);
+  if (status.repr != wuffs_base__suspension__short_read) {
+    RETURN_FAIL("closed=false: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__suspension__short_read);
+  }
+
+  src.meta.closed = true;
+  status = wuffs_vp8__decoder__decode_image_config(&dec, NULL, &src);
+  if (status.repr != wuffs_vp8__error__truncated_input) {
+    RETURN_FAIL("closed=true: have \"%s\", want \"%s\"", status.repr,
+                wuffs_vp8__error__truncated_input);
+  }
+
+  // Truncate a complete frame: in its frame tag, in its first partition, in
+  // the partition sizes, in an other token partition and in the last token
+  // partition. That file's 3848 byte VP8 frame has a 10 byte header, a 536
+  // byte first partition, 9 bytes of partition sizes and then token
+  // partitions of 926, 892, 820 and 655 bytes.
+  const char* filename = "test/data/bricks-color.partitions-4.lossy.webp";
+  const size_t lengths[] = {3, 300, 550, 2000, 3500};
+  for (size_t i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(lengths); i++) {
+    src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_vp8_chunk(&src, filename));
+    src.meta.wi = src.meta.ri + lengths[i];
+    src.meta.closed = true;
+
+    uint32_t have_checksum = 0;
+    const char* have =
+        do_test_wuffs_vp8_decode(&dec, &have_checksum, &src, UINT64_MAX, 0);
+    if (!have) {
+      RETURN_FAIL("length=%zu: have no error, want \"%s\"", lengths[i],
+                  wuffs_vp8__error__truncated_input);
+    } else if (!strstr(have, wuffs_vp8__error__truncated_input)) {
+      char buf[256];
+      snprintf(buf, sizeof(buf), "%s", have);
+      RETURN_FAIL("length=%zu: have \"%s\", want \"%s\"", lengths[i], buf,
+                  wuffs_vp8__error__truncated_input);
+    }
+  }
+
+  // Claim a frame length that's too short for the frame's partition sizes,
+  // which add up to 3193 bytes before the last token partition.
+  src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_vp8_chunk(&src, filename));
+  uint32_t have_checksum = 0;
+  const char* have =
+      do_test_wuffs_vp8_decode(&dec, &have_checksum, &src, UINT64_MAX, 3193);
+  if (!have || !strstr(have, wuffs_vp8__error__truncated_input)) {
+    RETURN_FAIL("frame_length=3193: have \"%s\", want \"%s\"",
+                have ? have : "", wuffs_vp8__error__truncated_input);
+  }
+  return NULL;
+}
 
 // ---------------- Mimic Tests
 
@@ -91,7 +503,12 @@ the first "./a.out" with "./a.out -bench". Combine these changes with the
 
 proc g_tests[] = {
 
-// No VP8 tests.
+    test_wuffs_vp8_decode_convert_row,
+    test_wuffs_vp8_decode_golden_checksums,
+    test_wuffs_vp8_decode_interface,
+    test_wuffs_vp8_decode_multiple_partitions,
+    test_wuffs_vp8_decode_short_reads,
+    test_wuffs_vp8_decode_truncated_input,
 
 #ifdef WUFFS_MIMIC
 
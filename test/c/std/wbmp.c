@@ -539,8 +539,563 @@ test_wuffs_pixel_swizzler_swizzle() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_pixel_swizzler_swizzle_from_table() {
+  CHECK_FOCUS(__func__);
+
+  // Convert 13x7 RGBA_NONPREMUL src pixels to BGR dst pixels. The whole-rect
+  // API should match converting each row separately, whether or not the rows
+  // are contiguous (each table's width equals its stride).
+  const size_t width = 13;
+  const size_t height = 7;
+  uint8_t src[7 * ((4 * 13) + 3)];
+  for (size_t i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(src); i++) {
+    src[i] = (uint8_t)((i * 0x3B) ^ (i >> 3));
+  }
+
+  wuffs_base__pixel_swizzler swizzler;
+  CHECK_STATUS("prepare",
+               wuffs_base__pixel_swizzler__prepare(
+                   &swizzler,
+                   wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGR),
+                   wuffs_base__empty_slice_u8(),
+                   wuffs_base__make_pixel_format(
+                       WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL),
+                   wuffs_base__empty_slice_u8(), WUFFS_BASE__PIXEL_BLEND__SRC));
+
+  struct {
+    size_t dst_stride;
+    size_t src_stride;
+    size_t dst_height;
+    size_t src_height;
+  } test_cases[] = {
+      {3 * 13, 4 * 13, 7, 7},              //
+      {(3 * 13) + 5, 4 * 13, 7, 7},        //
+      {3 * 13, (4 * 13) + 3, 7, 7},        //
+      {(3 * 13) + 5, (4 * 13) + 3, 7, 5},  //
+      {3 * 13, 4 * 13, 4, 7},              //
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    size_t dst_stride = test_cases[tc].dst_stride;
+    size_t src_stride = test_cases[tc].src_stride;
+    size_t num_rows = wuffs_base__u64__min(test_cases[tc].dst_height,
+                                           test_cases[tc].src_height);
+    const size_t len = dst_stride * height;
+    memset(g_have_array_u8, 0xA5, len);
+    memset(g_want_array_u8, 0xA5, len);
+
+    uint64_t have_n =
+        wuffs_base__pixel_swizzler__swizzle_interleaved_from_table(
+            &swizzler,
+            wuffs_base__make_table_u8(g_have_array_u8, 3 * width,
+                                      test_cases[tc].dst_height, dst_stride),
+            wuffs_base__empty_slice_u8(),
+            wuffs_base__make_table_u8(&src[0], 4 * width,
+                                      test_cases[tc].src_height, src_stride));
+    uint64_t want_n = 0;
+    for (size_t y = 0; y < num_rows; y++) {
+      want_n += wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
+          &swizzler,
+          wuffs_base__make_slice_u8(g_want_array_u8 + (y * dst_stride),
+                                    3 * width),
+          wuffs_base__empty_slice_u8(),
+          wuffs_base__make_slice_u8(&src[y * src_stride], 4 * width));
+    }
+
+    if (have_n != want_n) {
+      RETURN_FAIL("tc=%zu: num_pixels: have %" PRIu64 ", want %" PRIu64, tc,
+                  have_n, want_n);
+    } else if (have_n != (width * num_rows)) {
+      RETURN_FAIL("tc=%zu: num_pixels: have %" PRIu64 ", want %zu", tc, have_n,
+                  width * num_rows);
+    } else if (memcmp(g_have_array_u8, g_want_array_u8, len)) {
+      RETURN_FAIL("tc=%zu: have and want pixels differ", tc);
+    }
+  }
+
+  // The rows_from_slice variant takes packed src rows and can finish partway
+  // through a dst row.
+  const size_t dst_stride = (3 * 13) + 5;
+  const size_t len = dst_stride * height;
+  memset(g_have_array_u8, 0xA5, len);
+  memset(g_want_array_u8, 0xA5, len);
+  uint64_t have_n =
+      wuffs_base__pixel_swizzler__swizzle_interleaved_rows_from_slice(
+          &swizzler,
+          wuffs_base__make_table_u8(g_have_array_u8, 3 * width, height,
+                                    dst_stride),
+          wuffs_base__empty_slice_u8(),
+          wuffs_base__make_slice_u8(&src[0], 4 * ((3 * width) + 6)));
+  for (size_t y = 0; y < 4; y++) {
+    wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
+        &swizzler,
+        wuffs_base__make_slice_u8(g_want_array_u8 + (y * dst_stride),
+                                  3 * ((y < 3) ? width : 6)),
+        wuffs_base__empty_slice_u8(),
+        wuffs_base__make_slice_u8(&src[4 * y * width], 4 * width));
+  }
+  if (have_n != ((3 * width) + 6)) {
+    RETURN_FAIL("rows_from_slice: num_pixels: have %" PRIu64 ", want %zu",
+                have_n, (3 * width) + 6);
+  } else if (memcmp(g_have_array_u8, g_want_array_u8, len)) {
+    RETURN_FAIL("rows_from_slice: have and want pixels differ");
+  }
+  return NULL;
+}
+
+const char*  //
+do_test_wuffs_swizzle_convert_4(
+    wuffs_private_impl__swizzle_ycc__convert_4_func have_func,
+    wuffs_private_impl__swizzle_ycc__convert_4_func want_func,
+    uint32_t pixfmt_repr) {
+  // Fill the four 100-sample source planes with pseudo-random bytes.
+  uint8_t src[4][100];
+  uint32_t seed = 0x12345678u;
+  for (int c = 0; c < 4; c++) {
+    for (int i = 0; i < 100; i++) {
+      seed = (seed * 1103515245u) + 12345u;
+      src[c][i] = (uint8_t)(seed >> 24);
+    }
+  }
+
+  const uint32_t width = 100;
+  const size_t len = 4 * width;
+  wuffs_base__pixel_config pc = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_config__set(&pc, pixfmt_repr,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, 1);
+  wuffs_base__pixel_buffer have_pb = ((wuffs_base__pixel_buffer){});
+  wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice (have)",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &have_pb, &pc, g_have_slice_u8));
+  CHECK_STATUS("set_from_slice (want)",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &want_pb, &pc, g_want_slice_u8));
+
+  struct {
+    uint32_t x;
+    uint32_t x_end;
+  } test_cases[] = {
+      {0, 100},  //
+      {3, 10},   //
+      {5, 38},   //
+      {7, 99},   //
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    uint32_t x = test_cases[tc].x;
+    uint32_t x_end = test_cases[tc].x_end;
+    memset(g_have_array_u8, 0, len);
+    memset(g_want_array_u8, 0, len);
+    (*have_func)(&have_pb, x, x_end, 0, src[0] + x, src[1] + x, src[2] + x,
+                 src[3] + x);
+    (*want_func)(&want_pb, x, x_end, 0, src[0] + x, src[1] + x, src[2] + x,
+                 src[3] + x);
+    if (memcmp(g_have_array_u8, g_want_array_u8, len)) {
+      RETURN_FAIL("tc=%zu: have and want pixels differ", tc);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_swizzle_convert_4() {
+  CHECK_FOCUS(__func__);
+
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+  if (wuffs_base__cpu_arch__have_x86_avx2()) {
+    CHECK_STRING(do_test_wuffs_swizzle_convert_4(
+        &wuffs_private_impl__swizzle_cmyk__convert_4_bgrx_x86_avx2,
+        &wuffs_private_impl__swizzle_cmyk__convert_4_general,
+        WUFFS_BASE__PIXEL_FORMAT__BGRX));
+    CHECK_STRING(do_test_wuffs_swizzle_convert_4(
+        &wuffs_private_impl__swizzle_cmyk__convert_4_rgbx_x86_avx2,
+        &wuffs_private_impl__swizzle_cmyk__convert_4_general,
+        WUFFS_BASE__PIXEL_FORMAT__RGBX));
+    CHECK_STRING(do_test_wuffs_swizzle_convert_4(
+        &wuffs_private_impl__swizzle_ycck__convert_4_bgrx_x86_avx2,
+        &wuffs_private_impl__swizzle_ycck__convert_4_general,
+        WUFFS_BASE__PIXEL_FORMAT__BGRX));
+    CHECK_STRING(do_test_wuffs_swizzle_convert_4(
+        &wuffs_private_impl__swizzle_ycck__convert_4_rgbx_x86_avx2,
+        &wuffs_private_impl__swizzle_ycck__convert_4_general,
+        WUFFS_BASE__PIXEL_FORMAT__RGBX));
+  }
+#endif
+
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+  if (wuffs_base__cpu_arch__have_arm_neon()) {
+    CHECK_STRING(do_test_wuffs_swizzle_convert_4(
+        &wuffs_private_impl__swizzle_cmyk__convert_4_bgrx_arm_neon,
+        &wuffs_private_impl__swizzle_cmyk__convert_4_general,
+        WUFFS_BASE__PIXEL_FORMAT__BGRX));
+    CHECK_STRING(do_test_wuffs_swizzle_convert_4(
+        &wuffs_private_impl__swizzle_cmyk__convert_4_rgbx_arm_neon,
+        &wuffs_private_impl__swizzle_cmyk__convert_4_general,
+        WUFFS_BASE__PIXEL_FORMAT__RGBX));
+    CHECK_STRING(do_test_wuffs_swizzle_convert_4(
+        &wuffs_private_impl__swizzle_ycck__convert_4_bgrx_arm_neon,
+        &wuffs_private_impl__swizzle_ycck__convert_4_general,
+        WUFFS_BASE__PIXEL_FORMAT__BGRX));
+    CHECK_STRING(do_test_wuffs_swizzle_convert_4(
+        &wuffs_private_impl__swizzle_ycck__convert_4_rgbx_arm_neon,
+        &wuffs_private_impl__swizzle_ycck__convert_4_general,
+        WUFFS_BASE__PIXEL_FORMAT__RGBX));
+  }
+#endif
+
+  return NULL;
+}
+
+const char*  //
+do_test_wuffs_swizzle_src(wuffs_base__pixel_swizzler__func have_func,
+                          wuffs_base__pixel_swizzler__func want_func,
+                          size_t dst_bytes_per_pixel,
+                          size_t src_bytes_per_pixel,
+                          bool src_premul) {
+  // Fill 100 src pixels with pseudo-random 16-bit channels, narrowed to 8 bits
+  // unless the src is 4x16le. For 4 or 8 byte src pixels, the final channel
+  // is alpha and some runs of pixels have a uniform alpha (0x0000 or 0xFFFF),
+  // exercising any fast paths. Premul colors don't exceed their alpha, except
+  // for every 5th pixel (every other one of which has a tiny alpha). Such
+  // invalid premul input (which e.g. NIE files can contain) must still give
+  // the same output for every implementation.
+  const size_t width = 100;
+  uint8_t src[8 * 100];
+  uint32_t seed = 0x12345678u;
+  for (size_t i = 0; i < width; i++) {
+    seed = (seed * 1103515245u) + 12345u;
+    uint32_t alpha = ((i & 24) == 8)    ? 0x0000
+                     : ((i & 24) == 16) ? 0xFFFF
+                     : ((i % 10) == 9)  ? ((seed >> 16) & 0x03FF)
+                                        : (seed >> 16);
+    size_t num_channels = (src_bytes_per_pixel == 8) ? 4 : src_bytes_per_pixel;
+    for (size_t c = 0; c < num_channels; c++) {
+      seed = (seed * 1103515245u) + 12345u;
+      uint32_t s = (c == 3) ? alpha
+                   : (src_premul && ((i % 5) != 4))
+                       ? ((seed >> 16) % (alpha + 1))
+                       : (seed >> 16);
+      if (src_bytes_per_pixel == 8) {
+        wuffs_base__poke_u16le__no_bounds_check(&src[(8 * i) + (2 * c)],
+                                                (uint16_t)s);
+      } else {
+        src[(src_bytes_per_pixel * i) + c] = (uint8_t)(s >> 8);
+      }
+    }
+  }
+
+  struct {
+    uint32_t x;
+    uint32_t x_end;
+  } test_cases[] = {
+      {0, 100},  //
+      {3, 10},   //
+      {5, 38},   //
+      {7, 99},   //
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    uint32_t x = test_cases[tc].x;
+    uint32_t x_end = test_cases[tc].x_end;
+    const size_t len = dst_bytes_per_pixel * width;
+    memset(g_have_array_u8, 0xA5, len);
+    memset(g_want_array_u8, 0xA5, len);
+    uint64_t have_n = (*have_func)(
+        g_have_array_u8 + (dst_bytes_per_pixel * x),
+        dst_bytes_per_pixel * (x_end - x), NULL, 0,
+        src + (src_bytes_per_pixel * x), src_bytes_per_pixel * (x_end - x));
+    uint64_t want_n = (*want_func)(
+        g_want_array_u8 + (dst_bytes_per_pixel * x),
+        dst_bytes_per_pixel * (x_end - x), NULL, 0,
+        src + (src_bytes_per_pixel * x), src_bytes_per_pixel * (x_end - x));
+    if (have_n != want_n) {
+      RETURN_FAIL("tc=%zu: num_pixels: have %" PRIu64 ", want %" PRIu64, tc,
+                  have_n, want_n);
+    } else if (memcmp(g_have_array_u8, g_want_array_u8, len)) {
+      RETURN_FAIL("tc=%zu: have and want pixels differ", tc);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_swizzle_src() {
+  CHECK_FOCUS(__func__);
+
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+  if (wuffs_base__cpu_arch__have_x86_avx2()) {
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgr__rgba_premul__src__x86_avx2,
+        &wuffs_private_impl__swizzle_bgr__rgba_premul__src,
+        3, 4, true));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgra_nonpremul__bgra_nonpremul_4x16le__src__x86_avx2,
+        &wuffs_private_impl__swizzle_bgra_nonpremul__bgra_nonpremul_4x16le__src,
+        4, 8, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src__x86_avx2,
+        &wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src,
+        4, 4, true));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src__x86_avx2,
+        &wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src,
+        4, 4, true));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src__x86_avx2,
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src,
+        4, 4, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src__x86_avx2,
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src,
+        4, 8, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src__x86_avx2,
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src,
+        4, 4, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src__x86_avx2,
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src,
+        4, 8, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgrw__bgr__x86_avx2,
+        &wuffs_private_impl__swizzle_bgrw__bgr,
+        4, 3, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgrw__rgb__x86_avx2,
+        &wuffs_private_impl__swizzle_bgrw__rgb,
+        4, 3, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_rgba_nonpremul__bgra_nonpremul_4x16le__src__x86_avx2,
+        &wuffs_private_impl__swizzle_rgba_nonpremul__bgra_nonpremul_4x16le__src,
+        4, 8, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_xxx__xxxx__x86_avx2,
+        &wuffs_private_impl__swizzle_xxx__xxxx,
+        3, 4, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_xxxx__y__x86_avx2,
+        &wuffs_private_impl__swizzle_xxxx__y,
+        4, 1, false));
+  }
+#endif
+
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+  if (wuffs_base__cpu_arch__have_arm_neon()) {
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgr__rgba_premul__src__arm_neon,
+        &wuffs_private_impl__swizzle_bgr__rgba_premul__src,
+        3, 4, true));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgra_nonpremul__bgra_nonpremul_4x16le__src__arm_neon,
+        &wuffs_private_impl__swizzle_bgra_nonpremul__bgra_nonpremul_4x16le__src,
+        4, 8, false));
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON_A64)
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src__arm_neon,
+        &wuffs_private_impl__swizzle_bgra_nonpremul__bgra_premul__src,
+        4, 4, true));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src__arm_neon,
+        &wuffs_private_impl__swizzle_bgra_nonpremul__rgba_premul__src,
+        4, 4, true));
+#endif
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src__arm_neon,
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src,
+        4, 4, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src__arm_neon,
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src,
+        4, 8, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src__arm_neon,
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src,
+        4, 4, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src__arm_neon,
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src,
+        4, 8, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgrw__bgr__arm_neon,
+        &wuffs_private_impl__swizzle_bgrw__bgr,
+        4, 3, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_bgrw__rgb__arm_neon,
+        &wuffs_private_impl__swizzle_bgrw__rgb,
+        4, 3, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_rgba_nonpremul__bgra_nonpremul_4x16le__src__arm_neon,
+        &wuffs_private_impl__swizzle_rgba_nonpremul__bgra_nonpremul_4x16le__src,
+        4, 8, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_xxx__xxxx__arm_neon,
+        &wuffs_private_impl__swizzle_xxx__xxxx,
+        3, 4, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src(
+        &wuffs_private_impl__swizzle_xxxx__y__arm_neon,
+        &wuffs_private_impl__swizzle_xxxx__y,
+        4, 1, false));
+  }
+#endif
+
+  return NULL;
+}
+
+const char*  //
+do_test_wuffs_swizzle_src_over(wuffs_base__pixel_swizzler__func have_func,
+                               wuffs_base__pixel_swizzler__func want_func,
+                               size_t src_bytes_per_pixel,
+                               bool src_premul) {
+  // Fill 100 BGRA premul dst pixels and 100 src pixels with pseudo-random
+  // 16-bit colors, narrowed to 8 bits unless the src is 4x16le. Premul colors
+  // never exceed their alpha. Some runs of src pixels have a uniform alpha
+  // (0x0000 or 0xFFFF), exercising any fast paths.
+  const size_t width = 100;
+  uint8_t dst[4 * 100];
+  uint8_t src[8 * 100];
+  uint32_t seed = 0x12345678u;
+  for (size_t i = 0; i < width; i++) {
+    seed = (seed * 1103515245u) + 12345u;
+    uint32_t dst_alpha = seed >> 16;
+    seed = (seed * 1103515245u) + 12345u;
+    uint32_t src_alpha = ((i & 24) == 8)    ? 0x0000
+                         : ((i & 24) == 16) ? 0xFFFF
+                                            : (seed >> 16);
+    for (int c = 0; c < 4; c++) {
+      seed = (seed * 1103515245u) + 12345u;
+      uint32_t d = (c == 3) ? dst_alpha : ((seed >> 16) % (dst_alpha + 1));
+      seed = (seed * 1103515245u) + 12345u;
+      uint32_t s = (c == 3)     ? src_alpha
+                   : src_premul ? ((seed >> 16) % (src_alpha + 1))
+                                : (seed >> 16);
+      dst[(4 * i) + c] = (uint8_t)(d >> 8);
+      if (src_bytes_per_pixel == 4) {
+        src[(4 * i) + c] = (uint8_t)(s >> 8);
+      } else {
+        wuffs_base__poke_u16le__no_bounds_check(&src[(8 * i) + (2 * c)],
+                                                (uint16_t)s);
+      }
+    }
+  }
+
+  struct {
+    uint32_t x;
+    uint32_t x_end;
+  } test_cases[] = {
+      {0, 100},  //
+      {3, 10},   //
+      {5, 38},   //
+      {7, 99},   //
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    uint32_t x = test_cases[tc].x;
+    uint32_t x_end = test_cases[tc].x_end;
+    const size_t len = 4 * width;
+    memcpy(g_have_array_u8, dst, len);
+    memcpy(g_want_array_u8, dst, len);
+    uint64_t have_n = (*have_func)(
+        g_have_array_u8 + (4 * x), 4 * (x_end - x), NULL, 0,
+        src + (src_bytes_per_pixel * x), src_bytes_per_pixel * (x_end - x));
+    uint64_t want_n = (*want_func)(
+        g_want_array_u8 + (4 * x), 4 * (x_end - x), NULL, 0,
+        src + (src_bytes_per_pixel * x), src_bytes_per_pixel * (x_end - x));
+    if (have_n != want_n) {
+      RETURN_FAIL("tc=%zu: num_pixels: have %" PRIu64 ", want %" PRIu64, tc,
+                  have_n, want_n);
+    } else if (memcmp(g_have_array_u8, g_want_array_u8, len)) {
+      RETURN_FAIL("tc=%zu: have and want pixels differ", tc);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_swizzle_src_over() {
+  CHECK_FOCUS(__func__);
+
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+  if (wuffs_base__cpu_arch__have_x86_avx2()) {
+    CHECK_STRING(do_test_wuffs_swizzle_src_over(
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src_over__x86_avx2,
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src_over,
+        4, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src_over(
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src_over__x86_avx2,
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src_over,
+        8, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src_over(
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over__x86_avx2,
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over,
+        4, true));
+    CHECK_STRING(do_test_wuffs_swizzle_src_over(
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_premul_4x16le__src_over__x86_avx2,
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_premul_4x16le__src_over,
+        8, true));
+    CHECK_STRING(do_test_wuffs_swizzle_src_over(
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src_over__x86_avx2,
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src_over,
+        4, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src_over(
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src_over__x86_avx2,
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src_over,
+        8, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src_over(
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over__x86_avx2,
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over,
+        4, true));
+    CHECK_STRING(do_test_wuffs_swizzle_src_over(
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_premul_4x16le__src_over__x86_avx2,
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_premul_4x16le__src_over,
+        8, true));
+  }
+#endif
+
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__ARM_NEON)
+  if (wuffs_base__cpu_arch__have_arm_neon()) {
+    CHECK_STRING(do_test_wuffs_swizzle_src_over(
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src_over__arm_neon,
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul__src_over,
+        4, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src_over(
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src_over__arm_neon,
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_nonpremul_4x16le__src_over,
+        8, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src_over(
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over__arm_neon,
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_premul__src_over,
+        4, true));
+    CHECK_STRING(do_test_wuffs_swizzle_src_over(
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_premul_4x16le__src_over__arm_neon,
+        &wuffs_private_impl__swizzle_bgra_premul__bgra_premul_4x16le__src_over,
+        8, true));
+    CHECK_STRING(do_test_wuffs_swizzle_src_over(
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src_over__arm_neon,
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul__src_over,
+        4, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src_over(
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src_over__arm_neon,
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_nonpremul_4x16le__src_over,
+        8, false));
+    CHECK_STRING(do_test_wuffs_swizzle_src_over(
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over__arm_neon,
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_premul__src_over,
+        4, true));
+    CHECK_STRING(do_test_wuffs_swizzle_src_over(
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_premul_4x16le__src_over__arm_neon,
+        &wuffs_private_impl__swizzle_bgra_premul__rgba_premul_4x16le__src_over,
+        8, true));
+  }
+#endif
+
+  return NULL;
+}
+
 const char*  //
 test_wuffs_upsample_inv_h2v1() {
+
   CHECK_FOCUS(__func__);
 
   // src_array0 is "A lovely example".
@@ -757,6 +1312,14 @@ bench_wuffs_pixel_swizzler_bgr_565_rgba_nonpremul_src() {
                                        WUFFS_BASE__PIXEL_BLEND__SRC, 400);
 }
 
+const char*  //
+bench_wuffs_pixel_swizzler_bgr_bgra_premul_src() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(WUFFS_BASE__PIXEL_FORMAT__BGR,
+                                       WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                       WUFFS_BASE__PIXEL_BLEND__SRC, 3000);
+}
+
 const char*  //
 bench_wuffs_pixel_swizzler_bgr_rgba_nonpremul_src() {
   CHECK_FOCUS(__func__);
@@ -765,6 +1328,23 @@ bench_wuffs_pixel_swizzler_bgr_rgba_nonpremul_src() {
                                        WUFFS_BASE__PIXEL_BLEND__SRC, 500);
 }
 
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_nonpremul_bgra_nonpremul_4x16le_src() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+      WUFFS_BASE__PIXEL_BLEND__SRC, 2000);
+}
+
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_nonpremul_bgra_premul_src() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+                                       WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                       WUFFS_BASE__PIXEL_BLEND__SRC, 1000);
+}
+
 const char*  //
 bench_wuffs_pixel_swizzler_bgra_nonpremul_rgba_nonpremul_src() {
   CHECK_FOCUS(__func__);
@@ -773,6 +1353,31 @@ bench_wuffs_pixel_swizzler_bgra_nonpremul_rgba_nonpremul_src() {
                                        WUFFS_BASE__PIXEL_BLEND__SRC, 8000);
 }
 
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_premul_bgr_src() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                       WUFFS_BASE__PIXEL_FORMAT__BGR,
+                                       WUFFS_BASE__PIXEL_BLEND__SRC, 2000);
+}
+
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_premul_bgra_nonpremul_src() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+                                       WUFFS_BASE__PIXEL_BLEND__SRC, 1000);
+}
+
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_premul_bgra_nonpremul_4x16le_src() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+      WUFFS_BASE__PIXEL_BLEND__SRC, 1000);
+}
+
 const char*  //
 bench_wuffs_pixel_swizzler_bgra_premul_y_src() {
   CHECK_FOCUS(__func__);
@@ -806,6 +1411,14 @@ bench_wuffs_pixel_swizzler_bgra_premul_rgba_nonpremul_src() {
                                        WUFFS_BASE__PIXEL_BLEND__SRC, 1000);
 }
 
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_premul_bgra_premul_src_over() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                       WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                       WUFFS_BASE__PIXEL_BLEND__SRC_OVER, 300);
+}
+
 const char*  //
 bench_wuffs_pixel_swizzler_bgra_premul_rgba_nonpremul_src_over() {
   CHECK_FOCUS(__func__);
@@ -814,6 +1427,15 @@ bench_wuffs_pixel_swizzler_bgra_premul_rgba_nonpremul_src_over() {
                                        WUFFS_BASE__PIXEL_BLEND__SRC_OVER, 300);
 }
 
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_premul_bgra_nonpremul_4x16le_src_over() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+      WUFFS_BASE__PIXEL_BLEND__SRC_OVER, 200);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -832,6 +1454,10 @@ proc g_tests[] = {
     test_wuffs_color_ycc_as_color_u32,
     test_wuffs_pixel_buffer_fill_rect,
     test_wuffs_pixel_swizzler_swizzle,
+    test_wuffs_pixel_swizzler_swizzle_from_table,
+    test_wuffs_swizzle_convert_4,
+    test_wuffs_swizzle_src,
+    test_wuffs_swizzle_src_over,
     test_wuffs_upsample_inv_h2v1,
 
     test_wuffs_wbmp_decode_frame_config,
@@ -851,13 +1477,21 @@ proc g_tests[] = {
 proc g_benches[] = {
 
     bench_wuffs_pixel_swizzler_bgr_565_rgba_nonpremul_src,
+    bench_wuffs_pixel_swizzler_bgr_bgra_premul_src,
     bench_wuffs_pixel_swizzler_bgr_rgba_nonpremul_src,
+    bench_wuffs_pixel_swizzler_bgra_nonpremul_bgra_nonpremul_4x16le_src,
+    bench_wuffs_pixel_swizzler_bgra_nonpremul_bgra_premul_src,
     bench_wuffs_pixel_swizzler_bgra_nonpremul_rgba_nonpremul_src,
+    bench_wuffs_pixel_swizzler_bgra_premul_bgr_src,
+    bench_wuffs_pixel_swizzler_bgra_premul_bgra_nonpremul_src,
+    bench_wuffs_pixel_swizzler_bgra_premul_bgra_nonpremul_4x16le_src,
     bench_wuffs_pixel_swizzler_bgra_premul_y_src,
     bench_wuffs_pixel_swizzler_bgra_premul_indexed_bgra_binary_src,
     bench_wuffs_pixel_swizzler_bgra_premul_rgb_src,
     bench_wuffs_pixel_swizzler_bgra_premul_rgba_nonpremul_src,
+    bench_wuffs_pixel_swizzler_bgra_premul_bgra_premul_src_over,
     bench_wuffs_pixel_swizzler_bgra_premul_rgba_nonpremul_src_over,
+    bench_wuffs_pixel_swizzler_bgra_premul_bgra_nonpremul_4x16le_src_over,
 
 #ifdef WUFFS_MIMIC
 
@@ -111,7 +111,60 @@ test_wuffs_webp_decode_interface_lossy() {
                    WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
   return do_test__wuffs_base__image_decoder(
       wuffs_webp__decoder__upcast_as__wuffs_base__image_decoder(dec),
-      "test/data/bricks-color.lossy.webp", 0, SIZE_MAX, 160, 120, 0xFF9F7780);
+      "test/data/bricks-color.lossy.webp", 0, SIZE_MAX, 160, 120, 0xFF032665);
+}
+
+const char*  //
+test_wuffs_webp_decode_lossy_workbuf_len() {
+  CHECK_FOCUS(__func__);
+
+  // All but the last VP8 token partition are buffered in the workbuf. Check
+  // that both of std/webp's workbuf_len bounds have room for them, for both
+  // single and multiple partition files.
+  const char* filenames[] = {
+      "test/data/bricks-color.lossy.webp",
+      "test/data/bricks-color.partitions-4.lossy.webp",
+      "test/data/hippopotamus.partitions-8.lossy.webp",
+  };
+
+  for (size_t i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(filenames); i++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[i]));
+
+    wuffs_webp__decoder* dec = &g_webp_decoder;
+    CHECK_STATUS("initialize",
+                 wuffs_webp__decoder__initialize(
+                     dec, sizeof *dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_webp__decoder__decode_image_config(dec, &ic, &src));
+    wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                       &pb, &ic.pixcfg, g_pixel_slice_u8));
+
+    wuffs_base__range_ii_u64 workbuf_len =
+        wuffs_webp__decoder__workbuf_len(dec);
+    if (workbuf_len.min_incl != workbuf_len.max_incl) {
+      RETURN_FAIL("%s: workbuf_len: min_incl (%" PRIu64
+                  ") != max_incl (%" PRIu64 ")",
+                  filenames[i], workbuf_len.min_incl, workbuf_len.max_incl);
+    } else if (workbuf_len.min_incl > g_work_slice_u8.len) {
+      RETURN_FAIL("%s: workbuf_len is too large", filenames[i]);
+    }
+    wuffs_base__status status = wuffs_webp__decoder__decode_frame(
+        dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+        wuffs_base__make_slice_u8(g_work_slice_u8.ptr,
+                                  (size_t)workbuf_len.min_incl),
+        NULL);
+    if (status.repr) {
+      RETURN_FAIL("%s: decode_frame: \"%s\"", filenames[i], status.repr);
+    }
+  }
+  return NULL;
 }
 
 // ---------------- Mimic Tests
@@ -295,6 +348,7 @@ proc g_tests[] = {
 
     test_wuffs_webp_decode_interface_lossless,
     test_wuffs_webp_decode_interface_lossy,
+    test_wuffs_webp_decode_lossy_workbuf_len,
 
 #ifdef WUFFS_MIMIC
 
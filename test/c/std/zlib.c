@@ -174,15 +174,20 @@ wuffs_raw_deflate_decode(wuffs_base__io_buffer* dst,
 }
 
 const char*  //
-wuffs_zlib_decode(wuffs_base__io_buffer* dst,
-                  wuffs_base__io_buffer* src,
-                  uint32_t wuffs_initialize_flags,
-                  uint64_t wlimit,
-                  uint64_t rlimit) {
+do_wuffs_zlib_decode(wuffs_base__io_buffer* dst,
+                     wuffs_base__io_buffer* src,
+                     uint32_t wuffs_initialize_flags,
+                     uint64_t wlimit,
+                     uint64_t rlimit,
+                     bool ignore_checksum) {
   wuffs_zlib__decoder dec;
   CHECK_STATUS("initialize",
                wuffs_zlib__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
                                                wuffs_initialize_flags));
+  CHECK_STATUS("set_quirk",
+               wuffs_zlib__decoder__set_quirk(&dec,
+                                              WUFFS_BASE__QUIRK_IGNORE_CHECKSUM,
+                                              (uint64_t)ignore_checksum));
 
   while (true) {
     wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
@@ -204,6 +209,26 @@ wuffs_zlib_decode(wuffs_base__io_buffer* dst,
   }
 }
 
+const char*  //
+wuffs_zlib_decode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  uint32_t wuffs_initialize_flags,
+                  uint64_t wlimit,
+                  uint64_t rlimit) {
+  return do_wuffs_zlib_decode(dst, src, wuffs_initialize_flags, wlimit, rlimit,
+                              false);
+}
+
+const char*  //
+wuffs_zlib_decode_ignore_checksum(wuffs_base__io_buffer* dst,
+                                  wuffs_base__io_buffer* src,
+                                  uint32_t wuffs_initialize_flags,
+                                  uint64_t wlimit,
+                                  uint64_t rlimit) {
+  return do_wuffs_zlib_decode(dst, src, wuffs_initialize_flags, wlimit, rlimit,
+                              true);
+}
+
 const char*  //
 do_test_wuffs_zlib_checksum(bool ignore_checksum, uint32_t bad_checksum) {
   wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
@@ -359,6 +384,59 @@ test_wuffs_zlib_decode_sheep() {
   return check_io_buffers_equal("", &have, &want);
 }
 
+const char*  //
+test_wuffs_zlib_encode_round_trip() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, g_zlib_midsummer_gt.want_filename));
+
+  wuffs_zlib__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_zlib__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+  // Use small I/O limits, so that the encoder has to suspend and resume while
+  // writing the zlib header and trailer.
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(have, 3);
+    wuffs_base__io_buffer limited_src = make_limited_reader(src, 7);
+    wuffs_base__status status = wuffs_zlib__encoder__transform_io(
+        &enc, &limited_dst, &limited_src, g_work_slice_u8);
+    have.meta.wi += limited_dst.meta.wi;
+    src.meta.ri += limited_src.meta.ri;
+    if ((status.repr == wuffs_base__suspension__short_write) ||
+        (status.repr == wuffs_base__suspension__short_read)) {
+      continue;
+    }
+    CHECK_STATUS("transform_io", status);
+    break;
+  }
+
+  // The default compression level gives the same header as zlib-the-library.
+  if ((have.meta.wi < 6) || (have.data.ptr[0] != 0x78) ||
+      (have.data.ptr[1] != 0x9C)) {
+    RETURN_FAIL("invalid zlib header");
+  }
+
+  // Decoding verifies the Adler-32 checksum in the trailer.
+  have.meta.closed = true;
+  CHECK_STRING(wuffs_zlib_decode(&want, &have,
+                                 WUFFS_INITIALIZE__DEFAULT_OPTIONS, UINT64_MAX,
+                                 UINT64_MAX));
+  src.meta.ri = 0;
+  return check_io_buffers_equal("", &want, &src);
+}
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -418,6 +496,27 @@ bench_wuffs_zlib_decode_100k() {
       tcounter_dst, &g_zlib_pi_gt, UINT64_MAX, UINT64_MAX, 30);
 }
 
+// The "ignore_checksum" benches measure how much of the time above is spent
+// checksumming the decoded output.
+
+const char*  //
+bench_wuffs_zlib_decode_10k_ignore_checksum() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_zlib_decode_ignore_checksum,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_dst,
+      &g_zlib_midsummer_gt, UINT64_MAX, UINT64_MAX, 300);
+}
+
+const char*  //
+bench_wuffs_zlib_decode_100k_ignore_checksum() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_zlib_decode_ignore_checksum,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_dst,
+      &g_zlib_pi_gt, UINT64_MAX, UINT64_MAX, 30);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -452,6 +551,7 @@ proc g_tests[] = {
     test_wuffs_zlib_decode_raw_deflate_romeo,
     test_wuffs_zlib_decode_sheep,
     test_wuffs_zlib_decode_truncated_input,
+    test_wuffs_zlib_encode_round_trip,
 
 #ifdef WUFFS_MIMIC
 
@@ -469,7 +569,9 @@ proc g_tests[] = {
 proc g_benches[] = {
 
     bench_wuffs_zlib_decode_10k,
+    bench_wuffs_zlib_decode_10k_ignore_checksum,
     bench_wuffs_zlib_decode_100k,
+    bench_wuffs_zlib_decode_100k_ignore_checksum,
 
 #ifdef WUFFS_MIMIC
 
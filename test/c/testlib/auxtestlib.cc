@@ -0,0 +1,129 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// https://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or https://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+// auxtestlib.cc is the C++ counterpart of testlib.c, for testing the
+// wuffs_aux API (which is C++ only). It is much smaller: there are no benches,
+// mimic tests or flags.
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ThreadExecutor runs each task on its own thread. RunAll itself must only be
+// called from one thread at a time.
+class ThreadExecutor : public wuffs_aux::Executor {
+ public:
+  explicit ThreadExecutor(size_t num_workers0)
+      : num_run_all_calls(0), m_num_workers(num_workers0) {}
+
+  size_t NumWorkers() override { return m_num_workers; }
+
+  void RunAll(size_t n, const std::function<void(size_t)>& task) override {
+    num_run_all_calls++;
+    std::vector<std::thread> threads;
+    threads.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+      threads.emplace_back(task, i);
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+  }
+
+  size_t num_run_all_calls;
+
+ private:
+  size_t m_num_workers;
+};
+
+// ReverseExecutor runs each task on the calling thread, last task first. It
+// catches code that wrongly assumes that tasks run in order.
+class ReverseExecutor : public wuffs_aux::Executor {
+ public:
+  explicit ReverseExecutor(size_t num_workers0)
+      : num_run_all_calls(0), run_all_sizes(), m_num_workers(num_workers0) {}
+
+  size_t NumWorkers() override { return m_num_workers; }
+
+  void RunAll(size_t n, const std::function<void(size_t)>& task) override {
+    num_run_all_calls++;
+    run_all_sizes.push_back(n);
+    for (size_t i = n; i > 0; i--) {
+      task(i - 1);
+    }
+  }
+
+  size_t num_run_all_calls;
+  std::vector<size_t> run_all_sizes;
+
+ private:
+  size_t m_num_workers;
+};
+
+std::string  //
+read_file(std::string& dst, const char* path) {
+  dst.clear();
+  FILE* f = fopen(path, "rb");
+  if (!f) {
+    return std::string("read_file: could not open ") + path;
+  }
+  char buf[4096];
+  while (true) {
+    size_t n = fread(&buf[0], 1, sizeof(buf), f);
+    dst.append(&buf[0], n);
+    if (n < sizeof(buf)) {
+      break;
+    }
+  }
+  bool ok = !ferror(f);
+  fclose(f);
+  return ok ? "" : (std::string("read_file: could not read ") + path);
+}
+
+struct AuxTest {
+  const char* name;
+  std::string (*func)();
+};
+
+int  //
+aux_test_main(const char* package_name,
+              const AuxTest* tests,
+              size_t num_tests) {
+  // Like testlib.c's chdir_to_the_wuffs_root_directory.
+  for (int n = 0; n < 64; n++) {
+    if (access("wuffs-root-directory.txt", F_OK) == 0) {
+      break;
+    } else if (chdir("..")) {
+      break;
+    }
+  }
+  if (access("wuffs-root-directory.txt", F_OK) != 0) {
+    fprintf(stderr,
+            "could not find Wuffs root directory; chdir there before running "
+            "this program\n");
+    return 1;
+  }
+
+  for (size_t i = 0; i < num_tests; i++) {
+    std::string status = (*tests[i].func)();
+    if (!status.empty()) {
+      printf("%-16s%-8sFAIL %s: %s\n", package_name, "c++", tests[i].name,
+             status.c_str());
+      return 1;
+    }
+  }
+  printf("%-16s%-8sPASS (%d tests)\n", package_name, "c++",
+         static_cast<int>(num_tests));
+  return 0;
+}
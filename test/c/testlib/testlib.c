@@ -1284,6 +1284,101 @@ do_test__wuffs_base__image_decoder(
   return NULL;
 }
 
+// do_test__wuffs_base__image_decoder_region_of_interest decodes the first
+// frame twice, with want_dec (ignoring roi) and then with have_dec (passing
+// roi). Within roi, the pixels should match. Outside of have_dec's
+// frame_dirty_rect, the pixels should be untouched.
+const char*  //
+do_test__wuffs_base__image_decoder_region_of_interest(
+    wuffs_base__image_decoder* want_dec,
+    wuffs_base__image_decoder* have_dec,
+    const char* src_filename,
+    wuffs_base__rect_ie_u32 roi) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, src_filename));
+
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_base__image_decoder__decode_image_config(want_dec, &ic,
+                                                              &src));
+  uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+  wuffs_base__pixel_config__set(
+      &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+  size_t n = ((size_t)width) * ((size_t)height) * 4;
+  if ((n > sizeof(g_want_array_u8)) || (n > sizeof(g_have_array_u8))) {
+    RETURN_FAIL("image is too large");
+  }
+
+  memset(g_want_array_u8, 0, n);
+  wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &want_pb, &ic.pixcfg,
+                   wuffs_base__make_slice_u8(g_want_array_u8, n)));
+  CHECK_STATUS("decode_frame (want)",
+               wuffs_base__image_decoder__decode_frame(
+                   want_dec, &want_pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                   g_work_slice_u8, NULL));
+  wuffs_base__rect_ie_u32 frame =
+      wuffs_base__image_decoder__frame_dirty_rect(want_dec);
+
+  src.meta.ri = 0;
+  CHECK_STATUS("decode_image_config",
+               wuffs_base__image_decoder__decode_image_config(have_dec, NULL,
+                                                              &src));
+  memset(g_have_array_u8, 0, n);
+  wuffs_base__pixel_buffer have_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &have_pb, &ic.pixcfg,
+                   wuffs_base__make_slice_u8(g_have_array_u8, n)));
+  wuffs_base__decode_frame_options opts =
+      wuffs_base__null_decode_frame_options();
+  wuffs_base__decode_frame_options__set_region_of_interest(&opts, roi);
+  CHECK_STATUS("decode_frame (have)",
+               wuffs_base__image_decoder__decode_frame(
+                   have_dec, &have_pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                   g_work_slice_u8, &opts));
+  wuffs_base__rect_ie_u32 dirty_rect =
+      wuffs_base__image_decoder__frame_dirty_rect(have_dec);
+
+  wuffs_base__rect_ie_u32 want_rect =
+      wuffs_base__rect_ie_u32__is_empty(&roi)
+          ? frame
+          : wuffs_base__rect_ie_u32__intersect(&frame, roi);
+  if (!wuffs_base__rect_ie_u32__contains_rect(&frame, dirty_rect) ||
+      (!wuffs_base__rect_ie_u32__is_empty(&want_rect) &&
+       !wuffs_base__rect_ie_u32__contains_rect(&dirty_rect, want_rect))) {
+    RETURN_FAIL("dirty_rect: have (%" PRIu32 ", %" PRIu32 ")-(%" PRIu32
+                ", %" PRIu32 ")",
+                dirty_rect.min_incl_x, dirty_rect.min_incl_y,
+                dirty_rect.max_excl_x, dirty_rect.max_excl_y);
+  }
+
+  for (uint32_t y = 0; y < height; y++) {
+    for (uint32_t x = 0; x < width; x++) {
+      size_t i = 4 * ((((size_t)y) * width) + x);
+      if (wuffs_base__rect_ie_u32__contains(&want_rect, x, y)) {
+        if (memcmp(g_have_array_u8 + i, g_want_array_u8 + i, 4)) {
+          RETURN_FAIL("pixel (%" PRIu32 ", %" PRIu32 ") differs", x, y);
+        }
+      } else if (!wuffs_base__rect_ie_u32__contains(&dirty_rect, x, y)) {
+        const uint8_t* have = g_have_array_u8 + i;
+        if (have[0] | have[1] | have[2] | have[3]) {
+          RETURN_FAIL("pixel (%" PRIu32 ", %" PRIu32
+                      ") is outside of the dirty_rect but was modified",
+                      x, y);
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 do_test__wuffs_base__io_transformer(wuffs_base__io_transformer* b,
                                     const char* src_filename,
@@ -0,0 +1,411 @@
+// Copyright 2024 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// https://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or https://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+//go:build ignore
+// +build ignore
+
+package main
+
+// Usage: go run make-bricks-color-restart-interval.go
+//
+// The test/data/bricks-color.jpeg file is a sequential JPEG (160 × 120 pixels,
+// 4:2:0 chroma subsampling, 10 × 8 MCUs) without restart markers. This
+// program losslessly transcodes it (similar to "jpegtran -restart 3B") to add
+// a DRI (Define Restart Interval) marker and RSTn markers every 3 MCUs. Its
+// DCT coefficients (and therefore its decoded pixels) are unchanged, but the
+// entropy-coded data is re-encoded with the "typical" Huffman tables from
+// section K.3 of the JPEG specification, as the original file's optimized
+// tables don't necessarily have codes for the (larger) DC differences at the
+// start of each restart interval.
+
+import (
+	"errors"
+	"os"
+)
+
+func main() {
+	if err := main1(); err != nil {
+		os.Stderr.WriteString(err.Error() + "\n")
+		os.Exit(1)
+	}
+}
+
+const restartInterval = 3
+
+var (
+	errBadInput         = errors.New("bad input")
+	errUnsupportedInput = errors.New("unsupported input")
+)
+
+type huffman struct {
+	// bits[i] is the number of codes of length (i + 1).
+	bits [16]uint8
+	vals []uint8
+
+	// For decoding.
+	lookup map[[2]uint32]uint8 // {length, code} → value.
+
+	// For encoding.
+	codes   [256]uint32
+	lengths [256]uint32
+}
+
+func (h *huffman) build() {
+	h.lookup = map[[2]uint32]uint8{}
+	code, k := uint32(0), 0
+	for i := 0; i < 16; i++ {
+		for j := 0; j < int(h.bits[i]); j++ {
+			v := h.vals[k]
+			h.lookup[[2]uint32{uint32(i + 1), code}] = v
+			h.codes[v] = code
+			h.lengths[v] = uint32(i + 1)
+			code++
+			k++
+		}
+		code <<= 1
+	}
+}
+
+// These are the Huffman tables from section K.3 of the JPEG specification.
+var typicalHuffmans = [2][2]huffman{{{
+	bits: [16]uint8{0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0},
+	vals: []uint8{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11},
+}, {
+	bits: [16]uint8{0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0},
+	vals: []uint8{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11},
+}}, {{
+	bits: [16]uint8{0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7D},
+	vals: []uint8{
+		0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+		0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0,
+		0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25, 0x26, 0x27, 0x28,
+		0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+		0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+		0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+		0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7,
+		0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5,
+		0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xE1, 0xE2,
+		0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8,
+		0xF9, 0xFA,
+	},
+}, {
+	bits: [16]uint8{0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77},
+	vals: []uint8{
+		0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+		0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0,
+		0x15, 0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18, 0x19, 0x1A, 0x26,
+		0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+		0x49, 0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+		0x69, 0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+		0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5,
+		0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3,
+		0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA,
+		0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8,
+		0xF9, 0xFA,
+	},
+}}}
+
+type component struct {
+	h, v   int
+	td, ta int // Huffman table selectors.
+	prevDC int32
+}
+
+type bitReader struct {
+	src   []byte
+	bits  uint32
+	nBits uint32
+}
+
+func (r *bitReader) readBit() (uint32, error) {
+	if r.nBits == 0 {
+		if len(r.src) == 0 {
+			return 0, errBadInput
+		}
+		c := r.src[0]
+		r.src = r.src[1:]
+		if c == 0xFF {
+			if (len(r.src) == 0) || (r.src[0] != 0x00) {
+				return 0, errBadInput
+			}
+			r.src = r.src[1:]
+		}
+		r.bits, r.nBits = uint32(c), 8
+	}
+	r.nBits--
+	return (r.bits >> r.nBits) & 1, nil
+}
+
+func (r *bitReader) readBits(n uint32) (uint32, error) {
+	x := uint32(0)
+	for ; n > 0; n-- {
+		b, err := r.readBit()
+		if err != nil {
+			return 0, err
+		}
+		x = (x << 1) | b
+	}
+	return x, nil
+}
+
+func (r *bitReader) decodeHuffman(h *huffman) (uint8, error) {
+	code := uint32(0)
+	for n := uint32(1); n <= 16; n++ {
+		b, err := r.readBit()
+		if err != nil {
+			return 0, err
+		}
+		code = (code << 1) | b
+		if v, ok := h.lookup[[2]uint32{n, code}]; ok {
+			return v, nil
+		}
+	}
+	return 0, errBadInput
+}
+
+func (r *bitReader) receiveExtend(n uint32) (int32, error) {
+	if n == 0 {
+		return 0, nil
+	}
+	x, err := r.readBits(n)
+	if err != nil {
+		return 0, err
+	}
+	if x < (1 << (n - 1)) {
+		return int32(x) - int32(1<<n) + 1, nil
+	}
+	return int32(x), nil
+}
+
+type bitWriter struct {
+	dst   []byte
+	bits  uint32
+	nBits uint32
+}
+
+func (w *bitWriter) writeBits(x uint32, n uint32) {
+	for ; n > 0; n-- {
+		w.bits = (w.bits << 1) | ((x >> (n - 1)) & 1)
+		w.nBits++
+		if w.nBits == 8 {
+			c := byte(w.bits)
+			w.dst = append(w.dst, c)
+			if c == 0xFF {
+				w.dst = append(w.dst, 0x00)
+			}
+			w.bits, w.nBits = 0, 0
+		}
+	}
+}
+
+func (w *bitWriter) flush() {
+	if w.nBits > 0 {
+		w.writeBits(0x7F, 8-w.nBits)
+	}
+}
+
+func (w *bitWriter) writeHuffman(h *huffman, v uint8) {
+	w.writeBits(h.codes[v], h.lengths[v])
+}
+
+func (w *bitWriter) writeValue(h *huffman, prefix uint8, x int32) {
+	n, a := uint32(0), x
+	if a < 0 {
+		a = -a
+	}
+	for ; a > 0; a >>= 1 {
+		n++
+	}
+	w.writeHuffman(h, prefix|uint8(n))
+	if x < 0 {
+		x--
+	}
+	w.writeBits(uint32(x)&((1<<n)-1), n)
+}
+
+func main1() error {
+	src, err := os.ReadFile("../bricks-color.jpeg")
+	if err != nil {
+		return err
+	}
+
+	srcHuffmans := [2][2]huffman{}
+	components := []component(nil)
+	maxH, maxV, width, height := 1, 1, 0, 0
+	dst := []byte(nil)
+	pos := 2
+	if (len(src) < 2) || (src[0] != 0xFF) || (src[1] != 0xD8) {
+		return errBadInput
+	}
+	dst = append(dst, 0xFF, 0xD8)
+
+	for {
+		if (pos+4 > len(src)) || (src[pos] != 0xFF) {
+			return errBadInput
+		}
+		marker := src[pos+1]
+		length := (int(src[pos+2]) << 8) | int(src[pos+3])
+		if pos+2+length > len(src) {
+			return errBadInput
+		}
+		payload := src[pos+4 : pos+2+length]
+
+		switch marker {
+		case 0xC0: // SOF0.
+			height = (int(payload[1]) << 8) | int(payload[2])
+			width = (int(payload[3]) << 8) | int(payload[4])
+			for i := 0; i < int(payload[5]); i++ {
+				c := component{
+					h: int(payload[7+3*i] >> 4),
+					v: int(payload[7+3*i] & 15),
+				}
+				maxH = max(maxH, c.h)
+				maxV = max(maxV, c.v)
+				components = append(components, c)
+			}
+			dst = append(dst, src[pos:pos+2+length]...)
+
+			// Write the typical Huffman tables and the DRI marker.
+			for tc := 0; tc < 2; tc++ {
+				for th := 0; th < 2; th++ {
+					h := &typicalHuffmans[tc][th]
+					n := 2 + 1 + 16 + len(h.vals)
+					dst = append(dst, 0xFF, 0xC4, byte(n>>8), byte(n), byte(tc<<4|th))
+					dst = append(dst, h.bits[:]...)
+					dst = append(dst, h.vals...)
+					h.build()
+				}
+			}
+			dst = append(dst, 0xFF, 0xDD, 0x00, 0x04, 0x00, restartInterval)
+
+		case 0xC4: // DHT.
+			for p := payload; len(p) > 0; {
+				if len(p) < 17 {
+					return errBadInput
+				}
+				tc, th := p[0]>>4, p[0]&15
+				if (tc > 1) || (th > 1) {
+					return errUnsupportedInput
+				}
+				h := &srcHuffmans[tc][th]
+				copy(h.bits[:], p[1:17])
+				n := 0
+				for _, b := range h.bits {
+					n += int(b)
+				}
+				if len(p) < 17+n {
+					return errBadInput
+				}
+				h.vals = p[17 : 17+n]
+				h.build()
+				p = p[17+n:]
+			}
+
+		case 0xDA: // SOS.
+			if int(payload[0]) != len(components) {
+				return errUnsupportedInput
+			}
+			for i := range components {
+				components[i].td = int(payload[2+2*i] >> 4)
+				components[i].ta = int(payload[2+2*i] & 15)
+			}
+			dst = append(dst, src[pos:pos+2+length]...)
+			return transcode(dst, src[pos+2+length:], srcHuffmans, components, maxH, maxV, width, height)
+
+		case 0xC1, 0xC2, 0xC3, 0xC5, 0xC6, 0xC7, 0xC9, 0xCA, 0xCB, 0xCD, 0xCE, 0xCF, 0xDD:
+			return errUnsupportedInput
+
+		default:
+			dst = append(dst, src[pos:pos+2+length]...)
+		}
+		pos += 2 + length
+	}
+}
+
+func transcode(dst []byte, src []byte, srcHuffmans [2][2]huffman, components []component, maxH int, maxV int, width int, height int) error {
+	r := bitReader{src: src}
+	w := bitWriter{dst: dst}
+	widthInMCUs := (width + (8 * maxH) - 1) / (8 * maxH)
+	heightInMCUs := (height + (8 * maxV) - 1) / (8 * maxV)
+	numMCUs := widthInMCUs * heightInMCUs
+
+	srcDC := make([]int32, len(components))
+	for m := 0; m < numMCUs; m++ {
+		if (m > 0) && ((m % restartInterval) == 0) {
+			w.flush()
+			w.dst = append(w.dst, 0xFF, byte(0xD0+(((m/restartInterval)-1)&7)))
+			for i := range components {
+				components[i].prevDC = 0
+			}
+		}
+
+		for i := range components {
+			c := &components[i]
+			for b := 0; b < c.h*c.v; b++ {
+				// Decode one block's coefficients (in zig-zag order).
+				coeffs := [64]int32{}
+				s, err := r.decodeHuffman(&srcHuffmans[0][c.td])
+				if err != nil {
+					return err
+				}
+				diff, err := r.receiveExtend(uint32(s))
+				if err != nil {
+					return err
+				}
+				srcDC[i] += diff
+				coeffs[0] = srcDC[i]
+				for k := 1; k < 64; {
+					rs, err := r.decodeHuffman(&srcHuffmans[1][c.ta])
+					if err != nil {
+						return err
+					}
+					if rs == 0x00 {
+						break
+					} else if rs == 0xF0 {
+						k += 16
+						continue
+					}
+					k += int(rs >> 4)
+					if k >= 64 {
+						return errBadInput
+					}
+					coeffs[k], err = r.receiveExtend(uint32(rs & 15))
+					if err != nil {
+						return err
+					}
+					k++
+				}
+
+				// Encode that block's coefficients.
+				w.writeValue(&typicalHuffmans[0][c.td], 0x00, coeffs[0]-c.prevDC)
+				c.prevDC = coeffs[0]
+				run := 0
+				for k := 1; k < 64; k++ {
+					if coeffs[k] == 0 {
+						run++
+						continue
+					}
+					for ; run >= 16; run -= 16 {
+						w.writeHuffman(&typicalHuffmans[1][c.ta], 0xF0)
+					}
+					w.writeValue(&typicalHuffmans[1][c.ta], uint8(run<<4), coeffs[k])
+					run = 0
+				}
+				if run > 0 {
+					w.writeHuffman(&typicalHuffmans[1][c.ta], 0x00)
+				}
+			}
+		}
+	}
+
+	w.flush()
+	w.dst = append(w.dst, 0xFF, 0xD9)
+	return os.WriteFile("bricks-color-restart-interval.jpeg", w.dst, 0666)
+}